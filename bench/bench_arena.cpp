@@ -0,0 +1,103 @@
+#include "calculation.h"
+#include "lexical_analysis.h"
+#include "parser.h"
+#include "polynom_arena.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+
+static size_t heap_allocations = 0;
+
+void* operator new(size_t size) {
+    heap_allocations++;
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    heap_allocations++;
+    size_t align = static_cast<size_t>(alignment);
+    if (void* ptr = std::aligned_alloc(align, (size + align - 1) / align * align)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+int main() {
+    const int rounds = 20000;
+    std::map<std::string, Polynom> storage;
+    storage["p"] = Polynom(std::string_view("x^2+2xy+y^2+z-1"));
+    storage["q"] = Polynom(std::string_view("3x-4y+5z^2"));
+
+    const std::vector<std::string> lines = {
+        "3x^2y - 4z^3 + 7",
+        "(x+1)*(x-1) - (y+2)*(y-2)",
+        "p*q + p - q",
+        "(p+q)*(p-q) - p*p + q*q",
+        "-(2x - 3y) * (x + y + z) * (x - y) + 5",
+    };
+
+    Lexical_analysis lex;
+    Parser parser;
+    std::vector<std::vector<Token>> rpns;
+    for (const std::string& line : lines) {
+        rpns.push_back(parser.transform(lex.lexus(line)));
+    }
+
+    Сalculation calc;
+    std::cout << "Heap allocations per evaluated line (" << rounds << " rounds)" << std::endl;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        size_t before = heap_allocations;
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; ++r) {
+            Polynom result = calc.evaluate(rpns[i], storage);
+        }
+        std::chrono::duration<double> plain_time = std::chrono::steady_clock::now() - start;
+        double plain = static_cast<double>(heap_allocations - before) / rounds;
+
+        before = heap_allocations;
+        size_t requests = 0;
+        start = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; ++r) {
+            PolynomArena arena;
+            std::optional<Polynom> scratch;
+            {
+                PolynomArena::Scope scope(arena);
+                scratch.emplace(calc.evaluate(rpns[i], storage));
+            }
+            Polynom result(*scratch);
+            requests += arena.stats().requests;
+        }
+        std::chrono::duration<double> arena_time = std::chrono::steady_clock::now() - start;
+        double with_arena = static_cast<double>(heap_allocations - before) / rounds;
+
+        std::cout << "  " << lines[i] << std::endl;
+        std::cout << "    heap: " << plain << " allocs, " << plain_time.count() / rounds * 1e6 << " us"
+            << " | arena: " << with_arena << " heap allocs (" << static_cast<double>(requests) / rounds
+            << " served by arena), " << arena_time.count() / rounds * 1e6 << " us" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,49 @@
+#include "polynoms.h"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+int main() {
+    std::mt19937 rng(43);
+    Polynom p;
+    for (int i = 0; i < 120; ++i) {
+        p.addMonom(Monom(static_cast<float>(rng() % 19) - 9.0f, { static_cast<int>(rng() % 7),
+            static_cast<int>(rng() % 7), static_cast<int>(rng() % 7) }));
+    }
+    const Polynom q[3] = { Polynom(std::string_view("x+y-1")), Polynom(std::string_view("2xz-y+3")),
+        Polynom(std::string_view("z^2+x")) };
+
+    std::cout << "Substitute into a " << p.size() << "-term polynom of degree " << p.degree() << std::endl;
+
+    // Term by term expansion, as substituting into the text form evaluates it
+    auto start = std::chrono::steady_clock::now();
+    Polynom reference;
+    Polynom rest = p;
+    while (rest.size() != 0) {
+        Monom lead = rest.leading_term();
+        Polynom term;
+        term.addMonom(Monom(lead.ratio, { 0, 0, 0 }));
+        for (size_t var = 0; var < 3; ++var) {
+            for (int k = 0; k < lead.powers[var]; ++k) {
+                term = term * q[var];
+            }
+        }
+        reference = reference + term;
+        Polynom lead_polynom;
+        lead_polynom.addMonom(lead);
+        rest = rest - lead_polynom;
+    }
+    double expand_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    Polynom composed = p.compose(q[0], q[1], q[2]);
+    double compose_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double difference = std::abs(reference.evaluate(0.3, -0.2, 0.1) - composed.evaluate(0.3, -0.2, 0.1));
+    std::cout << "  term by term expansion: " << expand_time * 1e3 << " ms" << std::endl;
+    std::cout << "  compose:                " << compose_time * 1e3 << " ms (" << composed.size() << " terms)" << std::endl;
+    std::cout << "  difference at a point:  " << difference << std::endl;
+    return 0;
+}
@@ -0,0 +1,38 @@
+#include "polynom_parser.h"
+
+#include <chrono>
+#include <iostream>
+
+static Polynom cube(int n) {
+    PolynomBuilder builder;
+    for (int x = 0; x < n; ++x)
+        for (int y = 0; y < n; ++y)
+            for (int z = 0; z < n; ++z)
+                builder.add(static_cast<float>((x + 2 * y + 3 * z) % 7 + 1), x, y, z);
+    return builder.build();
+}
+
+int main() {
+    const int sizes[] = { 8, 12, 16, 20 };
+    std::cout << "Dense cube products (n^3 terms each side)" << std::endl;
+    for (int n : sizes) {
+        Polynom a = cube(n);
+        Polynom b = cube(n / 2);
+
+        auto start = std::chrono::steady_clock::now();
+        Polynom prod = a * b;
+        std::chrono::duration<double> mul_time = std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        Polynom sum = prod + prod;
+        std::chrono::duration<double> add_time = std::chrono::steady_clock::now() - start;
+
+        // One sparse term is a list node holding a Monom: next pointer, float, vector header and 3 ints on the heap
+        size_t sparse_bytes = prod.size() * (sizeof(void*) + sizeof(Monom) + 3 * sizeof(int) + 16);
+        size_t dense_bytes = prod.size() * sizeof(float);
+        std::cout << "  n=" << n << ": product " << prod.size() << " terms (dense=" << prod.is_dense() << "), "
+            << "mul " << mul_time.count() << " s, add " << add_time.count() << " s, "
+            << "~" << sparse_bytes / 1024 << " KB sparse vs ~" << dense_bytes / 1024 << " KB dense" << std::endl;
+    }
+    return 0;
+}
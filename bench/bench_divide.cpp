@@ -0,0 +1,40 @@
+#include "polynoms.h"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+int main() {
+    std::mt19937 rng(44);
+    const int degree = 2000;
+    // Coefficients rising with the power keep the divisor roots inside the unit disk, so the long
+    // quotient stays well conditioned in float
+    Polynom divisor;
+    for (int i = 0; i <= degree / 2; ++i) {
+        divisor.addMonom(Monom(static_cast<float>(i + 1), { i, 0, 0 }));
+    }
+    Polynom dividend;
+    for (int i = 0; i <= degree; ++i) {
+        dividend.addMonom(Monom(static_cast<float>(rng() % 19) - 9.0f, { i, 0, 0 }));
+    }
+
+    std::cout << "Divide a degree " << dividend.degree() << " polynom by a degree " << divisor.degree()
+        << " polynom" << std::endl;
+
+    // Term by term reduction, as the multivariate division runs it
+    auto start = std::chrono::steady_clock::now();
+    Polynom remainder;
+    Polynom reference = dividend.divide(std::vector<Polynom>{ divisor }, remainder).front();
+    double long_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    Polynom::Division division = dividend.divide(divisor);
+    double newton_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double difference = std::abs(reference.evaluate(0.9, 0.0, 0.0) - division.quotient.evaluate(0.9, 0.0, 0.0));
+    std::cout << "  term by term reduction: " << long_time * 1e3 << " ms" << std::endl;
+    std::cout << "  Newton reciprocal:      " << newton_time * 1e3 << " ms" << std::endl;
+    std::cout << "  quotient difference at x = 0.9: " << difference << std::endl;
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include "polynom_parser.h"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+
+static Polynom randomPolynom(std::mt19937& rng, size_t terms, int max_power) {
+    PolynomBuilder builder;
+    for (size_t i = 0; i < terms; ++i) {
+        builder.add(static_cast<float>(rng() % 19) - 9.0f, rng() % max_power, rng() % max_power, rng() % max_power);
+    }
+    return builder.build();
+}
+
+int main() {
+    const int rounds = 200;
+    std::mt19937 rng(49);
+    const size_t sizes[] = { 8, 64, 512 };
+
+    std::cout << "Binary operators with named temporaries versus one expression" << std::endl;
+    for (size_t terms : sizes) {
+        Polynom a = randomPolynom(rng, terms * 8, 1000);
+        Polynom b = randomPolynom(rng, terms * 8, 1000);
+        Polynom c = randomPolynom(rng, terms * 8, 1000);
+        Polynom f = randomPolynom(rng, terms, 1000);
+        Polynom g = randomPolynom(rng, terms, 1000);
+        Polynom d = randomPolynom(rng, terms * 8, 1000);
+        Polynom e = randomPolynom(rng, terms * 8, 1000);
+
+        auto start = std::chrono::steady_clock::now();
+        size_t size = 0;
+        for (int r = 0; r < rounds; ++r) {
+            Polynom fg = f * g;
+            Polynom sum = a + fg;
+            Polynom result = sum - d;
+            size += result.size();
+        }
+        std::chrono::duration<double> separate_fma = std::chrono::steady_clock::now() - start;
+        start = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; ++r) {
+            Polynom result = a + f * g - d;
+            size -= result.size();
+        }
+        std::chrono::duration<double> fused_fma = std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; ++r) {
+            Polynom ab = a + b;
+            Polynom abc = ab - c;
+            Polynom abcd = abc + d;
+            Polynom result = abcd - e;
+            size += result.size();
+        }
+        std::chrono::duration<double> separate_sum = std::chrono::steady_clock::now() - start;
+        start = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; ++r) {
+            Polynom result = a + b - c + d - e;
+            size -= result.size();
+        }
+        std::chrono::duration<double> fused_sum = std::chrono::steady_clock::now() - start;
+
+        std::cout << "  " << a.size() << "-term operands" << (size == 0 ? "" : " (MISMATCH)") << ":" << std::endl;
+        std::cout << "    a + f * g - d:     separate " << separate_fma.count() / rounds * 1e3 << " ms, expression "
+            << fused_fma.count() / rounds * 1e3 << " ms" << std::endl;
+        std::cout << "    a + b - c + d - e: separate " << separate_sum.count() / rounds * 1e3 << " ms, expression "
+            << fused_sum.count() / rounds * 1e3 << " ms" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,47 @@
+#include "polynom_parser.h"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+
+static Polynom randomPolynom(std::mt19937& rng, size_t terms, int max_power) {
+    PolynomBuilder builder;
+    for (size_t i = 0; i < terms; ++i) {
+        builder.add(static_cast<float>(rng() % 19) - 9.0f, rng() % max_power, rng() % max_power, rng() % max_power);
+    }
+    return builder.build();
+}
+
+int main() {
+    const int rounds = 20;
+    std::mt19937 rng(36);
+    struct Case {
+        size_t terms;
+        int max_power;
+    };
+    const Case cases[] = { { 50, 1000 }, { 400, 1000 }, { 2000, 60 }, { 200, 20 } };
+
+    std::cout << "a*b + c versus Polynom::fma(a, b, c)" << std::endl;
+    for (const Case& test : cases) {
+        Polynom a = randomPolynom(rng, test.terms, test.max_power);
+        Polynom b = randomPolynom(rng, test.terms, test.max_power);
+        Polynom c = randomPolynom(rng, test.terms * 4, 2 * test.max_power);
+
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; ++r) {
+            Polynom result = a * b + c;
+        }
+        std::chrono::duration<double> separate = std::chrono::steady_clock::now() - start;
+        start = std::chrono::steady_clock::now();
+        size_t size = 0;
+        for (int r = 0; r < rounds; ++r) {
+            size = Polynom::fma(a, b, c).size();
+        }
+        std::chrono::duration<double> fused = std::chrono::steady_clock::now() - start;
+
+        std::cout << "  " << a.size() << " x " << b.size() << " + " << c.size() << " -> " << size << " terms"
+            << (a.is_dense() ? " (dense)" : "") << ": separate " << separate.count() / rounds * 1e3
+            << " ms, fused " << fused.count() / rounds * 1e3 << " ms" << std::endl;
+    }
+    return 0;
+}
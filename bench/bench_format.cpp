@@ -0,0 +1,38 @@
+#include "polynom_parser.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+int main() {
+    const int terms = 1000000;
+    std::mt19937 rng(7);
+    PolynomBuilder builder;
+    builder.reserve(terms);
+    for (int i = 0; i < terms; ++i) {
+        float ratio = static_cast<float>(rng() % 20000) / 8.0f - 1250.0f;
+        builder.add(ratio, i % 100, (i / 100) % 100, i / 10000);
+    }
+    Polynom p = builder.build();
+
+    std::string buffer;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < 5; ++r) {
+        buffer.clear();
+        p.format_to(buffer);
+    }
+    std::chrono::duration<double> format_time = (std::chrono::steady_clock::now() - start) / 5;
+
+    start = std::chrono::steady_clock::now();
+    std::ostringstream oss;
+    oss << p;
+    std::chrono::duration<double> stream_time = std::chrono::steady_clock::now() - start;
+
+    std::cout << "Formatting " << terms << " terms (" << buffer.size() / (1024 * 1024) << " MB)" << std::endl;
+    std::cout << "  Polynom::format_to, reused buffer: " << format_time.count() << " s" << std::endl;
+    std::cout << "  operator<< into ostringstream:     " << stream_time.count() << " s" << std::endl;
+    return 0;
+}
@@ -0,0 +1,37 @@
+#include "polynoms.h"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+
+static Polynom random_polynom(std::mt19937& rng, int terms, int max_power) {
+    Polynom p;
+    for (int i = 0; i < terms; ++i) {
+        p.addMonom(Monom(static_cast<float>(rng() % 7) - 3.0f, { static_cast<int>(rng() % (max_power + 1)),
+            static_cast<int>(rng() % (max_power + 1)), static_cast<int>(rng() % (max_power + 1)) }));
+    }
+    return p;
+}
+
+int main() {
+    std::mt19937 rng(45);
+    std::cout << "gcd(g * a, g * b) for random g, a, b with powers up to d in each var" << std::endl;
+    for (int d = 1; d <= 10; ++d) {
+        const int terms = 2 * d + 2;
+        Polynom g = random_polynom(rng, terms, d);
+        Polynom a = g * random_polynom(rng, terms, d);
+        Polynom b = g * random_polynom(rng, terms, d);
+
+        const int repeats = 3;
+        auto start = std::chrono::steady_clock::now();
+        Polynom result;
+        for (int r = 0; r < repeats; ++r) {
+            result = a.gcd(b);
+        }
+        double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / repeats;
+        bool found = (result % g).size() == 0 && (a % result).size() == 0 && (b % result).size() == 0;
+        std::cout << "  d = " << d << ": " << a.size() << " and " << b.size() << " terms, " << time * 1e3
+            << " ms, gcd of " << result.size() << " terms" << (found ? "" : " (wrong)") << std::endl;
+    }
+    return 0;
+}
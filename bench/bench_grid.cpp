@@ -0,0 +1,46 @@
+#include "polynoms.h"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+int main() {
+    std::mt19937 rng(40);
+    Polynom p;
+    for (int i = 0; i < 60; ++i) {
+        p.addMonom(Monom(static_cast<float>(rng() % 19) - 9.0f, { static_cast<int>(rng() % 6),
+            static_cast<int>(rng() % 6), static_cast<int>(rng() % 6) }));
+    }
+
+    std::cout << "Evaluate a " << p.size() << "-term polynom on a regular grid" << std::endl;
+    for (size_t n : { 64, 128, 256 }) {
+        std::vector<double> axis(n);
+        for (size_t i = 0; i < n; ++i) {
+            axis[i] = -1.0 + 2.0 * static_cast<double>(i) / static_cast<double>(n - 1);
+        }
+
+        double point_time = 0.0;
+        if (n <= 128) {
+            std::vector<double> values(n * n * n);
+            auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < n; ++i)
+                for (size_t j = 0; j < n; ++j)
+                    for (size_t k = 0; k < n; ++k)
+                        values[(i * n + j) * n + k] = p.evaluate(axis[i], axis[j], axis[k]);
+            point_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        std::vector<double> grid;
+        auto start = std::chrono::steady_clock::now();
+        p.evaluate_grid(axis, axis, axis, grid);
+        double grid_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "  " << n << "^3: ";
+        if (point_time > 0.0) {
+            std::cout << "point by point " << point_time * 1e3 << " ms, ";
+        }
+        std::cout << "evaluate_grid " << grid_time * 1e3 << " ms" << std::endl;
+    }
+    return 0;
+}
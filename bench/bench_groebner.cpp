@@ -0,0 +1,52 @@
+#include "polynom_groebner.h"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+static Polynom random_polynom(std::mt19937& rng, int degree) {
+    Polynom p;
+    for (int px = 0; px <= degree; ++px) {
+        for (int py = 0; px + py <= degree; ++py) {
+            for (int pz = 0; px + py + pz <= degree; ++pz) {
+                if (rng() % 2) {
+                    p.addMonom(Monom(static_cast<float>(rng() % 19) - 9.0f, { px, py, pz }));
+                }
+            }
+        }
+    }
+    p.addMonom(Monom(1.0f, { 0, 0, degree }));
+    return p;
+}
+
+static void run(const char* name, const std::vector<Polynom>& generators) {
+    auto start = std::chrono::steady_clock::now();
+    GroebnerBasis basis(generators);
+    double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    bool members = true;
+    for (const Polynom& g : generators) {
+        members = members && basis.contains(g);
+    }
+    std::cout << "  " << name << ": " << time * 1e3 << " ms, " << basis.size() << " basis polynoms"
+        << (members ? "" : " (generators not reduced to zero)") << std::endl;
+}
+
+int main() {
+    std::cout << "F4 Groebner bases over Z_" << GroebnerBasis::PRIME << " in graded reverse lex order" << std::endl;
+    run("cyclic-3", { Polynom(std::string_view("x+y+z")), Polynom(std::string_view("xy+yz+zx")),
+        Polynom(std::string_view("xyz-1")) });
+    run("katsura-3", { Polynom(std::string_view("x+2y+2z-1")), Polynom(std::string_view("x^2+2y^2+2z^2-x")),
+        Polynom(std::string_view("2xy+2yz-y")) });
+
+    std::mt19937 rng(46);
+    for (int degree = 2; degree <= 6; ++degree) {
+        std::vector<Polynom> generators = { random_polynom(rng, degree), random_polynom(rng, degree),
+            random_polynom(rng, degree) };
+        std::string name = "3 random dense polynoms of degree " + std::to_string(degree);
+        run(name.c_str(), generators);
+    }
+    return 0;
+}
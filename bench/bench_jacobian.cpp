@@ -0,0 +1,57 @@
+#include "polynom_jacobian.h"
+#include "polynoms.h"
+
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+int main() {
+    std::mt19937 rng(42);
+    std::vector<Polynom> polynoms(3);
+    for (Polynom& p : polynoms) {
+        for (int i = 0; i < 40; ++i) {
+            p.addMonom(Monom(static_cast<float>(rng() % 19) - 9.0f, { static_cast<int>(rng() % 7),
+                static_cast<int>(rng() % 7), static_cast<int>(rng() % 7) }));
+        }
+    }
+    std::vector<std::array<Polynom, 3>> gradients;
+    for (const Polynom& p : polynoms) {
+        gradients.push_back(p.gradient());
+    }
+
+    const size_t steps = 200000;
+    std::uniform_real_distribution<double> coord(-1.0, 1.0);
+    double x = coord(rng), y = coord(rng), z = coord(rng);
+    std::cout << "Value and gradient of " << polynoms.size() << " polynoms at " << steps << " single points" << std::endl;
+
+    double checksum = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t s = 0; s < steps; ++s) {
+        for (size_t p = 0; p < polynoms.size(); ++p) {
+            checksum += polynoms[p].evaluate(x, y, z);
+            for (const Polynom& d : gradients[p]) {
+                checksum += d.evaluate(x, y, z);
+            }
+        }
+        x = x * 0.999 + 1e-4;
+    }
+    double separate_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    JacobianEvaluator evaluator(polynoms);
+    double values[3], jacobian[9];
+    x = 0.5;
+    start = std::chrono::steady_clock::now();
+    for (size_t s = 0; s < steps; ++s) {
+        evaluator.evaluate(x, y, z, values, jacobian);
+        checksum += values[0] + jacobian[0];
+        x = x * 0.999 + 1e-4;
+    }
+    double fused_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "  value + gradient polynoms: " << separate_time * 1e3 << " ms" << std::endl;
+    std::cout << "  JacobianEvaluator:         " << fused_time * 1e3 << " ms" << std::endl;
+    std::cout << "  (checksum " << checksum << ")" << std::endl;
+    return 0;
+}
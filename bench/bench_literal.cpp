@@ -0,0 +1,34 @@
+#include "polynom_literal.h"
+
+#include <chrono>
+#include <iostream>
+#include <string_view>
+
+using namespace polynom_literals;
+
+int main() {
+    const int repeats = 200000;
+    constexpr std::string_view text = "3.5x^4y - 4z^3 + 0.125xyz - 2.75x^2 + y^2z^2 - 17.25y + x^3 - 0.5z + 7";
+    constexpr PolynomLiteral literal = "3.5x^4y - 4z^3 + 0.125xyz - 2.75x^2 + y^2z^2 - 17.25y + x^3 - 0.5z + 7"_poly;
+
+    std::cout << "Construct a " << literal.size() << "-term polynom " << repeats << " times" << std::endl;
+
+    auto start = std::chrono::steady_clock::now();
+    uint64_t parsed_hash = 0;
+    for (int i = 0; i < repeats; ++i) {
+        parsed_hash += Polynom(text).hash();
+    }
+    double parse_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    uint64_t literal_hash = 0;
+    for (int i = 0; i < repeats; ++i) {
+        literal_hash += Polynom(literal).hash();
+    }
+    double literal_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "  runtime parse: " << parse_time * 1e3 << " ms" << std::endl;
+    std::cout << "  _poly literal: " << literal_time * 1e3 << " ms ("
+        << (parsed_hash == literal_hash ? "same" : "DIFFERENT") << " polynoms)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,149 @@
+#include "polynom_multiply.h"
+#include "polynom_parser.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <vector>
+
+static Polynom randomPolynom(std::mt19937& rng, size_t terms, int max_power) {
+    PolynomBuilder builder;
+    for (size_t i = 0; i < terms; ++i) {
+        builder.add(static_cast<float>(rng() % 19) - 9.0f, rng() % max_power, rng() % max_power, rng() % max_power);
+    }
+    return builder.build();
+}
+
+// Seconds per call, repeated until at least 50 ms have passed
+static double timeIt(const std::function<void()>& func) {
+    size_t rounds = 0;
+    auto start = std::chrono::steady_clock::now();
+    std::chrono::duration<double> elapsed(0.0);
+    do {
+        func();
+        ++rounds;
+        elapsed = std::chrono::steady_clock::now() - start;
+    } while (elapsed.count() < 0.05);
+    return elapsed.count() / static_cast<double>(rounds);
+}
+
+static double timeKernel(const Polynom& a, const Polynom& b, MultiplyKernel kernel) {
+    return timeIt([&]() { MultiplyPlanner::multiply(a, b, kernel); }) * 1e9;
+}
+
+// Units of work the planner charges to one cost field for a kernel
+static double units(const Polynom& a, const Polynom& b, MultiplyKernel kernel, double MultiplyCosts::* field) {
+    MultiplyCosts unit;
+    unit.naive_pair = unit.hash_pair = unit.heap_pair = unit.output_term = 0.0;
+    unit.dense_pair = unit.dense_cell = unit.karatsuba_op = unit.fft_op = 0.0;
+    unit.*field = 1.0;
+    MultiplyPlanner::set_costs(unit);
+    MultiplyPlanner::set_override(kernel);
+    double result = MultiplyPlanner::plan(a, b).estimated_cost;
+    MultiplyPlanner::set_override(MultiplyKernel::AUTO);
+    return result;
+}
+
+static double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    return std::max(values[values.size() / 2], 0.01);
+}
+
+int main() {
+    std::mt19937 rng(38);
+    MultiplyCosts fitted;
+
+    // Cells: two corners of a large box times a constant
+    {
+        Polynom corners(std::string_view("x^40y^40z^40+1"));
+        Polynom one(std::string_view("1"));
+        double cells = units(corners, one, MultiplyKernel::DENSE, &MultiplyCosts::dense_cell);
+        fitted.dense_cell = timeKernel(corners, one, MultiplyKernel::DENSE) / cells;
+    }
+    // Sorting distinct terms into polynom order
+    {
+        std::vector<double> samples;
+        for (size_t terms : { 2000, 20000, 200000 }) {
+            std::vector<PolyTerm> raw;
+            for (size_t i = 0; i < terms; ++i) {
+                int powers[3] = { static_cast<int>(i % 97), static_cast<int>(i / 97 % 89), static_cast<int>(i / 97 / 89) };
+                raw.push_back(make_term(1.0f, powers));
+            }
+            std::shuffle(raw.begin(), raw.end(), rng);
+            double seconds = timeIt([&]() {
+                PolynomBuilder builder;
+                builder.reserve(raw.size());
+                for (const PolyTerm& term : raw) {
+                    builder.add(term.ratio, term.powers[0], term.powers[1], term.powers[2]);
+                }
+                builder.build();
+            });
+            samples.push_back(seconds * 1e9 / static_cast<double>(terms));
+        }
+        fitted.output_term = median(samples);
+    }
+
+    struct Shape {
+        size_t terms_a;
+        size_t terms_b;
+        int max_power;
+    };
+    const Shape sparse_shapes[] = { { 300, 300, 1000 }, { 2000, 200, 1000 }, { 1000, 1000, 100 } };
+    const Shape dense_shapes[] = { { 400, 400, 10 }, { 3000, 3000, 20 }, { 8000, 300, 24 } };
+
+    std::vector<double> naive, hash, heap, dense, karatsuba, fft;
+    for (const Shape& shape : sparse_shapes) {
+        Polynom a = randomPolynom(rng, shape.terms_a, shape.max_power);
+        Polynom b = randomPolynom(rng, shape.terms_b, shape.max_power);
+        naive.push_back(timeKernel(a, b, MultiplyKernel::NAIVE) / units(a, b, MultiplyKernel::NAIVE, &MultiplyCosts::naive_pair));
+        double output = fitted.output_term * units(a, b, MultiplyKernel::HASH, &MultiplyCosts::output_term);
+        hash.push_back((timeKernel(a, b, MultiplyKernel::HASH) - output) / units(a, b, MultiplyKernel::HASH, &MultiplyCosts::hash_pair));
+        heap.push_back((timeKernel(a, b, MultiplyKernel::HEAP) - output) / units(a, b, MultiplyKernel::HEAP, &MultiplyCosts::heap_pair));
+    }
+    for (const Shape& shape : dense_shapes) {
+        Polynom a = randomPolynom(rng, shape.terms_a, shape.max_power);
+        Polynom b = randomPolynom(rng, shape.terms_b, shape.max_power);
+        double cells = fitted.dense_cell * units(a, b, MultiplyKernel::DENSE, &MultiplyCosts::dense_cell);
+        dense.push_back((timeKernel(a, b, MultiplyKernel::DENSE) - cells) / units(a, b, MultiplyKernel::DENSE, &MultiplyCosts::dense_pair));
+        karatsuba.push_back((timeKernel(a, b, MultiplyKernel::KARATSUBA) - cells) / units(a, b, MultiplyKernel::KARATSUBA, &MultiplyCosts::karatsuba_op));
+        fft.push_back((timeKernel(a, b, MultiplyKernel::FFT) - cells) / units(a, b, MultiplyKernel::FFT, &MultiplyCosts::fft_op));
+    }
+    fitted.naive_pair = median(naive);
+    fitted.hash_pair = median(hash);
+    fitted.heap_pair = median(heap);
+    fitted.dense_pair = median(dense);
+    fitted.karatsuba_op = median(karatsuba);
+    fitted.fft_op = median(fft);
+
+    std::cout << "Calibrated costs (ns) for MultiplyPlanner::set_costs:" << std::endl;
+    std::cout << "  naive_pair " << fitted.naive_pair << ", hash_pair " << fitted.hash_pair
+        << ", heap_pair " << fitted.heap_pair << ", output_term " << fitted.output_term << std::endl;
+    std::cout << "  dense_pair " << fitted.dense_pair << ", dense_cell " << fitted.dense_cell
+        << ", karatsuba_op " << fitted.karatsuba_op << ", fft_op " << fitted.fft_op << std::endl;
+
+    MultiplyPlanner::set_costs(fitted);
+    const Shape checks[] = { { 50, 50, 1000 }, { 500, 500, 1000 }, { 500, 500, 30 }, { 5000, 5000, 40 },
+        { 20000, 10, 2000 }, { 200, 200, 8 }, { 1500, 1500, 16 } };
+    const MultiplyKernel kernels[] = { MultiplyKernel::NAIVE, MultiplyKernel::HEAP, MultiplyKernel::HASH,
+        MultiplyKernel::DENSE, MultiplyKernel::KARATSUBA, MultiplyKernel::FFT };
+    std::cout << "Planner choice against every kernel (ms):" << std::endl;
+    for (const Shape& shape : checks) {
+        Polynom a = randomPolynom(rng, shape.terms_a, shape.max_power);
+        Polynom b = randomPolynom(rng, shape.terms_b, shape.max_power);
+        MultiplyPlan plan = MultiplyPlanner::plan(a, b);
+        std::cout << "  " << a.size() << " x " << b.size() << " terms, powers < " << shape.max_power
+            << " -> " << kernel_name(plan.kernel) << ":";
+        for (MultiplyKernel kernel : kernels) {
+            MultiplyPlanner::set_override(kernel);
+            bool applicable = MultiplyPlanner::plan(a, b).kernel == kernel;
+            MultiplyPlanner::set_override(MultiplyKernel::AUTO);
+            if (applicable) {
+                std::cout << " " << kernel_name(kernel) << " " << timeKernel(a, b, kernel) / 1e6;
+            }
+        }
+        std::cout << std::endl;
+    }
+    return 0;
+}
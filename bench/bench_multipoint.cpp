@@ -0,0 +1,44 @@
+#include "polynoms.h"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+int main() {
+    std::mt19937 rng(39);
+    const size_t point_count = 50000;
+    std::vector<double> xs(point_count);
+    for (double& x : xs) {
+        x = std::uniform_real_distribution<double>(-1.0, 1.0)(rng);
+    }
+
+    std::cout << "Evaluate a univariate polynom at " << point_count << " points" << std::endl;
+    for (int degree : { 16, 128, 1024 }) {
+        Polynom p;
+        for (int i = 0; i <= degree; ++i) {
+            p.addMonom(Monom(static_cast<float>(rng() % 19) - 9.0f, { i, 0, 0 }));
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        double checksum_point = 0.0;
+        for (double x : xs) {
+            checksum_point += p.evaluate(x, 0.0, 0.0);
+        }
+        std::chrono::duration<double> point_time = std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        std::vector<double> values = p.evaluate(xs);
+        std::chrono::duration<double> batch_time = std::chrono::steady_clock::now() - start;
+        double checksum_batch = 0.0;
+        for (double v : values) {
+            checksum_batch += v;
+        }
+
+        std::cout << "  degree " << degree << ": point by point " << point_time.count() * 1e3
+            << " ms, batched Horner " << batch_time.count() * 1e3 << " ms (checksums "
+            << checksum_point << " / " << checksum_batch << ")" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,53 @@
+#include "polynom_parser.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+int main() {
+    const size_t count = 10000000;
+    std::mt19937 rng(34);
+    std::vector<PolyTerm> raw;
+    raw.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        int powers[3] = { static_cast<int>(rng() % 200), static_cast<int>(rng() % 200), static_cast<int>(rng() % 200) };
+        raw.push_back(make_term(static_cast<float>(rng() % 100) + 1.0f, powers));
+    }
+
+    std::vector<size_t> thread_counts = { 1, 2, 4 };
+    if (std::thread::hardware_concurrency() > 4) {
+        thread_counts.push_back(std::thread::hardware_concurrency());
+    }
+    std::vector<double> radix_times;
+    size_t result_size = 0;
+    for (size_t threads : thread_counts) {
+        Polynom::set_parallel_threads(threads);
+        PolynomBuilder builder;
+        builder.reserve(count);
+        for (const PolyTerm& term : raw) {
+            builder.add(term.ratio, term.powers[0], term.powers[1], term.powers[2]);
+        }
+        auto start = std::chrono::steady_clock::now();
+        Polynom p = builder.build();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        radix_times.push_back(elapsed.count());
+        result_size = p.size();
+    }
+
+    std::vector<PolyTerm> reference = raw;
+    auto start = std::chrono::steady_clock::now();
+    std::stable_sort(reference.begin(), reference.end(), [](const PolyTerm& a, const PolyTerm& b) {
+        return compare_powers(a.powers, b.powers) > 0;
+    });
+    std::chrono::duration<double> comparison_time = std::chrono::steady_clock::now() - start;
+
+    std::cout << "Normalize " << count << " unsorted terms into " << result_size << " terms" << std::endl;
+    for (size_t i = 0; i < thread_counts.size(); ++i) {
+        std::cout << "  normalize (radix sort + merge), " << thread_counts[i] << " thread(s): " << radix_times[i] << " s" << std::endl;
+    }
+    std::cout << "  std::stable_sort alone:         " << comparison_time.count() << " s" << std::endl;
+    return 0;
+}
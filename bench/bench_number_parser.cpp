@@ -0,0 +1,101 @@
+#include "number_parser.h"
+#include "polynom_parser.h"
+
+#include <charconv>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+template <typename Func>
+double measure_mb_per_s(const std::string& data, int rounds, Func&& func) {
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        func();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(data.size()) * rounds / (1024.0 * 1024.0) / elapsed.count();
+}
+
+int main() {
+    const size_t count = 1000000;
+    const int rounds = 5;
+    std::mt19937 rng(2025);
+
+    std::string decimals;
+    std::vector<size_t> offsets;
+    for (size_t i = 0; i < count; ++i) {
+        offsets.push_back(decimals.size());
+        decimals += std::to_string(rng() % 100000) + "." + std::to_string(rng() % 1000) + " ";
+    }
+    std::string integers;
+    std::vector<size_t> int_offsets;
+    for (size_t i = 0; i < count; ++i) {
+        int_offsets.push_back(integers.size());
+        integers += std::to_string(rng() % 1000) + " ";
+    }
+
+    volatile float float_sink = 0.0f;
+    volatile int int_sink = 0;
+
+    double fast_float = measure_mb_per_s(decimals, rounds, [&]() {
+        const char* last = decimals.data() + decimals.size();
+        for (size_t off : offsets) {
+            float v;
+            NumberParser::parse_decimal(decimals.data() + off, last, v);
+            float_sink = v;
+        }
+    });
+    double from_chars_float = measure_mb_per_s(decimals, rounds, [&]() {
+        const char* last = decimals.data() + decimals.size();
+        for (size_t off : offsets) {
+            float v;
+            std::from_chars(decimals.data() + off, last, v, std::chars_format::fixed);
+            float_sink = v;
+        }
+    });
+    double stof_float = measure_mb_per_s(decimals, rounds, [&]() {
+        for (size_t i = 0; i < offsets.size(); ++i) {
+            size_t len = (i + 1 < offsets.size() ? offsets[i + 1] : decimals.size()) - offsets[i] - 1;
+            std::string num_part = decimals.substr(offsets[i], len);
+            float_sink = std::stof(num_part);
+        }
+    });
+
+    double fast_int = measure_mb_per_s(integers, rounds, [&]() {
+        const char* last = integers.data() + integers.size();
+        for (size_t off : int_offsets) {
+            int v;
+            NumberParser::parse_integer(integers.data() + off, last, v);
+            int_sink = v;
+        }
+    });
+    double stoi_int = measure_mb_per_s(integers, rounds, [&]() {
+        for (size_t i = 0; i < int_offsets.size(); ++i) {
+            size_t len = (i + 1 < int_offsets.size() ? int_offsets[i + 1] : integers.size()) - int_offsets[i] - 1;
+            std::string pow_str = integers.substr(int_offsets[i], len);
+            int_sink = std::stoi(pow_str);
+        }
+    });
+
+    std::string literal;
+    for (size_t i = 0; i < count / 4; ++i) {
+        literal += "+" + std::to_string(rng() % 1000) + "." + std::to_string(rng() % 100) +
+            "x^" + std::to_string(rng() % 50) + "y^" + std::to_string(rng() % 50) + "z^" + std::to_string(rng() % 50);
+    }
+    double literal_parse = measure_mb_per_s(literal, 1, [&]() {
+        PolynomBuilder builder;
+        builder.reserve(count / 4);
+        PolynomParser::parse(literal, builder);
+    });
+
+    std::cout << "Number parsing throughput (MB/s)" << std::endl;
+    std::cout << "  NumberParser::parse_decimal: " << fast_float << std::endl;
+    std::cout << "  std::from_chars(float):      " << from_chars_float << std::endl;
+    std::cout << "  std::stof:                   " << stof_float << std::endl;
+    std::cout << "  NumberParser::parse_integer: " << fast_int << std::endl;
+    std::cout << "  std::stoi:                   " << stoi_int << std::endl;
+    std::cout << "  PolynomParser (no build):    " << literal_parse << std::endl;
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include "polynom_parser.h"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+static Polynom randomPolynom(std::mt19937& rng, size_t terms, int max_power) {
+    PolynomBuilder builder;
+    for (size_t i = 0; i < terms; ++i) {
+        builder.add(static_cast<float>(rng() % 19) - 9.0f, rng() % max_power, rng() % max_power, rng() % max_power);
+    }
+    return builder.build();
+}
+
+int main() {
+    std::mt19937 rng(37);
+    struct Case {
+        size_t factors;
+        size_t terms;
+        int max_power;
+        size_t big_terms;    // the first factor gets this many terms when non-zero
+    };
+    const Case cases[] = { { 16, 3, 4, 0 }, { 8, 6, 50, 0 }, { 6, 12, 1000, 0 }, { 10, 2, 1000, 3000 } };
+    const int rounds = 5;
+
+    std::cout << "Left-to-right chain versus Polynom::product" << std::endl;
+    for (const Case& test : cases) {
+        std::vector<Polynom> factors;
+        for (size_t i = 0; i < test.factors; ++i) {
+            size_t terms = i == 0 && test.big_terms ? test.big_terms : test.terms;
+            factors.push_back(randomPolynom(rng, terms, test.max_power));
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; ++r) {
+            Polynom chained = factors[0];
+            for (size_t i = 1; i < factors.size(); ++i) {
+                chained = chained * factors[i];
+            }
+        }
+        std::chrono::duration<double> sequential = std::chrono::steady_clock::now() - start;
+        start = std::chrono::steady_clock::now();
+        size_t size = 0;
+        bool dense = false;
+        for (int r = 0; r < rounds; ++r) {
+            Polynom tree = Polynom::product(factors);
+            size = tree.size();
+            dense = tree.is_dense();
+        }
+        std::chrono::duration<double> balanced = std::chrono::steady_clock::now() - start;
+
+        std::cout << "  " << test.factors << " factors of " << factors.front().size() << ".." << factors.back().size()
+            << " terms -> " << size << " terms" << (dense ? " (dense)" : "") << ": left-to-right "
+            << sequential.count() / rounds * 1e3 << " ms, product tree " << balanced.count() / rounds * 1e3 << " ms" << std::endl;
+    }
+    return 0;
+}
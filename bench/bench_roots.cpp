@@ -0,0 +1,47 @@
+#include "polynoms.h"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+int main() {
+    std::mt19937 rng(47);
+    std::vector<Polynom> polynoms;
+    size_t expected = 0;
+    for (int i = 0; i < 4000; ++i) {
+        // product of a few distinct real linear factors and a quadratic without real roots
+        Polynom p(std::string_view("x^2+1"));
+        const int count = 4 + i % 8;
+        for (int k = 0; k < count; ++k) {
+            Polynom factor;
+            factor.addMonom(Monom(1.0f, { 1, 0, 0 }));
+            factor.addMonom(Monom(static_cast<float>(2 * k - count) + 0.25f * static_cast<float>(rng() % 4), { 0, 0, 0 }));
+            p = p * factor;
+        }
+        polynoms.push_back(std::move(p));
+        expected += count;
+    }
+
+    std::cout << "Real roots of " << polynoms.size() << " polynoms of degree 6 to 13 (" << Polynom::parallel_threads()
+        << " threads)" << std::endl;
+
+    auto start = std::chrono::steady_clock::now();
+    size_t found = 0;
+    for (const Polynom& p : polynoms) {
+        found += p.real_roots().size();
+    }
+    double single_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    std::vector<std::vector<double>> roots = Polynom::real_roots(polynoms);
+    double batch_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    size_t batch_found = 0;
+    for (const std::vector<double>& r : roots) {
+        batch_found += r.size();
+    }
+
+    std::cout << "  one at a time: " << single_time * 1e3 << " ms (" << found << " of " << expected << " roots)" << std::endl;
+    std::cout << "  batch:         " << batch_time * 1e3 << " ms (" << batch_found << " roots)" << std::endl;
+    return 0;
+}
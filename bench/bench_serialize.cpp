@@ -0,0 +1,41 @@
+#include "polynom_parser.h"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+int main() {
+    const int terms = 1000000;
+    std::mt19937 rng(11);
+    PolynomBuilder builder;
+    builder.reserve(terms);
+    for (int i = 0; i < terms; ++i) {
+        builder.add(static_cast<float>(rng() % 100000) / 7.0f + 1.0f, i % 100, (i / 100) % 100, i / 10000);
+    }
+    Polynom p = builder.build();
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<unsigned char> bytes = p.serialize();
+    std::chrono::duration<double> serialize_time = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    Polynom q = Polynom::deserialize(bytes.data(), bytes.size());
+    std::chrono::duration<double> deserialize_time = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    std::string text;
+    p.format_to(text);
+    Polynom r;
+    PolynomParser::parse(text, r);
+    std::chrono::duration<double> text_time = std::chrono::steady_clock::now() - start;
+
+    double mb = static_cast<double>(bytes.size()) / (1024.0 * 1024.0);
+    std::cout << "Binary format: " << terms << " terms, " << mb << " MB (text: "
+        << static_cast<double>(text.size()) / (1024.0 * 1024.0) << " MB)" << std::endl;
+    std::cout << "  serialize:   " << serialize_time.count() << " s, " << mb / serialize_time.count() << " MB/s" << std::endl;
+    std::cout << "  deserialize: " << deserialize_time.count() << " s, " << mb / deserialize_time.count() << " MB/s" << std::endl;
+    std::cout << "  text format + parse round trip: " << text_time.count() << " s" << std::endl;
+    return 0;
+}
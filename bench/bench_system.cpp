@@ -0,0 +1,58 @@
+#include "polynom_system.h"
+#include "polynoms.h"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+int main() {
+    // 200 related polynoms drawing their terms from one pool of monoms
+    std::mt19937 rng(41);
+    std::vector<std::vector<int>> pool;
+    for (int i = 0; i < 400; ++i) {
+        pool.push_back({ static_cast<int>(rng() % 8), static_cast<int>(rng() % 8), static_cast<int>(rng() % 8) });
+    }
+    std::vector<Polynom> polynoms(200);
+    for (Polynom& p : polynoms) {
+        for (int i = 0; i < 40; ++i) {
+            p.addMonom(Monom(static_cast<float>(rng() % 19) - 9.0f, pool[rng() % pool.size()]));
+        }
+    }
+
+    const size_t count = 20000;
+    std::vector<double> xs(count), ys(count), zs(count);
+    std::uniform_real_distribution<double> coord(-1.0, 1.0);
+    for (size_t i = 0; i < count; ++i) {
+        xs[i] = coord(rng);
+        ys[i] = coord(rng);
+        zs[i] = coord(rng);
+    }
+
+    std::vector<double> single(polynoms.size() * count);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t p = 0; p < polynoms.size(); ++p)
+        for (size_t i = 0; i < count; ++i)
+            single[p * count + i] = polynoms[p].evaluate(xs[i], ys[i], zs[i]);
+    double single_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    PolynomSystem system(polynoms);
+    double build_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<double> batch(polynoms.size() * count);
+    start = std::chrono::steady_clock::now();
+    system.evaluate_batch(xs.data(), ys.data(), zs.data(), count, batch.data());
+    double batch_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double max_error = 0.0;
+    for (size_t i = 0; i < batch.size(); ++i) {
+        max_error = std::max(max_error, std::abs(batch[i] - single[i]));
+    }
+    std::cout << "Evaluate " << polynoms.size() << " polynoms at " << count << " points (" << system.monom_count()
+        << " distinct monoms)" << std::endl;
+    std::cout << "  one by one:      " << single_time * 1e3 << " ms" << std::endl;
+    std::cout << "  PolynomSystem:   " << batch_time * 1e3 << " ms (+ " << build_time * 1e3 << " ms to build)" << std::endl;
+    std::cout << "  max difference:  " << max_error << std::endl;
+    return 0;
+}
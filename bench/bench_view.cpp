@@ -0,0 +1,56 @@
+#include "polynom_parser.h"
+#include "polynom_view.h"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+
+int main() {
+    std::mt19937 rng(50);
+    PolynomBuilder builder;
+    for (int i = 0; i < 200000; ++i) {
+        builder.add(static_cast<float>(rng() % 19) - 9.0f, rng() % 200, rng() % 200, rng() % 200);
+    }
+    const Polynom p = builder.build();
+
+    auto start = std::chrono::steady_clock::now();
+    DegreeIndex index(p);
+    double index_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Homogeneous components of a " << p.size() << "-term polynom, " << index.degrees().size()
+        << " degrees; index built in " << index_time * 1e3 << " ms" << std::endl;
+
+    // Every component by a full scan into a builder, as without the index
+    start = std::chrono::steady_clock::now();
+    size_t scanned = 0;
+    for (int degree : index.degrees()) {
+        PolynomBuilder component;
+        for (const PolyTerm& term : index.all()) {
+            if (term.degree == degree) {
+                component.add(term.ratio, term.powers[0], term.powers[1], term.powers[2]);
+            }
+        }
+        scanned += component.build().size();
+    }
+    double scan_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    size_t sliced = 0;
+    for (int degree : index.degrees()) {
+        sliced += index.degree(degree).to_polynom().size();
+    }
+    double slice_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    double visited = 0.0;
+    for (int degree : index.degrees()) {
+        for (const PolyTerm& term : index.degree(degree)) {
+            visited += term.ratio;
+        }
+    }
+    double view_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "  full scans:        " << scan_time * 1e3 << " ms (" << scanned << " terms)" << std::endl;
+    std::cout << "  index slices:      " << slice_time * 1e3 << " ms (" << sliced << " terms)" << std::endl;
+    std::cout << "  views, no copies:  " << view_time * 1e3 << " ms (sum " << visited << ")" << std::endl;
+    return 0;
+}
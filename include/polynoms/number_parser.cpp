@@ -0,0 +1,355 @@
+#include "number_parser.h"
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+bool is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+uint64_t load_eight(const char* p) {
+    uint64_t val;
+    std::memcpy(&val, p, sizeof(val));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    val = __builtin_bswap64(val);
+#endif
+    return val;
+}
+
+// SWAR: checks 8 ASCII characters at once
+bool is_eight_digits(uint64_t val) {
+    return !(((val + 0x4646464646464646ULL) | (val - 0x3030303030303030ULL)) & 0x8080808080808080ULL);
+}
+
+uint32_t parse_eight_digits(uint64_t val) {
+    const uint64_t mask = 0x000000FF000000FFULL;
+    const uint64_t mul1 = 0x000F424000000064ULL;    // 100 + (1000000 << 32)
+    const uint64_t mul2 = 0x0000271000000001ULL;    // 1 + (10000 << 32)
+    val -= 0x3030303030303030ULL;
+    val = (val * 10) + (val >> 8);
+    val = (((val & mask) * mul1) + (((val >> 16) & mask) * mul2)) >> 32;
+    return static_cast<uint32_t>(val);
+}
+
+const char* accumulate_digits(const char* p, const char* last, uint64_t& acc) {
+    while (last - p >= 8) {
+        uint64_t chunk = load_eight(p);
+        if (!is_eight_digits(chunk)) break;
+        acc = acc * 100000000ULL + parse_eight_digits(chunk);
+        p += 8;
+    }
+    while (p != last && is_digit(*p)) {
+        acc = acc * 10 + static_cast<uint64_t>(*p - '0');
+        ++p;
+    }
+    return p;
+}
+
+struct Value128 {
+    uint64_t low;
+    uint64_t high;
+};
+
+Value128 full_multiplication(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+    return { static_cast<uint64_t>(r), static_cast<uint64_t>(r >> 64) };
+#else
+    uint64_t a_lo = a & 0xFFFFFFFFULL, a_hi = a >> 32;
+    uint64_t b_lo = b & 0xFFFFFFFFULL, b_hi = b >> 32;
+    uint64_t lo_lo = a_lo * b_lo;
+    uint64_t hi_lo = a_hi * b_lo;
+    uint64_t lo_hi = a_lo * b_hi;
+    uint64_t hi_hi = a_hi * b_hi;
+    uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFULL) + lo_hi;
+    return { (cross << 32) | (lo_lo & 0xFFFFFFFFULL), hi_hi + (hi_lo >> 32) + (cross >> 32) };
+#endif
+}
+
+int leading_zeroes(uint64_t val) {
+#if defined(__GNUC__)
+    return __builtin_clzll(val);
+#else
+    int count = 0;
+    while (!(val & 0x8000000000000000ULL)) {
+        val <<= 1;
+        ++count;
+    }
+    return count;
+#endif
+}
+
+// Truncated 128-bit approximations of 5^q, q in [SMALLEST_POWER_OF_TEN, LARGEST_POWER_OF_TEN]
+const int SMALLEST_POWER_OF_TEN = -64;
+const int LARGEST_POWER_OF_TEN = 38;
+const uint64_t POWER_OF_FIVE_128[] = {
+    0xa87fea27a539e9a5ULL, 0x3f2398d747b36224ULL, // 5^-64
+    0xd29fe4b18e88640eULL, 0x8eec7f0d19a03aadULL, // 5^-63
+    0x83a3eeeef9153e89ULL, 0x1953cf68300424acULL, // 5^-62
+    0xa48ceaaab75a8e2bULL, 0x5fa8c3423c052dd7ULL, // 5^-61
+    0xcdb02555653131b6ULL, 0x3792f412cb06794dULL, // 5^-60
+    0x808e17555f3ebf11ULL, 0xe2bbd88bbee40bd0ULL, // 5^-59
+    0xa0b19d2ab70e6ed6ULL, 0x5b6aceaeae9d0ec4ULL, // 5^-58
+    0xc8de047564d20a8bULL, 0xf245825a5a445275ULL, // 5^-57
+    0xfb158592be068d2eULL, 0xeed6e2f0f0d56712ULL, // 5^-56
+    0x9ced737bb6c4183dULL, 0x55464dd69685606bULL, // 5^-55
+    0xc428d05aa4751e4cULL, 0xaa97e14c3c26b886ULL, // 5^-54
+    0xf53304714d9265dfULL, 0xd53dd99f4b3066a8ULL, // 5^-53
+    0x993fe2c6d07b7fabULL, 0xe546a8038efe4029ULL, // 5^-52
+    0xbf8fdb78849a5f96ULL, 0xde98520472bdd033ULL, // 5^-51
+    0xef73d256a5c0f77cULL, 0x963e66858f6d4440ULL, // 5^-50
+    0x95a8637627989aadULL, 0xdde7001379a44aa8ULL, // 5^-49
+    0xbb127c53b17ec159ULL, 0x5560c018580d5d52ULL, // 5^-48
+    0xe9d71b689dde71afULL, 0xaab8f01e6e10b4a6ULL, // 5^-47
+    0x9226712162ab070dULL, 0xcab3961304ca70e8ULL, // 5^-46
+    0xb6b00d69bb55c8d1ULL, 0x3d607b97c5fd0d22ULL, // 5^-45
+    0xe45c10c42a2b3b05ULL, 0x8cb89a7db77c506aULL, // 5^-44
+    0x8eb98a7a9a5b04e3ULL, 0x77f3608e92adb242ULL, // 5^-43
+    0xb267ed1940f1c61cULL, 0x55f038b237591ed3ULL, // 5^-42
+    0xdf01e85f912e37a3ULL, 0x6b6c46dec52f6688ULL, // 5^-41
+    0x8b61313bbabce2c6ULL, 0x2323ac4b3b3da015ULL, // 5^-40
+    0xae397d8aa96c1b77ULL, 0xabec975e0a0d081aULL, // 5^-39
+    0xd9c7dced53c72255ULL, 0x96e7bd358c904a21ULL, // 5^-38
+    0x881cea14545c7575ULL, 0x7e50d64177da2e54ULL, // 5^-37
+    0xaa242499697392d2ULL, 0xdde50bd1d5d0b9e9ULL, // 5^-36
+    0xd4ad2dbfc3d07787ULL, 0x955e4ec64b44e864ULL, // 5^-35
+    0x84ec3c97da624ab4ULL, 0xbd5af13bef0b113eULL, // 5^-34
+    0xa6274bbdd0fadd61ULL, 0xecb1ad8aeacdd58eULL, // 5^-33
+    0xcfb11ead453994baULL, 0x67de18eda5814af2ULL, // 5^-32
+    0x81ceb32c4b43fcf4ULL, 0x80eacf948770ced7ULL, // 5^-31
+    0xa2425ff75e14fc31ULL, 0xa1258379a94d028dULL, // 5^-30
+    0xcad2f7f5359a3b3eULL, 0x096ee45813a04330ULL, // 5^-29
+    0xfd87b5f28300ca0dULL, 0x8bca9d6e188853fcULL, // 5^-28
+    0x9e74d1b791e07e48ULL, 0x775ea264cf55347eULL, // 5^-27
+    0xc612062576589ddaULL, 0x95364afe032a819eULL, // 5^-26
+    0xf79687aed3eec551ULL, 0x3a83ddbd83f52205ULL, // 5^-25
+    0x9abe14cd44753b52ULL, 0xc4926a9672793543ULL, // 5^-24
+    0xc16d9a0095928a27ULL, 0x75b7053c0f178294ULL, // 5^-23
+    0xf1c90080baf72cb1ULL, 0x5324c68b12dd6339ULL, // 5^-22
+    0x971da05074da7beeULL, 0xd3f6fc16ebca5e04ULL, // 5^-21
+    0xbce5086492111aeaULL, 0x88f4bb1ca6bcf585ULL, // 5^-20
+    0xec1e4a7db69561a5ULL, 0x2b31e9e3d06c32e6ULL, // 5^-19
+    0x9392ee8e921d5d07ULL, 0x3aff322e62439fd0ULL, // 5^-18
+    0xb877aa3236a4b449ULL, 0x09befeb9fad487c3ULL, // 5^-17
+    0xe69594bec44de15bULL, 0x4c2ebe687989a9b4ULL, // 5^-16
+    0x901d7cf73ab0acd9ULL, 0x0f9d37014bf60a11ULL, // 5^-15
+    0xb424dc35095cd80fULL, 0x538484c19ef38c95ULL, // 5^-14
+    0xe12e13424bb40e13ULL, 0x2865a5f206b06fbaULL, // 5^-13
+    0x8cbccc096f5088cbULL, 0xf93f87b7442e45d4ULL, // 5^-12
+    0xafebff0bcb24aafeULL, 0xf78f69a51539d749ULL, // 5^-11
+    0xdbe6fecebdedd5beULL, 0xb573440e5a884d1cULL, // 5^-10
+    0x89705f4136b4a597ULL, 0x31680a88f8953031ULL, // 5^-9
+    0xabcc77118461cefcULL, 0xfdc20d2b36ba7c3eULL, // 5^-8
+    0xd6bf94d5e57a42bcULL, 0x3d32907604691b4dULL, // 5^-7
+    0x8637bd05af6c69b5ULL, 0xa63f9a49c2c1b110ULL, // 5^-6
+    0xa7c5ac471b478423ULL, 0x0fcf80dc33721d54ULL, // 5^-5
+    0xd1b71758e219652bULL, 0xd3c36113404ea4a9ULL, // 5^-4
+    0x83126e978d4fdf3bULL, 0x645a1cac083126eaULL, // 5^-3
+    0xa3d70a3d70a3d70aULL, 0x3d70a3d70a3d70a4ULL, // 5^-2
+    0xccccccccccccccccULL, 0xcccccccccccccccdULL, // 5^-1
+    0x8000000000000000ULL, 0x0000000000000000ULL, // 5^0
+    0xa000000000000000ULL, 0x0000000000000000ULL, // 5^1
+    0xc800000000000000ULL, 0x0000000000000000ULL, // 5^2
+    0xfa00000000000000ULL, 0x0000000000000000ULL, // 5^3
+    0x9c40000000000000ULL, 0x0000000000000000ULL, // 5^4
+    0xc350000000000000ULL, 0x0000000000000000ULL, // 5^5
+    0xf424000000000000ULL, 0x0000000000000000ULL, // 5^6
+    0x9896800000000000ULL, 0x0000000000000000ULL, // 5^7
+    0xbebc200000000000ULL, 0x0000000000000000ULL, // 5^8
+    0xee6b280000000000ULL, 0x0000000000000000ULL, // 5^9
+    0x9502f90000000000ULL, 0x0000000000000000ULL, // 5^10
+    0xba43b74000000000ULL, 0x0000000000000000ULL, // 5^11
+    0xe8d4a51000000000ULL, 0x0000000000000000ULL, // 5^12
+    0x9184e72a00000000ULL, 0x0000000000000000ULL, // 5^13
+    0xb5e620f480000000ULL, 0x0000000000000000ULL, // 5^14
+    0xe35fa931a0000000ULL, 0x0000000000000000ULL, // 5^15
+    0x8e1bc9bf04000000ULL, 0x0000000000000000ULL, // 5^16
+    0xb1a2bc2ec5000000ULL, 0x0000000000000000ULL, // 5^17
+    0xde0b6b3a76400000ULL, 0x0000000000000000ULL, // 5^18
+    0x8ac7230489e80000ULL, 0x0000000000000000ULL, // 5^19
+    0xad78ebc5ac620000ULL, 0x0000000000000000ULL, // 5^20
+    0xd8d726b7177a8000ULL, 0x0000000000000000ULL, // 5^21
+    0x878678326eac9000ULL, 0x0000000000000000ULL, // 5^22
+    0xa968163f0a57b400ULL, 0x0000000000000000ULL, // 5^23
+    0xd3c21bcecceda100ULL, 0x0000000000000000ULL, // 5^24
+    0x84595161401484a0ULL, 0x0000000000000000ULL, // 5^25
+    0xa56fa5b99019a5c8ULL, 0x0000000000000000ULL, // 5^26
+    0xcecb8f27f4200f3aULL, 0x0000000000000000ULL, // 5^27
+    0x813f3978f8940984ULL, 0x4000000000000000ULL, // 5^28
+    0xa18f07d736b90be5ULL, 0x5000000000000000ULL, // 5^29
+    0xc9f2c9cd04674edeULL, 0xa400000000000000ULL, // 5^30
+    0xfc6f7c4045812296ULL, 0x4d00000000000000ULL, // 5^31
+    0x9dc5ada82b70b59dULL, 0xf020000000000000ULL, // 5^32
+    0xc5371912364ce305ULL, 0x6c28000000000000ULL, // 5^33
+    0xf684df56c3e01bc6ULL, 0xc732000000000000ULL, // 5^34
+    0x9a130b963a6c115cULL, 0x3c7f400000000000ULL, // 5^35
+    0xc097ce7bc90715b3ULL, 0x4b9f100000000000ULL, // 5^36
+    0xf0bdc21abb48db20ULL, 0x1e86d40000000000ULL, // 5^37
+    0x96769950b50d88f4ULL, 0x1314448000000000ULL  // 5^38
+};
+
+const int MANTISSA_BITS = 23;
+const int MINIMUM_EXPONENT = -127;
+const int INFINITE_POWER = 0xFF;
+const int MIN_EXPONENT_ROUND_TO_EVEN = -17;
+const int MAX_EXPONENT_ROUND_TO_EVEN = 10;
+
+const float EXACT_POWERS_OF_TEN[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+
+// Eisel-Lemire: w * 10^q rounded to nearest float, w != 0 and at most 19 digits.
+// Returns the biased binary exponent, INFINITE_POWER on overflow.
+int compute_float(int64_t q, uint64_t w, uint64_t& mantissa) {
+    if (q < SMALLEST_POWER_OF_TEN) {
+        mantissa = 0;
+        return 0;
+    }
+    if (q > LARGEST_POWER_OF_TEN) {
+        mantissa = 0;
+        return INFINITE_POWER;
+    }
+
+    int lz = leading_zeroes(w);
+    w <<= lz;
+
+    const int bit_precision = MANTISSA_BITS + 3;
+    const uint64_t precision_mask = 0xFFFFFFFFFFFFFFFFULL >> bit_precision;
+    size_t index = 2 * static_cast<size_t>(q - SMALLEST_POWER_OF_TEN);
+    Value128 product = full_multiplication(w, POWER_OF_FIVE_128[index]);
+    if ((product.high & precision_mask) == precision_mask) {
+        Value128 second = full_multiplication(w, POWER_OF_FIVE_128[index + 1]);
+        product.low += second.high;
+        if (second.high > product.low) {
+            product.high++;
+        }
+    }
+
+    int upperbit = static_cast<int>(product.high >> 63);
+    int shift = upperbit + 64 - MANTISSA_BITS - 3;
+    mantissa = product.high >> shift;
+    int power2 = static_cast<int>((((152170 + 65536) * q) >> 16) + 63) + upperbit - lz - MINIMUM_EXPONENT;
+
+    if (power2 <= 0) {
+        if (-power2 + 1 >= 64) {
+            mantissa = 0;
+            return 0;
+        }
+        mantissa >>= -power2 + 1;
+        mantissa += (mantissa & 1);
+        mantissa >>= 1;
+        power2 = (mantissa < (uint64_t(1) << MANTISSA_BITS)) ? 0 : 1;
+        return power2;
+    }
+
+    if ((product.low <= 1) && (q >= MIN_EXPONENT_ROUND_TO_EVEN) && (q <= MAX_EXPONENT_ROUND_TO_EVEN) &&
+        ((mantissa & 3) == 1)) {
+        if ((mantissa << shift) == product.high) {
+            mantissa &= ~uint64_t(1);
+        }
+    }
+
+    mantissa += (mantissa & 1);
+    mantissa >>= 1;
+    if (mantissa >= (uint64_t(2) << MANTISSA_BITS)) {
+        mantissa = (uint64_t(1) << MANTISSA_BITS);
+        power2++;
+    }
+    mantissa &= ~(uint64_t(1) << MANTISSA_BITS);
+    if (power2 >= INFINITE_POWER) {
+        mantissa = 0;
+        return INFINITE_POWER;
+    }
+    return power2;
+}
+
+}
+
+NumberResult NumberParser::parse_decimal(const char* first, const char* last, float& value) {
+    uint64_t mantissa = 0;
+    const char* p = accumulate_digits(first, last, mantissa);
+    int64_t digit_count = p - first;
+    int64_t exponent = 0;
+
+    if (p != last && *p == '.') {
+        const char* frac_start = ++p;
+        p = accumulate_digits(p, last, mantissa);
+        exponent = frac_start - p;
+        digit_count -= exponent;
+    }
+    if (digit_count == 0) {
+        return { first, NumberStatus::INVALID };
+    }
+
+    if (digit_count > 19) {
+        const char* s = first;
+        while (s != p && (*s == '0' || *s == '.')) {
+            if (*s == '0') digit_count--;
+            ++s;
+        }
+        if (digit_count > 19) {
+            // Rare: more significant digits than fit in 64 bits, let the standard library round it
+            auto [ptr, ec] = std::from_chars(first, p, value, std::chars_format::fixed);
+            if (ec == std::errc::result_out_of_range) {
+                const char* s_int = first;
+                while (s_int != p && *s_int == '0') ++s_int;
+                if (s_int != p && *s_int != '.') {
+                    return { p, NumberStatus::OUT_OF_RANGE };
+                }
+                value = 0.0f;
+            }
+            return { p, NumberStatus::OK };
+        }
+    }
+
+    if (mantissa <= (uint64_t(1) << 24) && exponent >= -10 && exponent <= 10) {
+        float f = static_cast<float>(mantissa);
+        value = exponent < 0 ? f / EXACT_POWERS_OF_TEN[-exponent] : f * EXACT_POWERS_OF_TEN[exponent];
+        return { p, NumberStatus::OK };
+    }
+    if (mantissa == 0) {
+        value = 0.0f;
+        return { p, NumberStatus::OK };
+    }
+
+    uint64_t bits_mantissa = 0;
+    int power2 = compute_float(exponent, mantissa, bits_mantissa);
+    if (power2 == INFINITE_POWER) {
+        return { p, NumberStatus::OUT_OF_RANGE };
+    }
+    uint32_t bits = static_cast<uint32_t>(bits_mantissa) | (static_cast<uint32_t>(power2) << MANTISSA_BITS);
+    std::memcpy(&value, &bits, sizeof(value));
+    return { p, NumberStatus::OK };
+}
+
+NumberResult NumberParser::parse_integer(const char* first, const char* last, int& value) {
+    const char* p = first;
+    while (p != last && *p == '0') {
+        ++p;
+    }
+    const char* significant = p;
+    uint64_t acc = 0;
+    if (last - p >= 8) {
+        uint64_t chunk = load_eight(p);
+        if (is_eight_digits(chunk)) {
+            acc = parse_eight_digits(chunk);
+            p += 8;
+        }
+    }
+    while (p != last && is_digit(*p)) {
+        if (p - significant < 19) {
+            acc = acc * 10 + static_cast<uint64_t>(*p - '0');
+        }
+        ++p;
+    }
+
+    if (p == first) {
+        return { first, NumberStatus::INVALID };
+    }
+    if (p - significant > 10 || acc > static_cast<uint64_t>(std::numeric_limits<int>::max())) {
+        return { p, NumberStatus::OUT_OF_RANGE };
+    }
+    value = static_cast<int>(acc);
+    return { p, NumberStatus::OK };
+}
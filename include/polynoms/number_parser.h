@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+
+enum class NumberStatus {
+    OK,
+    INVALID,
+    OUT_OF_RANGE
+};
+
+// Like std::from_chars: ptr points past the consumed characters (or at first on INVALID).
+struct NumberResult {
+    const char* ptr;
+    NumberStatus status;
+};
+
+// Allocation-free, locale-independent parsers for the number formats used in polynom literals.
+class NumberParser {
+public:
+    // Unsigned decimal "digits[.digits]" or ".digits". Values below FLT_MIN round to zero,
+    // values above FLT_MAX report OUT_OF_RANGE.
+    static NumberResult parse_decimal(const char* first, const char* last, float& value);
+
+    // Unsigned run of digits that has to fit into int.
+    static NumberResult parse_integer(const char* first, const char* last, int& value);
+};
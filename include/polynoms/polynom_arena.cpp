@@ -0,0 +1,50 @@
+#include "polynom_arena.h"
+
+static thread_local std::pmr::memory_resource* current_resource = nullptr;
+
+std::pmr::memory_resource* polynom_resource() {
+    return current_resource ? current_resource : std::pmr::new_delete_resource();
+}
+
+
+void* PolynomArena::CountingResource::do_allocate(size_t size, size_t alignment) {
+    void* ptr = upstream->allocate(size, alignment);
+    allocations++;
+    bytes += size;
+    return ptr;
+}
+
+void PolynomArena::CountingResource::do_deallocate(void* ptr, size_t size, size_t alignment) {
+    upstream->deallocate(ptr, size, alignment);
+}
+
+bool PolynomArena::CountingResource::do_is_equal(const std::pmr::memory_resource& oth) const noexcept {
+    return this == &oth;
+}
+
+
+PolynomArena::PolynomArena(std::pmr::memory_resource* upstream)
+    : upstream_counter(upstream),
+    buffer(initial_buffer, INITIAL_BUFFER_SIZE, &upstream_counter),
+    front(&buffer) {
+}
+
+std::pmr::memory_resource* PolynomArena::resource() {
+    return &front;
+}
+
+PolynomArena::Stats PolynomArena::stats() const {
+    Stats result;
+    result.requests = front.allocations;
+    result.bytes = front.bytes;
+    result.upstream_allocations = upstream_counter.allocations;
+    return result;
+}
+
+PolynomArena::Scope::Scope(PolynomArena& arena) : previous(current_resource) {
+    current_resource = arena.resource();
+}
+
+PolynomArena::Scope::~Scope() {
+    current_resource = previous;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "polynoms.h"
+#include <cstddef>
+#include <memory_resource>
+
+// Monotonic arena for the short-lived polynoms of one expression. While a Scope is active every
+// Polynom created on this thread allocates from the arena and nothing is freed until the arena dies,
+// so anything that has to outlive it must be copied after the scope has ended.
+class PolynomArena {
+public:
+    struct Stats {
+        size_t requests = 0;        // allocations served by the arena
+        size_t bytes = 0;
+        size_t upstream_allocations = 0;    // blocks the arena had to take from its upstream resource
+    };
+
+    static const size_t INITIAL_BUFFER_SIZE = 4096;
+
+    explicit PolynomArena(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+    PolynomArena(const PolynomArena&) = delete;
+    PolynomArena& operator=(const PolynomArena&) = delete;
+
+    std::pmr::memory_resource* resource();
+    Stats stats() const;
+
+    class Scope {
+    private:
+        std::pmr::memory_resource* previous;
+
+    public:
+        explicit Scope(PolynomArena& arena);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+private:
+    class CountingResource : public std::pmr::memory_resource {
+    private:
+        std::pmr::memory_resource* upstream;
+
+    public:
+        size_t allocations = 0;
+        size_t bytes = 0;
+
+        explicit CountingResource(std::pmr::memory_resource* upstream_resource) : upstream(upstream_resource) {}
+
+    private:
+        void* do_allocate(size_t size, size_t alignment) override;
+        void do_deallocate(void* ptr, size_t size, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& oth) const noexcept override;
+    };
+
+    CountingResource upstream_counter;
+    alignas(std::max_align_t) unsigned char initial_buffer[INITIAL_BUFFER_SIZE];
+    std::pmr::monotonic_buffer_resource buffer;
+    CountingResource front;
+};
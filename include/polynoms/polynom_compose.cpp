@@ -0,0 +1,103 @@
+#include "polynoms.h"
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// q^k on demand as q^(k/2) squared, times q for odd k; every power is kept for reuse
+class PowerCache {
+public:
+    explicit PowerCache(const Polynom& base) : base(base) {}
+
+    const Polynom& get(int power) {
+        if (power == 1) {
+            return base;
+        }
+        auto it = powers.find(power);
+        if (it != powers.end()) {
+            return it->second;
+        }
+        Polynom result;
+        if (power == 0) {
+            result.addMonom(Monom(1.0f, { 0, 0, 0 }));
+        }
+        else {
+            const Polynom& half = get(power / 2);
+            result = half * half;
+            if (power % 2) {
+                result = result * base;
+            }
+        }
+        return powers.emplace(power, std::move(result)).first->second;
+    }
+
+private:
+    const Polynom& base;
+    std::map<int, Polynom> powers;
+};
+
+// Horner over the groups [begin, end) split by key: acc = acc * q^(previous key - key) + coefficient,
+// with the last key multiplied in at the end
+template <typename Key, typename Coefficient>
+Polynom horner(const PolyTerm* begin, const PolyTerm* end, PowerCache& cache, Key&& key, Coefficient&& coefficient) {
+    Polynom acc;
+    int previous = 0;
+    for (const PolyTerm* group = begin; group != end;) {
+        const PolyTerm* group_end = group;
+        while (group_end != end && key(*group_end) == key(*group)) {
+            ++group_end;
+        }
+        Polynom value = coefficient(group, group_end);
+        if (group != begin) {
+            acc = acc * cache.get(previous - key(*group)) + value;
+        }
+        else {
+            acc = std::move(value);
+        }
+        previous = key(*group);
+        group = group_end;
+    }
+    if (previous != 0 && acc.size() != 0) {
+        acc = acc * cache.get(previous);
+    }
+    return acc;
+}
+
+}
+
+Polynom Polynom::compose(const Polynom& qx, const Polynom& qy, const Polynom& qz) const {
+    std::vector<PolyTerm> sorted;
+    sorted.reserve(size());
+    for_each_term_unordered([&sorted](float ratio, const int* powers) {
+        if (powers[0] < 0 || powers[1] < 0 || powers[2] < 0) {
+            throw std::invalid_argument("Polynom::compose: cannot substitute into negative powers");
+        }
+        sorted.push_back(make_term(ratio, powers));
+    });
+    std::sort(sorted.begin(), sorted.end(), [](const PolyTerm& a, const PolyTerm& b) {
+        return std::lexicographical_compare(b.powers, b.powers + 3, a.powers, a.powers + 3);
+    });
+
+    PowerCache x_powers(qx);
+    PowerCache y_powers(qy);
+    PowerCache z_powers(qz);
+    // Terms sharing x and y powers: sum of ratio * qz^c, merged in one normalize
+    auto z_combination = [&z_powers](const PolyTerm* begin, const PolyTerm* end) {
+        Polynom sum;
+        for (const PolyTerm* term = begin; term != end; ++term) {
+            const float ratio = term->ratio;
+            z_powers.get(term->powers[2]).for_each_term_unordered([&sum, ratio](float r, const int* powers) {
+                sum.terms.push_back(make_term(ratio * r, powers));
+            });
+        }
+        sum.normalize();
+        return sum;
+    };
+    auto y_horner = [&](const PolyTerm* begin, const PolyTerm* end) {
+        return horner(begin, end, y_powers, [](const PolyTerm& term) { return term.powers[1]; }, z_combination);
+    };
+    return horner(sorted.data(), sorted.data() + sorted.size(), x_powers,
+        [](const PolyTerm& term) { return term.powers[0]; }, y_horner);
+}
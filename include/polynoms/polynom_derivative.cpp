@@ -0,0 +1,72 @@
+#include "polynoms.h"
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <utility>
+
+Polynom Polynom::derivative(size_t var) const {
+    if (var >= 3) {
+        throw std::out_of_range("Polynom::derivative: variable index out of range");
+    }
+    Polynom result;
+    if (dense) {
+        // The cell of power p moves to p - 1; a slab of power 0 at the low end would stay all zero
+        // and is dropped from the box
+        size_t skip = dense_lo[var] == 0 ? 1 : 0;
+        Box box;
+        for (size_t i = 0; i < 3; ++i) {
+            box.lo[i] = dense_lo[i];
+            box.hi[i] = dense_lo[i] + dense_extent[i] - 1;
+        }
+        box.lo[var] += static_cast<int>(skip) - 1;
+        box.hi[var] -= 1;
+        if (box.hi[var] < box.lo[var]) {
+            return result;
+        }
+        int extent[3] = { box.hi[0] - box.lo[0] + 1, box.hi[1] - box.lo[1] + 1, box.hi[2] - box.lo[2] + 1 };
+        size_t shift[3] = { 0, 0, 0 };
+        shift[var] = skip;
+        DenseStorage coeffs(static_cast<size_t>(extent[0]) * extent[1] * extent[2], 0.0f, result.dense_coeffs.get_allocator());
+        size_t idx = 0;
+        int cell[3];
+        for (cell[0] = 0; cell[0] < extent[0]; ++cell[0]) {
+            for (cell[1] = 0; cell[1] < extent[1]; ++cell[1]) {
+                size_t source = ((cell[0] + shift[0]) * dense_extent[1] + cell[1] + shift[1]) * dense_extent[2] + shift[2];
+                for (cell[2] = 0; cell[2] < extent[2]; ++cell[2], ++idx, ++source) {
+                    coeffs[idx] = dense_coeffs[source] * static_cast<float>(box.lo[var] + cell[var] + 1);
+                }
+            }
+        }
+        result.assign_dense(box, std::move(coeffs));
+        return result;
+    }
+
+    // Lowering one power keeps the order among the terms whose max power stays and among those
+    // whose max power drops with it (var was the only max), so the two runs are merged in O(n)
+    result.terms.reserve(terms.size());
+    TermStorage lowered{ polynom_resource() };
+    for (const PolyTerm& term : terms) {
+        if (term.powers[var] == 0) {
+            continue;
+        }
+        int powers[3] = { term.powers[0], term.powers[1], term.powers[2] };
+        powers[var] -= 1;
+        PolyTerm derived = make_term(term.ratio * static_cast<float>(term.powers[var]), powers);
+        const bool drops = term.powers[var] > term.powers[(var + 1) % 3] && term.powers[var] > term.powers[(var + 2) % 3];
+        (drops ? lowered : result.terms).push_back(derived);
+    }
+    if (!lowered.empty()) {
+        const size_t kept = result.terms.size();
+        for (const PolyTerm& term : lowered) {
+            result.terms.push_back(term);
+        }
+        std::inplace_merge(result.terms.begin(), result.terms.begin() + kept, result.terms.end(),
+            [](const PolyTerm& a, const PolyTerm& b) { return compare_powers(a.powers, b.powers) > 0; });
+    }
+    result.refresh();
+    return result;
+}
+
+std::array<Polynom, 3> Polynom::gradient() const {
+    return { derivative(0), derivative(1), derivative(2) };
+}
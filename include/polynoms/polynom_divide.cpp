@@ -0,0 +1,246 @@
+#include "polynoms.h"
+#include "polynom_multiply.h"
+#include "polynom_parser.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using Exponents = std::array<int, 3>;
+
+// Graded lex order: higher total degree first, then higher x, y, z powers
+struct GradedLexGreater {
+    bool operator()(const Exponents& a, const Exponents& b) const {
+        int64_t degree_a = static_cast<int64_t>(a[0]) + a[1] + a[2];
+        int64_t degree_b = static_cast<int64_t>(b[0]) + b[1] + b[2];
+        if (degree_a != degree_b) {
+            return degree_a > degree_b;
+        }
+        return a > b;
+    }
+};
+
+static void check_divisor(const Polynom& divisor) {
+    if (divisor.size() == 0) {
+        throw std::invalid_argument("Polynom::divide: division by zero");
+    }
+}
+
+static Polynom from_coefficients(const std::vector<double>& coeffs) {
+    PolynomBuilder builder;
+    for (size_t i = 0; i < coeffs.size(); ++i) {
+        builder.add(static_cast<float>(coeffs[i]), static_cast<int>(i), 0, 0);
+    }
+    return builder.build();
+}
+
+// Inverse of f modulo x^length: g <- g + g * (1 - f * g) doubles the number of correct coefficients
+static std::vector<double> reciprocal(const std::vector<double>& f, size_t length) {
+    std::vector<double> g = { 1.0 / f[0] };
+    std::vector<double> product, error, correction;
+    for (size_t precision = 1; precision < length;) {
+        size_t next = std::min(2 * precision, length);
+        size_t used = std::min(f.size(), next);
+        product.resize(used + g.size() - 1);
+        MultiplyPlanner::multiply_coefficients(f.data(), used, g.data(), g.size(), product.data());
+        // 1 - f * g vanishes below x^precision; error holds its coefficients up to x^next
+        error.assign(next - precision, 0.0);
+        for (size_t i = precision; i < next && i < product.size(); ++i) {
+            error[i - precision] = -product[i];
+        }
+        correction.resize(error.size() + g.size() - 1);
+        MultiplyPlanner::multiply_coefficients(g.data(), g.size(), error.data(), error.size(), correction.data());
+        g.resize(next, 0.0);
+        for (size_t i = precision; i < next; ++i) {
+            g[i] = correction[i - precision];
+        }
+        precision = next;
+    }
+    return g;
+}
+
+// a and b by ascending power, b.back() != 0 and a.size() >= b.size()
+static void divide_schoolbook(const std::vector<double>& a, const std::vector<double>& b,
+    std::vector<double>& quotient, std::vector<double>& remainder) {
+    const size_t m = b.size();
+    const size_t k = a.size() - m + 1;
+    quotient.assign(k, 0.0);
+    remainder = a;
+    for (size_t i = k; i-- > 0;) {
+        double q = remainder[i + m - 1] / b[m - 1];
+        quotient[i] = q;
+        for (size_t j = 0; j < m; ++j) {
+            remainder[i + j] -= q * b[j];
+        }
+    }
+    remainder.resize(m - 1);
+}
+
+// rev(quotient) = rev(a) / rev(b) modulo x^k. The explicit reciprocal is unstable when its
+// coefficients grow: 1 / rev(b) converges only within 1 / max |root of b|, so they do for roots of
+// b outside the unit disk. The result is only accepted if the reciprocal stays bounded and
+// a - quotient * b vanishes at x^(m - 1) and above, up to rounding relative to the size of the
+// terms; otherwise returns false.
+static bool divide_newton(const std::vector<double>& a, const std::vector<double>& b,
+    std::vector<double>& quotient, std::vector<double>& remainder) {
+    const size_t n = a.size();
+    const size_t m = b.size();
+    const size_t k = n - m + 1;
+    const double growth_bound = 1e6;
+    const double tolerance = 1e-9;
+    std::vector<double> reversed_b(b.rbegin(), b.rend());
+    std::vector<double> inverse = reciprocal(reversed_b, k);
+    for (double c : inverse) {
+        if (!(std::abs(c * reversed_b[0]) <= growth_bound)) {
+            return false;
+        }
+    }
+    std::vector<double> reversed_a(a.rbegin(), a.rbegin() + k);
+    std::vector<double> product(2 * k - 1);
+    MultiplyPlanner::multiply_coefficients(reversed_a.data(), k, inverse.data(), k, product.data());
+    quotient.assign(k, 0.0);
+    for (size_t i = 0; i < k; ++i) {
+        quotient[k - 1 - i] = product[i];
+    }
+    std::vector<double> back(n);
+    MultiplyPlanner::multiply_coefficients(quotient.data(), k, b.data(), m, back.data());
+    double scale = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        scale = std::max(scale, std::max(std::abs(a[i]), std::abs(back[i])));
+    }
+    for (size_t i = m - 1; i < n; ++i) {
+        if (!(std::abs(a[i] - back[i]) <= tolerance * scale)) {
+            return false;
+        }
+    }
+    remainder.resize(m - 1);
+    for (size_t i = 0; i + 1 < m; ++i) {
+        remainder[i] = a[i] - back[i];
+    }
+    return true;
+}
+
+static Polynom::Division divide_coefficients(const std::vector<double>& a, const std::vector<double>& b) {
+    const size_t m = b.size();
+    const size_t k = a.size() - m + 1;
+    std::vector<double> quotient, remainder;
+    if (k < Polynom::DIVIDE_NEWTON_MIN_LENGTH || m < Polynom::DIVIDE_NEWTON_MIN_LENGTH ||
+        !divide_newton(a, b, quotient, remainder)) {
+        divide_schoolbook(a, b, quotient, remainder);
+    }
+    return { from_coefficients(quotient), from_coefficients(remainder) };
+}
+
+Polynom::Division Polynom::divide(const Polynom& divisor) const {
+    check_divisor(divisor);
+    bool univariate = is_univariate() && divisor.is_univariate() &&
+        static_cast<size_t>(std::max(degree(0), divisor.degree(0))) < DENSE_MAX_VOLUME;
+    auto gather = [&univariate](const Polynom& p, std::vector<double>& coeffs) {
+        coeffs.assign(p.size() == 0 ? 0 : static_cast<size_t>(std::max(p.degree(0), 0)) + 1, 0.0);
+        p.for_each_term_unordered([&](float ratio, const int* powers) {
+            if (powers[0] < 0) {
+                univariate = false;
+            }
+            else {
+                coeffs[powers[0]] = ratio;
+            }
+        });
+    };
+    std::vector<double> a, b;
+    if (univariate) {
+        gather(*this, a);
+        gather(divisor, b);
+    }
+    if (!univariate) {
+        Division result;
+        result.quotient = std::move(divide(std::vector<Polynom>{ divisor }, result.remainder).front());
+        return result;
+    }
+    if (a.size() < b.size()) {
+        return { Polynom(), *this };
+    }
+    return divide_coefficients(a, b);
+}
+
+std::vector<Polynom> Polynom::divide(const std::vector<Polynom>& divisors, Polynom& remainder) const {
+    struct Divisor {
+        Exponents lead;
+        double ratio;
+        std::vector<std::pair<Exponents, double>> terms;
+    };
+    auto exponents = [](const int* powers) {
+        if (powers[0] < 0 || powers[1] < 0 || powers[2] < 0) {
+            throw std::invalid_argument("Polynom::divide: negative powers");
+        }
+        return Exponents{ powers[0], powers[1], powers[2] };
+    };
+
+    std::vector<Divisor> set(divisors.size());
+    for (size_t i = 0; i < divisors.size(); ++i) {
+        check_divisor(divisors[i]);
+        divisors[i].for_each_term_unordered([&](float ratio, const int* powers) {
+            set[i].terms.emplace_back(exponents(powers), ratio);
+        });
+        auto lead = std::min_element(set[i].terms.begin(), set[i].terms.end(),
+            [](const std::pair<Exponents, double>& a, const std::pair<Exponents, double>& b) {
+                return GradedLexGreater()(a.first, b.first);
+            });
+        set[i].lead = lead->first;
+        set[i].ratio = lead->second;
+    }
+
+    std::map<Exponents, double, GradedLexGreater> work;
+    for_each_term_unordered([&](float ratio, const int* powers) {
+        work.emplace(exponents(powers), ratio);
+    });
+    std::vector<PolynomBuilder> quotients(divisors.size());
+    PolynomBuilder rest;
+    while (!work.empty()) {
+        auto top = work.begin();
+        const Exponents lead = top->first;
+        const double ratio = top->second;
+        work.erase(top);
+        auto divides = [&lead](const Divisor& d) {
+            return d.lead[0] <= lead[0] && d.lead[1] <= lead[1] && d.lead[2] <= lead[2];
+        };
+        auto found = std::find_if(set.begin(), set.end(), divides);
+        if (found == set.end()) {
+            rest.add(static_cast<float>(ratio), lead[0], lead[1], lead[2]);
+            continue;
+        }
+        const Divisor& d = *found;
+        const double factor = ratio / d.ratio;
+        const Exponents shift = { lead[0] - d.lead[0], lead[1] - d.lead[1], lead[2] - d.lead[2] };
+        quotients[found - set.begin()].add(static_cast<float>(factor), shift[0], shift[1], shift[2]);
+        for (const std::pair<Exponents, double>& term : d.terms) {
+            if (term.first == d.lead) {
+                continue;
+            }
+            Exponents key = { term.first[0] + shift[0], term.first[1] + shift[1], term.first[2] + shift[2] };
+            double& value = work[key];
+            value -= factor * term.second;
+            if (std::abs(value) < EPSILON) {
+                work.erase(key);
+            }
+        }
+    }
+
+    remainder = rest.build();
+    std::vector<Polynom> result;
+    result.reserve(quotients.size());
+    for (PolynomBuilder& quotient : quotients) {
+        result.push_back(quotient.build());
+    }
+    return result;
+}
+
+Polynom operator/(const Polynom& a, const Polynom& b) {
+    return a.divide(b).quotient;
+}
+
+Polynom operator%(const Polynom& a, const Polynom& b) {
+    return a.divide(b).remainder;
+}
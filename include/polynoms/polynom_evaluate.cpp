@@ -0,0 +1,278 @@
+#include "polynoms.h"
+#include "polynom_parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Points evaluated together by one Horner pass; the fixed-size inner loops vectorize
+static const size_t HORNER_BATCH = 8;
+
+static double ipow(double x, int64_t power) {
+    uint64_t e = power < 0 ? 0 - static_cast<uint64_t>(power) : static_cast<uint64_t>(power);
+    double result = 1.0;
+    while (e) {
+        if (e & 1) {
+            result *= x;
+        }
+        x *= x;
+        e >>= 1;
+    }
+    return power < 0 ? 1.0 / result : result;
+}
+
+// acc = acc * x^gap + ratio
+struct HornerStep {
+    int64_t gap;
+    double ratio;
+};
+
+static void horner_batches(const std::vector<HornerStep>& steps, int64_t tail, const double* xs, double* out, size_t count) {
+    for (size_t start = 0; start < count; start += HORNER_BATCH) {
+        size_t length = std::min(HORNER_BATCH, count - start);
+        double x[HORNER_BATCH];
+        double acc[HORNER_BATCH];
+        for (size_t k = 0; k < HORNER_BATCH; ++k) {
+            x[k] = k < length ? xs[start + k] : 1.0;
+            acc[k] = 0.0;
+        }
+        for (const HornerStep& step : steps) {
+            if (step.gap == 1) {
+                for (size_t k = 0; k < HORNER_BATCH; ++k) {
+                    acc[k] = acc[k] * x[k] + step.ratio;
+                }
+            }
+            else {
+                for (size_t k = 0; k < HORNER_BATCH; ++k) {
+                    acc[k] = acc[k] * ipow(x[k], step.gap) + step.ratio;
+                }
+            }
+        }
+        if (tail != 0) {
+            for (size_t k = 0; k < HORNER_BATCH; ++k) {
+                acc[k] *= ipow(x[k], tail);
+            }
+        }
+        std::copy(acc, acc + length, out + start);
+    }
+}
+
+
+double Polynom::evaluate(double x, double y, double z) const {
+    double result = 0.0;
+    for_each_term_unordered([&](float ratio, const int* powers) {
+        result += ratio * ipow(x, powers[0]) * ipow(y, powers[1]) * ipow(z, powers[2]);
+    });
+    return result;
+}
+
+bool Polynom::is_univariate() const {
+    bool univariate = true;
+    for_each_term_unordered([&univariate](float, const int* powers) {
+        if (powers[1] != 0 || powers[2] != 0) {
+            univariate = false;
+        }
+    });
+    return univariate;
+}
+
+std::vector<double> Polynom::evaluate(const std::vector<double>& xs) const {
+    if (!is_univariate()) {
+        throw std::invalid_argument("Polynom::evaluate: multipoint evaluation needs a polynom in x only");
+    }
+    std::vector<double> out(xs.size(), 0.0);
+    std::vector<std::pair<int, double>> powers;
+    powers.reserve(size());
+    for_each_term_unordered([&powers](float ratio, const int* p) {
+        powers.emplace_back(p[0], ratio);
+    });
+    if (powers.empty() || xs.empty()) {
+        return out;
+    }
+    std::sort(powers.begin(), powers.end(), [](const std::pair<int, double>& a, const std::pair<int, double>& b) {
+        return a.first > b.first;
+    });
+
+    // Horner on the polynom divided by its lowest power, which is multiplied back at the end
+    std::vector<HornerStep> steps;
+    steps.reserve(powers.size());
+    steps.push_back({ 1, powers.front().second });
+    for (size_t i = 1; i < powers.size(); ++i) {
+        steps.push_back({ static_cast<int64_t>(powers[i - 1].first) - powers[i].first, powers[i].second });
+    }
+    int64_t tail = powers.back().first;
+
+    size_t batches = (xs.size() + HORNER_BATCH - 1) / HORNER_BATCH;
+    size_t threads = steps.size() * xs.size() >= PARALLEL_EVALUATE_MIN_WORK ? std::min(parallel_threads(), batches) : 1;
+    size_t chunk = (batches + threads - 1) / threads * HORNER_BATCH;
+    run_parallel(threads, [&](size_t t) {
+        size_t begin = std::min(xs.size(), t * chunk);
+        size_t end = std::min(xs.size(), begin + chunk);
+        horner_batches(steps, tail, xs.data() + begin, out.data() + begin, end - begin);
+    });
+    return out;
+}
+
+Polynom Polynom::interpolate(const std::vector<double>& xs, const std::vector<double>& values) {
+    if (xs.size() != values.size()) {
+        throw std::invalid_argument("Polynom::interpolate: got " + std::to_string(xs.size()) + " points and " +
+            std::to_string(values.size()) + " values");
+    }
+    const size_t n = xs.size();
+    if (n == 0) {
+        return Polynom();
+    }
+    std::vector<double> sorted = xs;
+    std::sort(sorted.begin(), sorted.end());
+    if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end()) {
+        throw std::invalid_argument("Polynom::interpolate: repeated point");
+    }
+
+    // Leja order (largest point first, then the one farthest from all chosen in the product sense)
+    // keeps the divided differences and the expansion below well scaled
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::vector<double> log_distance(n, 0.0);
+    for (size_t k = 0; k < n; ++k) {
+        size_t best = k;
+        for (size_t i = k + 1; i < n; ++i) {
+            double score = k == 0 ? std::abs(xs[order[i]]) : log_distance[order[i]];
+            double best_score = k == 0 ? std::abs(xs[order[best]]) : log_distance[order[best]];
+            if (score > best_score) {
+                best = i;
+            }
+        }
+        std::swap(order[k], order[best]);
+        for (size_t i = k + 1; i < n; ++i) {
+            log_distance[order[i]] += std::log(std::abs(xs[order[i]] - xs[order[k]]));
+        }
+    }
+    std::vector<double> points(n);
+    std::vector<double> coeffs(n);
+    for (size_t k = 0; k < n; ++k) {
+        points[k] = xs[order[k]];
+        coeffs[k] = values[order[k]];
+    }
+
+    for (size_t j = 1; j < n; ++j) {
+        for (size_t i = n - 1; i >= j; --i) {
+            coeffs[i] = (coeffs[i] - coeffs[i - 1]) / (points[i] - points[i - j]);
+        }
+    }
+
+    // Newton form to ascending monomial coefficients: p = p * (x - points[k]) + coeffs[k]
+    std::vector<double> monomial(n, 0.0);
+    monomial[0] = coeffs[n - 1];
+    for (size_t k = n - 1; k-- > 0;) {
+        size_t degree = n - 2 - k;
+        for (size_t i = degree + 1; i > 0; --i) {
+            monomial[i] = monomial[i - 1] - points[k] * monomial[i];
+        }
+        monomial[0] = coeffs[k] - points[k] * monomial[0];
+    }
+
+    Polynom result;
+    result.terms.reserve(n);
+    for (size_t i = n; i-- > 0;) {
+        if (std::abs(monomial[i]) > EPSILON) {
+            int powers[3] = { static_cast<int>(i), 0, 0 };
+            result.terms.push_back(make_term(static_cast<float>(monomial[i]), powers));
+        }
+    }
+    result.normalize();
+    return result;
+}
+
+// Sorted distinct values and, for each input, the index of its value
+static std::vector<int> distinct_powers(const std::vector<int>& powers, std::vector<size_t>& index) {
+    std::vector<int> distinct = powers;
+    std::sort(distinct.begin(), distinct.end());
+    distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+    index.resize(powers.size());
+    for (size_t i = 0; i < powers.size(); ++i) {
+        index[i] = static_cast<size_t>(std::lower_bound(distinct.begin(), distinct.end(), powers[i]) - distinct.begin());
+    }
+    return distinct;
+}
+
+// table[p * points.size() + i] = points[i]^powers[p]
+static std::vector<double> power_table(const std::vector<int>& powers, const std::vector<double>& points) {
+    std::vector<double> table(powers.size() * points.size());
+    for (size_t p = 0; p < powers.size(); ++p) {
+        for (size_t i = 0; i < points.size(); ++i) {
+            table[p * points.size() + i] = ipow(points[i], powers[p]);
+        }
+    }
+    return table;
+}
+
+void Polynom::evaluate_grid(const std::vector<double>& xs, const std::vector<double>& ys, const std::vector<double>& zs,
+    std::vector<double>& out) const {
+    const size_t nx = xs.size();
+    const size_t ny = ys.size();
+    const size_t nz = zs.size();
+    out.assign(nx * ny * nz, 0.0);
+    if (out.empty() || size() == 0) {
+        return;
+    }
+
+    std::vector<int> powers_x, powers_y, powers_z;
+    std::vector<double> ratios;
+    for_each_term_unordered([&](float ratio, const int* powers) {
+        powers_x.push_back(powers[0]);
+        powers_y.push_back(powers[1]);
+        powers_z.push_back(powers[2]);
+        ratios.push_back(ratio);
+    });
+    std::vector<size_t> index_x, index_y, index_z;
+    std::vector<double> table_x = power_table(distinct_powers(powers_x, index_x), xs);
+    std::vector<double> table_y = power_table(distinct_powers(powers_y, index_y), ys);
+    std::vector<int> distinct_z = distinct_powers(powers_z, index_z);
+    std::vector<double> table_z = power_table(distinct_z, zs);
+
+    // Every term feeds one (y power, z power) column; contracting x leaves one value per column
+    std::vector<uint64_t> column_keys(ratios.size());
+    for (size_t t = 0; t < ratios.size(); ++t) {
+        column_keys[t] = (static_cast<uint64_t>(index_y[t]) << 32) | index_z[t];
+    }
+    std::vector<size_t> column_of;
+    std::vector<uint64_t> columns = column_keys;
+    std::sort(columns.begin(), columns.end());
+    columns.erase(std::unique(columns.begin(), columns.end()), columns.end());
+    column_of.resize(ratios.size());
+    for (size_t t = 0; t < ratios.size(); ++t) {
+        column_of[t] = static_cast<size_t>(std::lower_bound(columns.begin(), columns.end(), column_keys[t]) - columns.begin());
+    }
+
+    const size_t nc = distinct_z.size();
+    size_t work = nx * (ratios.size() + ny * (columns.size() + nz * nc));
+    size_t threads = work >= PARALLEL_EVALUATE_MIN_WORK ? std::min(parallel_threads(), nx) : 1;
+    run_parallel(threads, [&](size_t t) {
+        std::vector<double> by_column(columns.size());
+        std::vector<double> by_z(nc);
+        for (size_t i = t; i < nx; i += threads) {
+            std::fill(by_column.begin(), by_column.end(), 0.0);
+            for (size_t term = 0; term < ratios.size(); ++term) {
+                by_column[column_of[term]] += ratios[term] * table_x[index_x[term] * nx + i];
+            }
+            for (size_t j = 0; j < ny; ++j) {
+                std::fill(by_z.begin(), by_z.end(), 0.0);
+                for (size_t c = 0; c < columns.size(); ++c) {
+                    by_z[columns[c] & 0xffffffffu] += by_column[c] * table_y[(columns[c] >> 32) * ny + j];
+                }
+                double* row = out.data() + (i * ny + j) * nz;
+                for (size_t c = 0; c < nc; ++c) {
+                    const double factor = by_z[c];
+                    const double* powers = table_z.data() + c * nz;
+                    for (size_t k = 0; k < nz; ++k) {
+                        row[k] += factor * powers[k];
+                    }
+                }
+            }
+        }
+    });
+}
@@ -0,0 +1,179 @@
+#include "polynoms.h"
+#include "polynom_multiply.h"
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+void ExpressionEvaluator::begin(float sign) {
+    addends.push_back({ sign, factors.size(), 0 });
+}
+
+void ExpressionEvaluator::factor(const Polynom& p) {
+    factors.push_back(&p);
+    ++addends[addends.size() - 1].count;
+}
+
+const Polynom& ExpressionEvaluator::keep(Polynom&& p) {
+    kept.push_back(std::move(p));
+    return kept.back();
+}
+
+Polynom ExpressionEvaluator::add(const Polynom& a, const Polynom& b, float sign) {
+    return a.add_scaled(b, sign);
+}
+
+// Kernel selection (naive, heap, hash, dense, Karatsuba, FFT) lives in MultiplyPlanner
+Polynom ExpressionEvaluator::multiply(const Polynom& a, const Polynom& b) {
+    return MultiplyPlanner::multiply(a, b);
+}
+
+Polynom ExpressionEvaluator::product(const Addend& addend) const {
+    if (addend.count == 2) {
+        return MultiplyPlanner::multiply(*factors[addend.first], *factors[addend.first + 1]);
+    }
+    std::vector<Polynom> copies;
+    copies.reserve(addend.count);
+    for (size_t i = 0; i < addend.count; ++i) {
+        copies.push_back(*factors[addend.first + i]);
+    }
+    return Polynom::product(std::move(copies));
+}
+
+// Addends of one polynom each. Sparse operands are merged as sorted streams all at once, summing
+// equal powers in operand order like a chain of binary sums would; a dense operand or just two
+// operands go through add_scaled one at a time.
+Polynom ExpressionEvaluator::sum(const SmallVector<Addend, 8>& terms) const {
+    if (terms.size() == 0) {
+        return Polynom();
+    }
+    const Polynom& first = *factors[terms[0].first];
+    bool dense = false;
+    for (size_t i = 0; i < terms.size(); ++i) {
+        dense = dense || factors[terms[i].first]->dense;
+    }
+    if (terms.size() <= 2 || dense) {
+        Polynom result;
+        if (terms[0].sign < 0.0f) {
+            result = Polynom().add_scaled(first, -1.0f);
+        }
+        else if (terms.size() == 1) {
+            return first;
+        }
+        const Polynom* accumulated = terms[0].sign < 0.0f ? &result : &first;
+        for (size_t i = 1; i < terms.size(); ++i) {
+            result = accumulated->add_scaled(*factors[terms[i].first], terms[i].sign);
+            accumulated = &result;
+        }
+        return result;
+    }
+
+    // Each head caches its sort key (max power, x, y, z); one scan per output term finds the
+    // leading key and every operand that has it
+    struct Head {
+        const PolyTerm* next;
+        const PolyTerm* end;
+        uint64_t high;
+        uint64_t low;
+    };
+    auto advance = [](Head& head) {
+        if (head.next != head.end) {
+            const int* powers = head.next->powers;
+            // Flipping the sign bit orders ints as unsigned
+            auto biased = [](int power) {
+                return static_cast<uint64_t>(static_cast<uint32_t>(power) ^ 0x80000000u);
+            };
+            head.high = biased(std::max(powers[0], std::max(powers[1], powers[2]))) << 32 | biased(powers[0]);
+            head.low = biased(powers[1]) << 32 | biased(powers[2]);
+        }
+    };
+    Polynom result;
+    size_t total = 0;
+    SmallVector<Head, 8> heads;
+    for (size_t i = 0; i < terms.size(); ++i) {
+        const Polynom::TermStorage& operand = factors[terms[i].first]->terms;
+        total += operand.size();
+        heads.push_back({ operand.data(), operand.data() + operand.size(), 0, 0 });
+        advance(heads[i]);
+    }
+    result.terms.reserve(total);
+    SmallVector<size_t, 8> leading;
+    for (;;) {
+        leading.clear();
+        for (size_t i = 0; i < heads.size(); ++i) {
+            if (heads[i].next == heads[i].end) {
+                continue;
+            }
+            const Head& lead = heads[leading.size() == 0 ? i : leading[0]];
+            if (leading.size() == 0 || heads[i].high > lead.high || (heads[i].high == lead.high && heads[i].low > lead.low)) {
+                leading.clear();
+                leading.push_back(i);
+            }
+            else if (heads[i].high == lead.high && heads[i].low == lead.low) {
+                leading.push_back(i);
+            }
+        }
+        if (leading.size() == 0) {
+            break;
+        }
+        PolyTerm merged = *heads[leading[0]].next;
+        merged.ratio = 0.0f;
+        for (size_t i : leading) {
+            merged.ratio += terms[i].sign * heads[i].next->ratio;
+            ++heads[i].next;
+            advance(heads[i]);
+        }
+        if (leading.size() == 1 || std::abs(merged.ratio) > EPSILON) {
+            result.terms.push_back(merged);
+        }
+    }
+    result.refresh();
+    return result;
+}
+
+Polynom ExpressionEvaluator::evaluate() {
+    // The product fused into fma is the first one that is added, not subtracted
+    size_t fused = addends.size();
+    for (size_t i = 0; i < addends.size(); ++i) {
+        if (addends[i].count > 1 && addends[i].sign > 0.0f) {
+            fused = i;
+            break;
+        }
+    }
+    SmallVector<Addend, 8> rest;
+    for (size_t i = 0; i < addends.size(); ++i) {
+        if (i == fused) {
+            continue;
+        }
+        if (addends[i].count == 1) {
+            rest.push_back(addends[i]);
+            continue;
+        }
+        factors.push_back(&keep(product(addends[i])));
+        rest.push_back({ addends[i].sign, factors.size() - 1, 1 });
+    }
+    if (fused == addends.size()) {
+        return sum(rest);
+    }
+    // A single added polynom goes to fma as it is, without a copy
+    Polynom c;
+    const Polynom* addend = &c;
+    if (rest.size() == 1 && rest[0].sign > 0.0f) {
+        addend = factors[rest[0].first];
+    }
+    else {
+        c = sum(rest);
+    }
+
+    const Addend& fused_product = addends[fused];
+    if (fused_product.count == 2) {
+        return Polynom::fma(*factors[fused_product.first], *factors[fused_product.first + 1], *addend);
+    }
+    std::vector<Polynom> copies;
+    copies.reserve(fused_product.count);
+    for (size_t i = 0; i < fused_product.count; ++i) {
+        copies.push_back(*factors[fused_product.first + i]);
+    }
+    return Polynom::fma(std::move(copies), *addend);
+}
@@ -0,0 +1,239 @@
+#pragma once
+
+// Expression templates behind Polynom's +, - and *; included at the end of polynoms.h
+
+#include <array>
+#include <list>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Flattened expression: a signed sum of addends, each the product of one or more polynoms.
+// evaluate() multiplies out every product but one, adds all the rest in one k-way merge of the
+// sorted terms and fuses the remaining product into Polynom::fma with that sum.
+class ExpressionEvaluator {
+public:
+    // Starts the next addend; factor() appends to it
+    void begin(float sign);
+    void factor(const Polynom& p);
+    // Keeps a polynom computed while flattening (a sum used as a factor) alive until evaluate()
+    const Polynom& keep(Polynom&& p);
+    Polynom evaluate();
+
+    static Polynom add(const Polynom& a, const Polynom& b, float sign);
+    static Polynom multiply(const Polynom& a, const Polynom& b);
+
+private:
+    struct Addend {
+        float sign;
+        size_t first;
+        size_t count;
+    };
+
+    SmallVector<Addend, 8> addends;
+    SmallVector<const Polynom*, 16> factors;
+    std::list<Polynom> kept;
+
+    Polynom product(const Addend& addend) const;
+    Polynom sum(const SmallVector<Addend, 8>& terms) const;
+};
+
+// Leaves: an lvalue is referenced, a temporary is moved into the expression. Evaluation reads
+// referenced polynoms only when the expression is assigned or used.
+class PolynomRef {
+public:
+    static constexpr bool LEAF = true;
+
+    explicit PolynomRef(const Polynom& value) : p(value) {}
+
+    const Polynom& get() const { return p; }
+    void collect(ExpressionEvaluator& out, float sign) const {
+        out.begin(sign);
+        out.factor(p);
+    }
+    void collect_factors(ExpressionEvaluator& out) const { out.factor(p); }
+
+private:
+    const Polynom& p;
+};
+
+class PolynomTemporary {
+public:
+    static constexpr bool LEAF = true;
+
+    explicit PolynomTemporary(Polynom value) : p(std::move(value)) {}
+
+    const Polynom& get() const { return p; }
+    void collect(ExpressionEvaluator& out, float sign) const {
+        out.begin(sign);
+        out.factor(p);
+    }
+    void collect_factors(ExpressionEvaluator& out) const { out.factor(p); }
+
+private:
+    Polynom p;
+};
+
+template <typename E>
+class PolynomExpression {
+public:
+    static constexpr bool LEAF = false;
+
+    const E& self() const { return static_cast<const E&>(*this); }
+
+    Polynom evaluate() const {
+        ExpressionEvaluator out;
+        self().collect(out, 1.0f);
+        return out.evaluate();
+    }
+    operator Polynom() const { return self().evaluate(); }
+
+    // The const interface of Polynom, so a result is used like one: (a * b).real_roots().
+    // Each call evaluates the expression; assign it to a Polynom to use it more than once.
+    size_t size() const { return self().evaluate().size(); }
+    bool is_dense() const { return self().evaluate().is_dense(); }
+    int degree() const { return self().evaluate().degree(); }
+    int degree(size_t var) const { return self().evaluate().degree(var); }
+    Monom leading_term() const { return self().evaluate().leading_term(); }
+    uint64_t hash() const { return self().evaluate().hash(); }
+    double evaluate(double x, double y, double z) const { return self().evaluate().evaluate(x, y, z); }
+    bool is_univariate() const { return self().evaluate().is_univariate(); }
+    std::vector<double> evaluate(const std::vector<double>& xs) const { return self().evaluate().evaluate(xs); }
+    std::vector<double> real_roots() const { return self().evaluate().real_roots(); }
+    void evaluate_grid(const std::vector<double>& xs, const std::vector<double>& ys, const std::vector<double>& zs,
+        std::vector<double>& out) const {
+        self().evaluate().evaluate_grid(xs, ys, zs, out);
+    }
+    Polynom derivative(size_t var) const { return self().evaluate().derivative(var); }
+    std::array<Polynom, 3> gradient() const { return self().evaluate().gradient(); }
+    Polynom compose(const Polynom& qx, const Polynom& qy, const Polynom& qz) const {
+        return self().evaluate().compose(qx, qy, qz);
+    }
+    Polynom::Division divide(const Polynom& divisor) const { return self().evaluate().divide(divisor); }
+    std::vector<Polynom> divide(const std::vector<Polynom>& divisors, Polynom& remainder) const {
+        return self().evaluate().divide(divisors, remainder);
+    }
+    Polynom gcd(const Polynom& oth) const { return self().evaluate().gcd(oth); }
+    void format_to(std::string& buffer) const { self().evaluate().format_to(buffer); }
+    void print(std::ostream& os, std::string& buffer) const { self().evaluate().print(os, buffer); }
+    size_t serialized_size() const { return self().evaluate().serialized_size(); }
+    size_t serialize(unsigned char* out, size_t capacity) const { return self().evaluate().serialize(out, capacity); }
+    std::vector<unsigned char> serialize() const { return self().evaluate().serialize(); }
+
+    // A sum used as a factor is evaluated on its own
+    void collect_factors(ExpressionEvaluator& out) const { out.factor(out.keep(self().evaluate())); }
+};
+
+template <typename L, typename R, bool SUBTRACT>
+class PolynomSum : public PolynomExpression<PolynomSum<L, R, SUBTRACT>> {
+public:
+    template <typename A, typename B>
+    PolynomSum(A&& left, B&& right) : l(std::forward<A>(left)), r(std::forward<B>(right)) {}
+
+    using PolynomExpression<PolynomSum>::evaluate;
+    Polynom evaluate() const {
+        if constexpr (L::LEAF && R::LEAF) {
+            return ExpressionEvaluator::add(l.get(), r.get(), SUBTRACT ? -1.0f : 1.0f);
+        }
+        else {
+            return PolynomExpression<PolynomSum>::evaluate();
+        }
+    }
+    void collect(ExpressionEvaluator& out, float sign) const {
+        l.collect(out, sign);
+        r.collect(out, SUBTRACT ? -sign : sign);
+    }
+
+private:
+    L l;
+    R r;
+};
+
+template <typename L, typename R>
+class PolynomProduct : public PolynomExpression<PolynomProduct<L, R>> {
+public:
+    template <typename A, typename B>
+    PolynomProduct(A&& left, B&& right) : l(std::forward<A>(left)), r(std::forward<B>(right)) {}
+
+    using PolynomExpression<PolynomProduct>::evaluate;
+    Polynom evaluate() const {
+        if constexpr (L::LEAF && R::LEAF) {
+            return ExpressionEvaluator::multiply(l.get(), r.get());
+        }
+        else {
+            return PolynomExpression<PolynomProduct>::evaluate();
+        }
+    }
+    void collect(ExpressionEvaluator& out, float sign) const {
+        out.begin(sign);
+        collect_factors(out);
+    }
+    void collect_factors(ExpressionEvaluator& out) const {
+        l.collect_factors(out);
+        r.collect_factors(out);
+    }
+
+private:
+    L l;
+    R r;
+};
+
+template <typename T, typename D = std::decay_t<T>>
+struct ExpressionOperand {
+    static constexpr bool value = std::is_base_of<PolynomExpression<D>, D>::value;
+    using type = D;
+};
+
+template <typename T>
+struct ExpressionOperand<T, Polynom> {
+    static constexpr bool value = true;
+    using type = std::conditional_t<std::is_lvalue_reference<T>::value, PolynomRef, PolynomTemporary>;
+};
+
+template <typename L, typename R>
+using EnableExpression = std::enable_if_t<ExpressionOperand<L>::value && ExpressionOperand<R>::value>;
+
+// a + b, a - b and a * b build an expression evaluated when it is converted to a Polynom, printed
+// or used. Lvalue operands are held by reference: auto e = a + b; reads a and b when e is used, and
+// e must not outlive them. Temporary operands are moved into the expression.
+template <typename L, typename R, typename = EnableExpression<L, R>>
+PolynomSum<typename ExpressionOperand<L>::type, typename ExpressionOperand<R>::type, false> operator+(L&& l, R&& r) {
+    return { std::forward<L>(l), std::forward<R>(r) };
+}
+
+template <typename L, typename R, typename = EnableExpression<L, R>>
+PolynomSum<typename ExpressionOperand<L>::type, typename ExpressionOperand<R>::type, true> operator-(L&& l, R&& r) {
+    return { std::forward<L>(l), std::forward<R>(r) };
+}
+
+template <typename L, typename R, typename = EnableExpression<L, R>>
+PolynomProduct<typename ExpressionOperand<L>::type, typename ExpressionOperand<R>::type> operator*(L&& l, R&& r) {
+    return { std::forward<L>(l), std::forward<R>(r) };
+}
+
+template <typename E>
+std::ostream& operator<<(std::ostream& os, const PolynomExpression<E>& expression) {
+    return os << expression.self().evaluate();
+}
+
+template <typename E>
+Polynom& Polynom::operator+=(const PolynomExpression<E>& expression) {
+    ExpressionEvaluator out;
+    out.begin(1.0f);
+    out.factor(*this);
+    expression.self().collect(out, 1.0f);
+    *this = out.evaluate();
+    return *this;
+}
+
+template <typename E>
+Polynom& Polynom::operator-=(const PolynomExpression<E>& expression) {
+    ExpressionEvaluator out;
+    out.begin(1.0f);
+    out.factor(*this);
+    expression.self().collect(out, -1.0f);
+    *this = out.evaluate();
+    return *this;
+}
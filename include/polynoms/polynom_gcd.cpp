@@ -0,0 +1,457 @@
+#include "polynoms.h"
+#include "polynom_parser.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Exponents = std::array<int, 3>;
+// Lex order: x, then y, then z powers, highest first
+template <typename T>
+using LexPoly = std::map<Exponents, T, std::greater<Exponents>>;
+using IntPoly = LexPoly<int64_t>;
+using ModPoly = LexPoly<uint64_t>;
+// Coefficients in Z_p by ascending power, without trailing zeros; empty for zero
+using Uni = std::vector<uint64_t>;
+
+// Primes below 2^31: a product of two residues fits in 64 bits, and so does a product of two primes
+const uint64_t PRIMES[] = { 2147483647, 2147483629, 2147483587, 2147483579, 2147483563, 2147483549,
+    2147483543, 2147483497, 2147483489, 2147483477, 2147483423, 2147483399 };
+
+const Exponents CONSTANT = { 0, 0, 0 };
+
+uint64_t pow_mod(uint64_t base, uint64_t power, uint64_t p) {
+    uint64_t result = 1;
+    for (; power; power >>= 1) {
+        if (power & 1) {
+            result = result * base % p;
+        }
+        base = base * base % p;
+    }
+    return result;
+}
+
+uint64_t inverse_mod(uint64_t value, uint64_t p) {
+    return pow_mod(value, p - 2, p);
+}
+
+uint64_t to_mod(int64_t value, uint64_t p) {
+    int64_t r = value % static_cast<int64_t>(p);
+    return static_cast<uint64_t>(r < 0 ? r + static_cast<int64_t>(p) : r);
+}
+
+void trim(Uni& a) {
+    while (!a.empty() && a.back() == 0) {
+        a.pop_back();
+    }
+}
+
+int degree(const Uni& a) {
+    return static_cast<int>(a.size()) - 1;
+}
+
+uint64_t evaluate(const Uni& a, uint64_t point, uint64_t p) {
+    uint64_t result = 0;
+    for (size_t i = a.size(); i-- > 0;) {
+        result = (result * point + a[i]) % p;
+    }
+    return result;
+}
+
+Uni multiply(const Uni& a, const Uni& b, uint64_t p) {
+    if (a.empty() || b.empty()) {
+        return {};
+    }
+    Uni result(a.size() + b.size() - 1, 0);
+    for (size_t i = 0; i < a.size(); ++i) {
+        for (size_t j = 0; j < b.size(); ++j) {
+            result[i + j] = (result[i + j] + a[i] * b[j]) % p;
+        }
+    }
+    return result;
+}
+
+// Quotient of rest by divisor; rest is left with the remainder
+Uni divide(Uni& rest, const Uni& divisor, uint64_t p) {
+    if (rest.size() < divisor.size()) {
+        return {};
+    }
+    Uni quotient(rest.size() - divisor.size() + 1, 0);
+    const uint64_t inverse = inverse_mod(divisor.back(), p);
+    for (size_t i = quotient.size(); i-- > 0;) {
+        const uint64_t factor = rest[i + divisor.size() - 1] * inverse % p;
+        quotient[i] = factor;
+        for (size_t j = 0; j < divisor.size(); ++j) {
+            // p * p > factor * divisor[j] and the sum stays below 2^63: one reduction
+            rest[i + j] = (rest[i + j] + p * p - factor * divisor[j]) % p;
+        }
+    }
+    rest.resize(divisor.size() - 1);
+    trim(rest);
+    return quotient;
+}
+
+// Monic gcd by Euclid
+Uni gcd(Uni a, Uni b, uint64_t p) {
+    while (!b.empty()) {
+        divide(a, b, p);
+        std::swap(a, b);
+    }
+    if (!a.empty()) {
+        const uint64_t inverse = inverse_mod(a.back(), p);
+        for (uint64_t& c : a) {
+            c = c * inverse % p;
+        }
+    }
+    return a;
+}
+
+// a as coefficients in var, keyed by the powers of the other vars
+LexPoly<Uni> split(const ModPoly& a, size_t var) {
+    LexPoly<Uni> result;
+    for (const auto& term : a) {
+        Exponents key = term.first;
+        const size_t power = static_cast<size_t>(key[var]);
+        key[var] = 0;
+        Uni& coeffs = result[key];
+        if (coeffs.size() <= power) {
+            coeffs.resize(power + 1, 0);
+        }
+        coeffs[power] = term.second;
+    }
+    return result;
+}
+
+ModPoly join(const LexPoly<Uni>& a, size_t var) {
+    ModPoly result;
+    for (const auto& entry : a) {
+        Exponents key = entry.first;
+        for (size_t power = 0; power < entry.second.size(); ++power) {
+            if (entry.second[power] != 0) {
+                key[var] = static_cast<int>(power);
+                result.emplace(key, entry.second[power]);
+            }
+        }
+    }
+    return result;
+}
+
+Uni content(const LexPoly<Uni>& a, uint64_t p) {
+    Uni result;
+    for (const auto& entry : a) {
+        result = gcd(result, entry.second, p);
+        if (result.size() == 1) {
+            break;
+        }
+    }
+    return result;
+}
+
+void divide_content(LexPoly<Uni>& a, const Uni& divisor, uint64_t p) {
+    if (divisor.size() == 1) {
+        return;
+    }
+    for (auto& entry : a) {
+        entry.second = divide(entry.second, divisor, p);
+    }
+}
+
+ModPoly monic(ModPoly a, uint64_t p) {
+    if (!a.empty()) {
+        const uint64_t inverse = inverse_mod(a.begin()->second, p);
+        for (auto& term : a) {
+            term.second = term.second * inverse % p;
+        }
+    }
+    return a;
+}
+
+// Monic gcd over Z_p of polynoms in the first vars variables (Brown): the last one is evaluated at
+// points where neither leading coefficient vanishes, the images come from the recursion, and their
+// coefficients are interpolated back in that var up to the degree bound of the scaled gcd
+ModPoly gcd(const ModPoly& a, const ModPoly& b, size_t vars, uint64_t p) {
+    if (a.empty() || b.empty()) {
+        return monic(a.empty() ? b : a, p);
+    }
+    if (vars == 1) {
+        LexPoly<Uni> result;
+        result.emplace(CONSTANT, gcd(split(a, 0).begin()->second, split(b, 0).begin()->second, p));
+        return join(result, 0);
+    }
+
+    const size_t var = vars - 1;
+    auto uses_var = [var](const ModPoly& poly) {
+        return std::any_of(poly.begin(), poly.end(), [var](const ModPoly::value_type& term) { return term.first[var] != 0; });
+    };
+    if (!uses_var(a) && !uses_var(b)) {
+        return gcd(a, b, var, p);
+    }
+    LexPoly<Uni> split_a = split(a, var);
+    LexPoly<Uni> split_b = split(b, var);
+    const Uni content_a = content(split_a, p);
+    const Uni content_b = content(split_b, p);
+    const Uni common_content = gcd(content_a, content_b, p);
+    divide_content(split_a, content_a, p);
+    divide_content(split_b, content_b, p);
+
+    const Uni& lead_a = split_a.begin()->second;
+    const Uni& lead_b = split_b.begin()->second;
+    const Uni lead_gcd = gcd(lead_a, lead_b, p);
+    auto max_degree = [](const LexPoly<Uni>& poly) {
+        int result = 0;
+        for (const auto& entry : poly) {
+            result = std::max(result, degree(entry.second));
+        }
+        return result;
+    };
+    const int bound = degree(lead_gcd) + std::min(max_degree(split_a), max_degree(split_b));
+    auto image_at = [p](const LexPoly<Uni>& poly, uint64_t point) {
+        ModPoly result;
+        for (const auto& entry : poly) {
+            uint64_t value = evaluate(entry.second, point, p);
+            if (value != 0) {
+                result.emplace(entry.first, value);
+            }
+        }
+        return result;
+    };
+
+    // Newton interpolation: after each point, result is right at all points used so far
+    LexPoly<Uni> result;
+    Uni modulus = { 1 };
+    Exponents lead = CONSTANT;
+    int points = 0;
+    for (uint64_t point = 1; points <= bound; ++point) {
+        if (point == p) {
+            throw std::out_of_range("Polynom::gcd: out of evaluation points");
+        }
+        if (evaluate(lead_a, point, p) == 0 || evaluate(lead_b, point, p) == 0) {
+            continue;
+        }
+        const ModPoly image = gcd(image_at(split_a, point), image_at(split_b, point), var, p);
+        const Exponents image_lead = image.begin()->first;
+        if (image_lead == CONSTANT) {
+            // the primitive parts are coprime
+            result.clear();
+            result.emplace(CONSTANT, Uni{ 1 });
+            break;
+        }
+        if (points == 0 || image_lead < lead) {
+            result.clear();
+            modulus = { 1 };
+            lead = image_lead;
+            points = 0;
+        }
+        else if (image_lead > lead) {
+            // unlucky point: the image has a common factor the gcd lacks
+            continue;
+        }
+        const uint64_t scale = evaluate(lead_gcd, point, p);
+        const uint64_t inverse = inverse_mod(evaluate(modulus, point, p), p);
+        for (const auto& term : image) {
+            result[term.first];
+        }
+        for (auto it = result.begin(); it != result.end();) {
+            auto found = image.find(it->first);
+            const uint64_t target = found == image.end() ? 0 : found->second * scale % p;
+            const uint64_t delta = (target + p - evaluate(it->second, point, p)) % p * inverse % p;
+            if (delta != 0) {
+                Uni step = multiply(modulus, { delta }, p);
+                it->second.resize(std::max(it->second.size(), step.size()), 0);
+                for (size_t i = 0; i < step.size(); ++i) {
+                    it->second[i] = (it->second[i] + step[i]) % p;
+                }
+                trim(it->second);
+            }
+            it = it->second.empty() ? result.erase(it) : std::next(it);
+        }
+        modulus = multiply(modulus, { p - point, 1 }, p);
+        ++points;
+    }
+
+    divide_content(result, content(result, p), p);
+    for (auto& entry : result) {
+        entry.second = multiply(entry.second, common_content, p);
+    }
+    return monic(join(result, var), p);
+}
+
+// Floats are dyadic, so the terms are a power of two times ones with integer coefficients
+IntPoly to_integers(const std::vector<std::pair<Exponents, float>>& terms) {
+    int shift = 0;
+    for (const auto& term : terms) {
+        if (term.first[0] < 0 || term.first[1] < 0 || term.first[2] < 0) {
+            throw std::invalid_argument("Polynom::gcd: negative powers");
+        }
+        int exponent;
+        std::frexp(term.second, &exponent);
+        shift = std::max(shift, std::numeric_limits<float>::digits - exponent);
+    }
+    IntPoly result;
+    for (const auto& term : terms) {
+        const double scaled = std::ldexp(static_cast<double>(term.second), shift);
+        if (std::abs(scaled) >= 0x1p62) {
+            throw std::out_of_range("Polynom::gcd: coefficients do not fit 64 bits");
+        }
+        result.emplace(term.first, static_cast<int64_t>(scaled));
+    }
+    return result;
+}
+
+int64_t gcd(int64_t a, int64_t b) {
+    a = std::abs(a);
+    b = std::abs(b);
+    while (b != 0) {
+        a %= b;
+        std::swap(a, b);
+    }
+    return a;
+}
+
+// Divides out the integer content and makes the leading coefficient positive
+void make_primitive(IntPoly& a) {
+    if (a.empty()) {
+        return;
+    }
+    int64_t content = 0;
+    for (const auto& term : a) {
+        content = gcd(content, term.second);
+    }
+    if (a.begin()->second < 0) {
+        content = -content;
+    }
+    for (auto& term : a) {
+        term.second /= content;
+    }
+}
+
+// Exact division over the integers in lex order; false on a remainder or an overflow
+bool divides(const IntPoly& divisor, IntPoly rest) {
+    const Exponents& lead = divisor.begin()->first;
+    const int64_t lead_ratio = divisor.begin()->second;
+    while (!rest.empty()) {
+        const auto top = rest.begin();
+        Exponents shift;
+        for (size_t var = 0; var < 3; ++var) {
+            shift[var] = top->first[var] - lead[var];
+            if (shift[var] < 0) {
+                return false;
+            }
+        }
+        if (top->second % lead_ratio != 0) {
+            return false;
+        }
+        const int64_t factor = top->second / lead_ratio;
+        for (const auto& term : divisor) {
+            const Exponents key = { term.first[0] + shift[0], term.first[1] + shift[1], term.first[2] + shift[2] };
+            int64_t& value = rest[key];
+            if (std::abs(term.second) > std::numeric_limits<int64_t>::max() / 2 / std::abs(factor) ||
+                std::abs(value) > std::numeric_limits<int64_t>::max() / 2) {
+                return false;
+            }
+            value -= factor * term.second;
+            if (value == 0) {
+                rest.erase(key);
+            }
+        }
+    }
+    return true;
+}
+
+Polynom from_integers(const IntPoly& a) {
+    PolynomBuilder builder;
+    for (const auto& term : a) {
+        builder.add(static_cast<float>(term.second), term.first[0], term.first[1], term.first[2]);
+    }
+    return builder.build();
+}
+
+}
+
+Polynom Polynom::gcd(const Polynom& oth) const {
+    auto integers = [](const Polynom& poly) {
+        std::vector<std::pair<Exponents, float>> terms;
+        poly.for_each_term_unordered([&terms](float ratio, const int* powers) {
+            terms.emplace_back(Exponents{ powers[0], powers[1], powers[2] }, ratio);
+        });
+        return to_integers(terms);
+    };
+    IntPoly a = integers(*this);
+    IntPoly b = integers(oth);
+    make_primitive(a);
+    make_primitive(b);
+    if (a.empty() || b.empty()) {
+        return from_integers(a.empty() ? b : a);
+    }
+
+    // Images mod p, scaled to the gcd of the leading coefficients, are combined by the Chinese
+    // remainder theorem in the symmetric range until the primitive part divides both polynoms
+    const int64_t lead_gcd = ::gcd(a.begin()->second, b.begin()->second);
+    IntPoly result;
+    Exponents lead = CONSTANT;
+    int64_t modulus = 0;
+    for (uint64_t p : PRIMES) {
+        if (to_mod(a.begin()->second, p) == 0 || to_mod(b.begin()->second, p) == 0) {
+            continue;
+        }
+        auto reduce = [p](const IntPoly& poly) {
+            ModPoly reduced;
+            for (const auto& term : poly) {
+                uint64_t value = to_mod(term.second, p);
+                if (value != 0) {
+                    reduced.emplace(term.first, value);
+                }
+            }
+            return reduced;
+        };
+        const ModPoly image = ::gcd(reduce(a), reduce(b), 3, p);
+        const Exponents image_lead = image.begin()->first;
+        if (image_lead == CONSTANT) {
+            return from_integers(IntPoly{ { CONSTANT, 1 } });
+        }
+        if (modulus != 0 && image_lead > lead) {
+            continue;
+        }
+        if (modulus == 0 || image_lead < lead || modulus > std::numeric_limits<int64_t>::max() / static_cast<int64_t>(p)) {
+            result.clear();
+            modulus = 1;
+            lead = image_lead;
+        }
+
+        const uint64_t scale = to_mod(lead_gcd, p);
+        const uint64_t inverse = inverse_mod(to_mod(modulus, p), p);
+        const int64_t combined = modulus * static_cast<int64_t>(p);
+        for (const auto& term : image) {
+            result[term.first];
+        }
+        for (auto it = result.begin(); it != result.end();) {
+            auto found = image.find(it->first);
+            const uint64_t target = found == image.end() ? 0 : found->second * scale % p;
+            const int64_t known = it->second < 0 ? it->second + modulus : it->second;
+            const uint64_t step = (target + p - to_mod(known, p)) % p * inverse % p;
+            int64_t value = known + modulus * static_cast<int64_t>(step);
+            if (value > combined / 2) {
+                value -= combined;
+            }
+            it->second = value;
+            it = value == 0 ? result.erase(it) : std::next(it);
+        }
+        modulus = combined;
+
+        IntPoly candidate = result;
+        make_primitive(candidate);
+        if (divides(candidate, a) && divides(candidate, b)) {
+            return from_integers(candidate);
+        }
+    }
+    throw std::out_of_range("Polynom::gcd: coefficients do not fit 64 bits");
+}
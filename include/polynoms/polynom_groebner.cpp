@@ -0,0 +1,427 @@
+#include "polynom_groebner.h"
+#include "polynom_parser.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <map>
+#include <set>
+#include <stdexcept>
+
+const uint32_t GroebnerBasis::PRIME;
+
+namespace {
+
+using Exponents = std::array<int, 3>;
+using Row = std::vector<std::pair<Exponents, uint32_t>>;
+
+const uint64_t P = GroebnerBasis::PRIME;
+
+uint64_t pow_mod(uint64_t base, uint64_t power) {
+    uint64_t result = 1;
+    for (; power; power >>= 1) {
+        if (power & 1) {
+            result = result * base % P;
+        }
+        base = base * base % P;
+    }
+    return result;
+}
+
+uint64_t inverse_mod(uint64_t value) {
+    return pow_mod(value, P - 2);
+}
+
+int total(const Exponents& e) {
+    return e[0] + e[1] + e[2];
+}
+
+// Graded reverse lex: higher total degree first, then the lower power of z, then of y
+struct GrevlexGreater {
+    bool operator()(const Exponents& a, const Exponents& b) const {
+        if (total(a) != total(b)) {
+            return total(a) > total(b);
+        }
+        if (a[2] != b[2]) {
+            return a[2] < b[2];
+        }
+        return a[1] < b[1];
+    }
+};
+
+bool divides(const Exponents& a, const Exponents& b) {
+    return a[0] <= b[0] && a[1] <= b[1] && a[2] <= b[2];
+}
+
+bool coprime(const Exponents& a, const Exponents& b) {
+    return !(a[0] && b[0]) && !(a[1] && b[1]) && !(a[2] && b[2]);
+}
+
+Exponents lcm(const Exponents& a, const Exponents& b) {
+    return { std::max(a[0], b[0]), std::max(a[1], b[1]), std::max(a[2], b[2]) };
+}
+
+Exponents quotient(const Exponents& a, const Exponents& b) {
+    return { a[0] - b[0], a[1] - b[1], a[2] - b[2] };
+}
+
+Exponents product(const Exponents& a, const Exponents& b) {
+    return { a[0] + b[0], a[1] + b[1], a[2] + b[2] };
+}
+
+const Exponents& lead(const Row& row) {
+    return row.front().first;
+}
+
+void make_monic(Row& row) {
+    const uint64_t inverse = inverse_mod(row.front().second);
+    for (auto& term : row) {
+        term.second = static_cast<uint32_t>(term.second * inverse % P);
+    }
+}
+
+// ratio = mantissa * 2^(exponent - digits) exactly, and 2 is invertible mod P
+uint32_t to_field(float ratio) {
+    int exponent;
+    const float mantissa = std::frexp(ratio, &exponent);
+    const int64_t scaled = static_cast<int64_t>(std::ldexp(mantissa, std::numeric_limits<float>::digits));
+    const int shift = exponent - std::numeric_limits<float>::digits;
+    const uint64_t two = shift >= 0 ? 2 : (P + 1) / 2;
+    const uint64_t residue = static_cast<uint64_t>(scaled % static_cast<int64_t>(P) + static_cast<int64_t>(P)) % P;
+    return static_cast<uint32_t>(residue * pow_mod(two, static_cast<uint64_t>(std::abs(shift))) % P);
+}
+
+// Rational reconstruction: the extended Euclid remainder sequence of (P, value) yields
+// r = t * value mod P; the first r below the bound gives the smallest such fraction
+float to_ratio(uint32_t value) {
+    const int64_t bound = 32767;
+    int64_t r0 = static_cast<int64_t>(P);
+    int64_t r1 = value;
+    int64_t t0 = 0;
+    int64_t t1 = 1;
+    while (r1 > bound) {
+        const int64_t q = r0 / r1;
+        std::swap(r0, r1);
+        r1 -= q * r0;
+        std::swap(t0, t1);
+        t1 -= q * t0;
+    }
+    if (std::llabs(t1) <= bound) {
+        int64_t a = r1;
+        int64_t b = t1;
+        while (b != 0) {
+            a %= b;
+            std::swap(a, b);
+        }
+        if (std::llabs(a) == 1) {
+            return static_cast<float>(static_cast<double>(r1) / static_cast<double>(t1));
+        }
+    }
+    return static_cast<float>(value > P / 2 ? static_cast<int64_t>(value) - static_cast<int64_t>(P) : value);
+}
+
+// Index of the basis polynom (other than skip) whose leading monom divides e, or basis.size()
+size_t find_reducer(const std::vector<Row>& basis, const std::vector<char>& active, const Exponents& e,
+    size_t skip) {
+    size_t best = basis.size();
+    for (size_t g = 0; g < basis.size(); ++g) {
+        if (g != skip && active[g] && divides(lead(basis[g]), e) &&
+            (best == basis.size() || basis[g].size() < basis[best].size())) {
+            best = g;
+        }
+    }
+    return best;
+}
+
+struct Pair {
+    size_t first;
+    size_t second;
+    Exponents lcm;
+};
+
+// Gebauer-Moeller update for the new basis polynom h: of its pairs with the active basis only those
+// whose lcm no other new pair's lcm divides survive, then those with coprime leading monoms
+// (Buchberger's product criterion) go; old pairs whose lcm lead(h) divides properly go by the chain
+// criterion; basis polynoms whose leading monom lead(h) divides leave the active set.
+void update(std::vector<Pair>& pairs, const std::vector<Row>& basis, std::vector<char>& active, size_t h) {
+    const Exponents& h_lead = lead(basis[h]);
+    std::vector<Pair> candidates;
+    for (size_t g = 0; g < h; ++g) {
+        if (active[g]) {
+            candidates.push_back({ g, h, lcm(lead(basis[g]), h_lead) });
+        }
+    }
+    std::vector<Pair> kept;
+    for (size_t k = 0; k < candidates.size(); ++k) {
+        const Pair& pair = candidates[k];
+        bool keep = coprime(lead(basis[pair.first]), h_lead);
+        if (!keep) {
+            auto covers = [&pair](const Pair& other) { return divides(other.lcm, pair.lcm); };
+            keep = std::none_of(candidates.begin() + k + 1, candidates.end(), covers) &&
+                std::none_of(kept.begin(), kept.end(), covers);
+        }
+        if (keep) {
+            kept.push_back(pair);
+        }
+    }
+    kept.erase(std::remove_if(kept.begin(), kept.end(), [&](const Pair& pair) {
+        return coprime(lead(basis[pair.first]), h_lead);
+    }), kept.end());
+
+    pairs.erase(std::remove_if(pairs.begin(), pairs.end(), [&](const Pair& pair) {
+        return divides(h_lead, pair.lcm) && lcm(lead(basis[pair.first]), h_lead) != pair.lcm &&
+            lcm(lead(basis[pair.second]), h_lead) != pair.lcm;
+    }), pairs.end());
+    pairs.insert(pairs.end(), kept.begin(), kept.end());
+
+    for (size_t g = 0; g < h; ++g) {
+        if (active[g] && divides(h_lead, lead(basis[g]))) {
+            active[g] = 0;
+        }
+    }
+    active[h] = 1;
+}
+
+// One F4 step: the rows are monom multiples of basis polynoms; returns the echelon rows whose leading
+// monoms are not leading monoms of any input row
+std::vector<Row> reduce_pairs(const std::vector<Pair>& selected, const std::vector<Row>& basis,
+    const std::vector<char>& active) {
+    // (multiplier, basis index), each multiple once
+    std::set<std::pair<Exponents, size_t>> multiples;
+    std::set<Exponents, GrevlexGreater> pair_leads;
+    for (const Pair& pair : selected) {
+        multiples.emplace(quotient(pair.lcm, lead(basis[pair.first])), pair.first);
+        multiples.emplace(quotient(pair.lcm, lead(basis[pair.second])), pair.second);
+        pair_leads.insert(pair.lcm);
+    }
+    std::vector<std::pair<Exponents, size_t>> rows(multiples.begin(), multiples.end());
+
+    // Symbolic preprocessing: every monom that a basis leading monom divides gets one reducer row,
+    // unless it already leads a row
+    std::set<Exponents, GrevlexGreater> monoms;
+    std::set<Exponents, GrevlexGreater> done(pair_leads);
+    std::vector<Exponents> pending;
+    const size_t pair_rows_count = rows.size();
+    auto collect = [&](const std::pair<Exponents, size_t>& row) {
+        for (const auto& term : basis[row.second]) {
+            const Exponents monom = product(row.first, term.first);
+            if (monoms.insert(monom).second && !done.count(monom)) {
+                pending.push_back(monom);
+            }
+        }
+    };
+    for (const auto& row : rows) {
+        collect(row);
+    }
+    while (!pending.empty()) {
+        const Exponents monom = pending.back();
+        pending.pop_back();
+        if (!done.insert(monom).second) {
+            continue;
+        }
+        const size_t g = find_reducer(basis, active, monom, basis.size());
+        if (g != basis.size()) {
+            rows.emplace_back(quotient(monom, lead(basis[g])), g);
+            collect(rows.back());
+        }
+    }
+
+    std::map<Exponents, uint32_t, GrevlexGreater> columns;
+    for (const Exponents& monom : monoms) {
+        columns.emplace_hint(columns.end(), monom, static_cast<uint32_t>(columns.size()));
+    }
+    std::vector<Exponents> column_monoms(monoms.begin(), monoms.end());
+    auto sparse_row = [&](const std::pair<Exponents, size_t>& row) {
+        std::vector<std::pair<uint32_t, uint32_t>> entries;
+        entries.reserve(basis[row.second].size());
+        for (const auto& term : basis[row.second]) {
+            entries.emplace_back(columns[product(row.first, term.first)], term.second);
+        }
+        return entries;
+    };
+
+    // Reducer rows are monic and lead distinct columns, so they are pivots as they are; the pair
+    // rows are then reduced against all pivots in one dense pass each, from the leftmost column on
+    std::vector<std::vector<std::pair<uint32_t, uint32_t>>> pivots(columns.size());
+    for (size_t r = pair_rows_count; r < rows.size(); ++r) {
+        std::vector<std::pair<uint32_t, uint32_t>> entries = sparse_row(rows[r]);
+        const uint32_t column = entries.front().first;
+        pivots[column] = std::move(entries);
+    }
+    std::vector<std::vector<std::pair<uint32_t, uint32_t>>> pair_rows;
+    for (size_t r = 0; r < pair_rows_count; ++r) {
+        pair_rows.push_back(sparse_row(rows[r]));
+    }
+    std::sort(pair_rows.begin(), pair_rows.end(), [](const auto& a, const auto& b) {
+        return a.front().first < b.front().first;
+    });
+
+    std::vector<Row> result;
+    std::vector<uint64_t> dense(columns.size());
+    for (const auto& entries : pair_rows) {
+        std::fill(dense.begin() + entries.front().first, dense.end(), 0);
+        for (const auto& entry : entries) {
+            dense[entry.first] = entry.second;
+        }
+        uint32_t leading = static_cast<uint32_t>(columns.size());
+        for (uint32_t column = entries.front().first; column < columns.size(); ++column) {
+            if (dense[column] == 0) {
+                continue;
+            }
+            if (pivots[column].empty()) {
+                leading = std::min(leading, column);
+                continue;
+            }
+            const uint64_t factor = dense[column];
+            for (const auto& entry : pivots[column]) {
+                dense[entry.first] = (dense[entry.first] + P - factor * entry.second % P) % P;
+            }
+        }
+        if (leading == columns.size()) {
+            continue;
+        }
+        const uint64_t inverse = inverse_mod(dense[leading]);
+        std::vector<std::pair<uint32_t, uint32_t>> pivot;
+        Row row;
+        for (uint32_t column = leading; column < columns.size(); ++column) {
+            if (dense[column] != 0) {
+                const uint32_t value = static_cast<uint32_t>(dense[column] * inverse % P);
+                pivot.emplace_back(column, value);
+                row.emplace_back(column_monoms[column], value);
+            }
+        }
+        pivots[leading] = std::move(pivot);
+        if (!pair_leads.count(column_monoms[leading])) {
+            result.push_back(std::move(row));
+        }
+    }
+    return result;
+}
+
+}
+
+GroebnerBasis::Row GroebnerBasis::from_polynom(const Polynom& p) {
+    Row row;
+    p.for_each_term_unordered([&row](float ratio, const int* powers) {
+        if (powers[0] < 0 || powers[1] < 0 || powers[2] < 0) {
+            throw std::invalid_argument("GroebnerBasis: negative powers");
+        }
+        const uint32_t value = to_field(ratio);
+        if (value != 0) {
+            row.emplace_back(Exponents{ powers[0], powers[1], powers[2] }, value);
+        }
+    });
+    std::sort(row.begin(), row.end(), [](const auto& a, const auto& b) { return GrevlexGreater()(a.first, b.first); });
+    return row;
+}
+
+Polynom GroebnerBasis::to_polynom(const Row& row) {
+    PolynomBuilder builder;
+    builder.reserve(row.size());
+    for (const auto& term : row) {
+        builder.add(to_ratio(term.second), term.first[0], term.first[1], term.first[2]);
+    }
+    return builder.build();
+}
+
+GroebnerBasis::GroebnerBasis(const std::vector<Polynom>& generators) {
+    std::vector<Row> rows;
+    std::vector<char> active;
+    std::vector<Pair> pairs;
+    auto add = [&](Row row) {
+        make_monic(row);
+        rows.push_back(std::move(row));
+        active.push_back(0);
+        update(pairs, rows, active, rows.size() - 1);
+    };
+    for (const Polynom& generator : generators) {
+        Row row = from_polynom(generator);
+        if (!row.empty()) {
+            add(std::move(row));
+        }
+    }
+
+    // Normal strategy: all pairs of the lowest lcm degree go into one matrix
+    while (!pairs.empty()) {
+        int degree = total(pairs.front().lcm);
+        for (const Pair& pair : pairs) {
+            degree = std::min(degree, total(pair.lcm));
+        }
+        auto split = std::partition(pairs.begin(), pairs.end(), [degree](const Pair& pair) {
+            return total(pair.lcm) != degree;
+        });
+        std::vector<Pair> selected(split, pairs.end());
+        pairs.erase(split, pairs.end());
+        for (Row& row : reduce_pairs(selected, rows, active)) {
+            add(std::move(row));
+        }
+    }
+
+    // Reduced basis: keep the active polynoms whose leading monoms no other one divides (a generator
+    // may still have a multiple of an earlier one's), then reduce their tails by the others
+    for (size_t g = 0; g < rows.size(); ++g) {
+        bool minimal = active[g];
+        for (size_t f = 0; f < rows.size() && minimal; ++f) {
+            minimal = f == g || !active[f] || !divides(lead(rows[f]), lead(rows[g])) ||
+                (lead(rows[f]) == lead(rows[g]) && f > g);
+        }
+        if (minimal) {
+            basis.push_back(rows[g]);
+        }
+    }
+    std::sort(basis.begin(), basis.end(), [](const Row& a, const Row& b) { return GrevlexGreater()(lead(b), lead(a)); });
+    for (size_t g = 0; g < basis.size(); ++g) {
+        basis[g] = normal_form(basis[g], g);
+    }
+}
+
+size_t GroebnerBasis::size() const {
+    return basis.size();
+}
+
+GroebnerBasis::Row GroebnerBasis::normal_form(const Row& row, size_t skip) const {
+    std::map<Exponents, uint64_t, GrevlexGreater> work;
+    for (const auto& term : row) {
+        work.emplace_hint(work.end(), term.first, term.second);
+    }
+    const std::vector<char> active(basis.size(), 1);
+    Row rest;
+    while (!work.empty()) {
+        const auto top = work.begin();
+        const size_t g = find_reducer(basis, active, top->first, skip);
+        if (g == basis.size()) {
+            rest.emplace_back(top->first, static_cast<uint32_t>(top->second));
+            work.erase(top);
+            continue;
+        }
+        const uint64_t factor = top->second;
+        const Exponents shift = quotient(top->first, lead(basis[g]));
+        work.erase(top);
+        for (size_t t = 1; t < basis[g].size(); ++t) {
+            const Exponents key = product(basis[g][t].first, shift);
+            uint64_t& value = work[key];
+            value = (value + P - factor * basis[g][t].second % P) % P;
+            if (value == 0) {
+                work.erase(key);
+            }
+        }
+    }
+    return rest;
+}
+
+std::vector<Polynom> GroebnerBasis::polynoms() const {
+    std::vector<Polynom> result;
+    result.reserve(basis.size());
+    for (const Row& row : basis) {
+        result.push_back(to_polynom(row));
+    }
+    return result;
+}
+
+Polynom GroebnerBasis::reduce(const Polynom& p) const {
+    return to_polynom(normal_form(from_polynom(p), basis.size()));
+}
+
+bool GroebnerBasis::contains(const Polynom& p) const {
+    return normal_form(from_polynom(p), basis.size()).empty();
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "polynoms.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Reduced Groebner basis of the ideal spanned by some polynoms, over the prime field Z_p with
+// p = PRIME and in graded reverse lex order (total degree, then the lower power of z, then of y).
+// Float ratios are dyadic, so each maps exactly into Z_p. The basis is built F4-style: all critical
+// pairs of the lowest degree are reduced together as rows of one sparse Macaulay matrix, after
+// symbolic preprocessing adds a multiple of a basis polynom for every reducible monom, and the
+// Gebauer-Moeller criteria drop pairs that would reduce to zero.
+class GroebnerBasis {
+public:
+    static const uint32_t PRIME = 2147483647u;
+
+    GroebnerBasis() = default;
+    // Throws std::invalid_argument for negative powers
+    explicit GroebnerBasis(const std::vector<Polynom>& generators);
+
+    size_t size() const;
+    // Basis polynoms by ascending leading monom. Each ratio comes back as the fraction a / b with
+    // |a|, |b| < 2^15 it equals mod PRIME, or as the residue in (-PRIME / 2, PRIME / 2) if none does.
+    std::vector<Polynom> polynoms() const;
+    // Normal form of p: what is left after reducing every term by the basis, with ratios mapped back
+    // as in polynoms()
+    Polynom reduce(const Polynom& p) const;
+    // Ideal membership modulo PRIME: the normal form of p is zero in Z_p. Exact over Z_p only; over
+    // the rationals a nonzero normal form can vanish mod PRIME, so a true result may be spurious
+    bool contains(const Polynom& p) const;
+
+private:
+    // (powers, ratio) terms by descending graded reverse lex order; basis polynoms are monic
+    using Row = std::vector<std::pair<std::array<int, 3>, uint32_t>>;
+
+    std::vector<Row> basis;
+
+    static Row from_polynom(const Polynom& p);
+    static Polynom to_polynom(const Row& row);
+    // Full reduction of row by all basis polynoms except skip
+    Row normal_form(const Row& row, size_t skip) const;
+};
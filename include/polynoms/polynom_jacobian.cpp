@@ -0,0 +1,118 @@
+#include "polynom_jacobian.h"
+#include <algorithm>
+#include <cmath>
+
+const size_t JacobianEvaluator::BATCH;
+
+static uint32_t power_row(const std::vector<int>& powers, int power) {
+    return static_cast<uint32_t>(std::lower_bound(powers.begin(), powers.end(), power) - powers.begin());
+}
+
+JacobianEvaluator::JacobianEvaluator(const std::vector<Polynom>& polynoms) {
+    for (const Polynom& p : polynoms) {
+        p.for_each_term_unordered([this](float, const int* term_powers) {
+            for (size_t var = 0; var < 3; ++var) {
+                powers[var].push_back(term_powers[var]);
+                if (term_powers[var] != 0) {
+                    powers[var].push_back(term_powers[var] - 1);
+                }
+            }
+        });
+    }
+    for (size_t var = 0; var < 3; ++var) {
+        std::sort(powers[var].begin(), powers[var].end());
+        powers[var].erase(std::unique(powers[var].begin(), powers[var].end()), powers[var].end());
+        tables[var].resize(powers[var].size() * BATCH);
+    }
+
+    for (const Polynom& p : polynoms) {
+        p.for_each_term_unordered([this](float ratio, const int* term_powers) {
+            Term term;
+            term.ratio = ratio;
+            for (size_t var = 0; var < 3; ++var) {
+                term.power[var] = term_powers[var];
+                term.row[var] = power_row(powers[var], term_powers[var]);
+                term.lower_row[var] = term_powers[var] != 0 ? power_row(powers[var], term_powers[var] - 1) : term.row[var];
+            }
+            terms.push_back(term);
+        });
+        offsets.push_back(terms.size());
+    }
+}
+
+size_t JacobianEvaluator::size() const {
+    return offsets.size() - 1;
+}
+
+// Runs the batch loops over LANES points: BATCH for arrays of points, 1 for a single point
+template <size_t LANES>
+void JacobianEvaluator::evaluate_lanes(const double* xs, const double* ys, const double* zs, size_t length,
+    size_t count, double* values, double* jacobian) {
+    const double* coords[3] = { xs, ys, zs };
+    for (size_t var = 0; var < 3; ++var) {
+        double point[LANES];
+        for (size_t k = 0; k < LANES; ++k) {
+            point[k] = k < length ? coords[var][k] : 1.0;
+        }
+        const std::vector<int>& axis = powers[var];
+        double* table = tables[var].data();
+        // consecutive nonnegative powers cost one multiplication each; chains through negative
+        // powers would turn the infinities at 0 into NaN
+        for (size_t row = 0; row < axis.size(); ++row) {
+            double* current = table + row * BATCH;
+            if (row > 0 && axis[row - 1] >= 0 && axis[row] == axis[row - 1] + 1) {
+                const double* previous = current - BATCH;
+                for (size_t k = 0; k < LANES; ++k) {
+                    current[k] = previous[k] * point[k];
+                }
+            }
+            else {
+                for (size_t k = 0; k < LANES; ++k) {
+                    current[k] = std::pow(point[k], axis[row]);
+                }
+            }
+        }
+    }
+
+    for (size_t p = 0; p < size(); ++p) {
+        double value[LANES] = {};
+        double dx[LANES] = {};
+        double dy[LANES] = {};
+        double dz[LANES] = {};
+        for (size_t t = offsets[p]; t < offsets[p + 1]; ++t) {
+            const Term& term = terms[t];
+            const double* x = tables[0].data() + term.row[0] * BATCH;
+            const double* y = tables[1].data() + term.row[1] * BATCH;
+            const double* z = tables[2].data() + term.row[2] * BATCH;
+            const double* x_lower = tables[0].data() + term.lower_row[0] * BATCH;
+            const double* y_lower = tables[1].data() + term.lower_row[1] * BATCH;
+            const double* z_lower = tables[2].data() + term.lower_row[2] * BATCH;
+            const double rx = term.ratio * term.power[0];
+            const double ry = term.ratio * term.power[1];
+            const double rz = term.ratio * term.power[2];
+            for (size_t k = 0; k < LANES; ++k) {
+                const double yz = y[k] * z[k];
+                value[k] += term.ratio * x[k] * yz;
+                dx[k] += rx * x_lower[k] * yz;
+                dy[k] += ry * x[k] * y_lower[k] * z[k];
+                dz[k] += rz * x[k] * y[k] * z_lower[k];
+            }
+        }
+        std::copy(value, value + length, values + p * count);
+        std::copy(dx, dx + length, jacobian + (p * 3) * count);
+        std::copy(dy, dy + length, jacobian + (p * 3 + 1) * count);
+        std::copy(dz, dz + length, jacobian + (p * 3 + 2) * count);
+    }
+}
+
+void JacobianEvaluator::evaluate(const double* xs, const double* ys, const double* zs, size_t count, double* values,
+    double* jacobian) {
+    for (size_t start = 0; start < count; start += BATCH) {
+        evaluate_lanes<BATCH>(xs + start, ys + start, zs + start, std::min(BATCH, count - start), count,
+            values + start, jacobian + start);
+    }
+}
+
+void JacobianEvaluator::evaluate(double x, double y, double z, double* values, double* jacobian) {
+    evaluate_lanes<1>(&x, &y, &z, 1, 1, values, jacobian);
+}
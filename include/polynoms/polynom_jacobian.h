@@ -0,0 +1,46 @@
+#pragma once
+
+#include "polynoms.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Values and first partial derivatives of several polynoms at the same points. Every point fills
+// one table of the powers used per axis (each term power and the power below it), and all values
+// and partials are read off that table. Scratch is sized by the constructor, so evaluate() never
+// allocates; it is not safe to call on one evaluator from several threads at once.
+class JacobianEvaluator {
+public:
+    // Points evaluated together; the per-term loops run over a whole batch
+    static const size_t BATCH = 8;
+
+    JacobianEvaluator() = default;
+    explicit JacobianEvaluator(const std::vector<Polynom>& polynoms);
+
+    size_t size() const;
+
+    // Polynom p at point i: values[p * count + i], its derivative by var (x 0, y 1, z 2) in
+    // jacobian[(p * 3 + var) * count + i]
+    void evaluate(const double* xs, const double* ys, const double* zs, size_t count, double* values, double* jacobian);
+    // Value of polynom p into values[p] and its gradient into jacobian[p * 3 .. p * 3 + 2]
+    void evaluate(double x, double y, double z, double* values, double* jacobian);
+
+private:
+    struct Term {
+        double ratio;
+        double power[3];        // multiplier of the derivative by each var
+        uint32_t row[3];        // table row of the power on each axis
+        uint32_t lower_row[3];  // table row of the power minus one (the power itself when it is 0)
+    };
+
+    std::vector<Term> terms;
+    // Polynom p is terms[offsets[p]] .. terms[offsets[p + 1] - 1]
+    std::vector<size_t> offsets{ 0 };
+    // Ascending distinct powers of each axis; tables[var][row * BATCH + k] is the power at point k
+    std::vector<int> powers[3];
+    std::vector<double> tables[3];
+
+    template <size_t LANES>
+    void evaluate_lanes(const double* xs, const double* ys, const double* zs, size_t length, size_t count,
+        double* values, double* jacobian);
+};
@@ -0,0 +1,337 @@
+#pragma once
+
+#include "polynoms.h"
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+// A polynom literal parsed by a constexpr parser. Bound to a constexpr variable,
+//     constexpr PolynomLiteral p = "3x^2+y"_poly;
+// it is a table of terms built at compile time, already in polynom order with equal powers merged,
+// and a Polynom made from it only copies the terms. The grammar is PolynomParser's, and numbers are
+// rounded to nearest float like NumberParser, so the result matches Polynom(std::string_view).
+// A malformed literal throws std::invalid_argument, which in a constant expression is a compile error.
+class PolynomLiteral {
+public:
+    static constexpr size_t MAX_TERMS = 64;
+    // Digits of one number, leading zeros included
+    static constexpr size_t MAX_DIGITS = 64;
+
+    constexpr PolynomLiteral(const char* text, size_t length) {
+        parse(text, text + length);
+        sort_and_merge();
+    }
+
+    constexpr size_t size() const {
+        return count;
+    }
+
+    constexpr const PolyTerm& operator[](size_t index) const {
+        return terms[index];
+    }
+
+private:
+    PolyTerm terms[MAX_TERMS] = {};
+    size_t count = 0;
+
+    // Unsigned integer of LIMBS 32-bit limbs, least significant first: enough for MAX_DIGITS decimal
+    // digits shifted by the float precision
+    struct BigInt {
+        static constexpr size_t LIMBS = 12;
+        uint32_t limbs[LIMBS] = {};
+
+        constexpr void multiply_add(uint32_t factor, uint32_t addend) {
+            uint64_t carry = addend;
+            for (size_t i = 0; i < LIMBS; ++i) {
+                uint64_t value = static_cast<uint64_t>(limbs[i]) * factor + carry;
+                limbs[i] = static_cast<uint32_t>(value);
+                carry = value >> 32;
+            }
+            if (carry != 0) {
+                throw std::invalid_argument("Polynom literal: number out of range");
+            }
+        }
+
+        constexpr void shift_left(int bits) {
+            for (; bits >= 32; bits -= 32) {
+                if (limbs[LIMBS - 1] != 0) {
+                    throw std::invalid_argument("Polynom literal: number out of range");
+                }
+                for (size_t i = LIMBS - 1; i > 0; --i) {
+                    limbs[i] = limbs[i - 1];
+                }
+                limbs[0] = 0;
+            }
+            if (bits > 0) {
+                if (limbs[LIMBS - 1] >> (32 - bits)) {
+                    throw std::invalid_argument("Polynom literal: number out of range");
+                }
+                for (size_t i = LIMBS - 1; i > 0; --i) {
+                    limbs[i] = (limbs[i] << bits) | (limbs[i - 1] >> (32 - bits));
+                }
+                limbs[0] <<= bits;
+            }
+        }
+
+        constexpr int bit_length() const {
+            for (size_t i = LIMBS; i-- > 0;) {
+                for (int bit = 31; bit >= 0; --bit) {
+                    if ((limbs[i] >> bit) & 1) {
+                        return static_cast<int>(i) * 32 + bit + 1;
+                    }
+                }
+            }
+            return 0;
+        }
+
+        constexpr int compare(const BigInt& oth) const {
+            for (size_t i = LIMBS; i-- > 0;) {
+                if (limbs[i] != oth.limbs[i]) {
+                    return limbs[i] > oth.limbs[i] ? 1 : -1;
+                }
+            }
+            return 0;
+        }
+
+        constexpr void subtract(const BigInt& oth) {
+            uint64_t borrow = 0;
+            for (size_t i = 0; i < LIMBS; ++i) {
+                uint64_t value = static_cast<uint64_t>(limbs[i]) - oth.limbs[i] - borrow;
+                limbs[i] = static_cast<uint32_t>(value);
+                borrow = (value >> 32) & 1;
+            }
+        }
+    };
+
+    static constexpr bool is_digit(char c) {
+        return c >= '0' && c <= '9';
+    }
+
+    static constexpr bool is_space(char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+    }
+
+    static constexpr int var_index(char c) {
+        return c == 'x' ? 0 : c == 'y' ? 1 : c == 'z' ? 2 : -1;
+    }
+
+    static constexpr const char* skip_spaces(const char* cur, const char* end) {
+        while (cur != end && is_space(*cur)) {
+            ++cur;
+        }
+        return cur;
+    }
+
+    // digits * 10^exponent rounded to nearest float, ties to even; below FLT_MIN gives 0.
+    // q = floor(digits * 2^shift / 10^-exponent) is brought into [2^23, 2^24) and the remainder rounds it.
+    static constexpr float to_float(const BigInt& digits, int exponent) {
+        BigInt numerator = digits;
+        BigInt denominator;
+        denominator.limbs[0] = 1;
+        for (; exponent > 0; --exponent) {
+            numerator.multiply_add(10, 0);
+        }
+        for (; exponent < 0; ++exponent) {
+            denominator.multiply_add(10, 0);
+        }
+        if (numerator.bit_length() == 0) {
+            return 0.0f;
+        }
+        int shift = 24 - (numerator.bit_length() - denominator.bit_length());
+        uint64_t quotient = 0;
+        BigInt remainder;
+        BigInt divisor;
+        for (;;) {
+            remainder = numerator;
+            divisor = denominator;
+            if (shift >= 0) {
+                remainder.shift_left(shift);
+            }
+            else {
+                divisor.shift_left(-shift);
+            }
+            quotient = 0;
+            for (int bit = 25; bit >= 0; --bit) {
+                BigInt step = divisor;
+                step.shift_left(bit);
+                if (remainder.compare(step) >= 0) {
+                    remainder.subtract(step);
+                    quotient |= uint64_t(1) << bit;
+                }
+            }
+            if (quotient >= (uint64_t(1) << 24)) {
+                --shift;
+            }
+            else if (quotient < (uint64_t(1) << 23)) {
+                ++shift;
+            }
+            else {
+                break;
+            }
+        }
+        remainder.shift_left(1);
+        const int half = remainder.compare(divisor);
+        if (half > 0 || (half == 0 && (quotient & 1))) {
+            if (++quotient == (uint64_t(1) << 24)) {
+                quotient >>= 1;
+                --shift;
+            }
+        }
+        // quotient * 2^-shift lies in [2^(23 - shift), 2^(24 - shift))
+        if (24 - shift > 128) {
+            throw std::invalid_argument("Polynom literal: number out of range");
+        }
+        if (23 - shift < -126) {
+            return 0.0f;
+        }
+        double value = static_cast<double>(quotient);
+        for (; shift > 0; --shift) {
+            value /= 2.0;
+        }
+        for (; shift < 0; ++shift) {
+            value *= 2.0;
+        }
+        return static_cast<float>(value);
+    }
+
+    // Unsigned "digits[.digits]" or ".digits"
+    static constexpr const char* parse_decimal(const char* cur, const char* end, float& value) {
+        BigInt digits;
+        size_t digit_count = 0;
+        int exponent = 0;
+        bool fraction = false;
+        for (; cur != end && (is_digit(*cur) || (*cur == '.' && !fraction)); ++cur) {
+            if (*cur == '.') {
+                fraction = true;
+                continue;
+            }
+            if (++digit_count > MAX_DIGITS) {
+                throw std::invalid_argument("Polynom literal: too many digits in a number");
+            }
+            digits.multiply_add(10, static_cast<uint32_t>(*cur - '0'));
+            if (fraction) {
+                --exponent;
+            }
+        }
+        if (digit_count == 0) {
+            throw std::invalid_argument("Polynom literal: invalid number format");
+        }
+        value = to_float(digits, exponent);
+        return cur;
+    }
+
+    static constexpr const char* parse_integer(const char* cur, const char* end, int& value) {
+        if (cur == end || !is_digit(*cur)) {
+            throw std::invalid_argument("Polynom literal: missing exponent value after '^'");
+        }
+        int64_t result = 0;
+        for (; cur != end && is_digit(*cur); ++cur) {
+            result = result * 10 + (*cur - '0');
+            if (result > INT_MAX) {
+                throw std::invalid_argument("Polynom literal: number out of range");
+            }
+        }
+        value = static_cast<int>(result);
+        return cur;
+    }
+
+    constexpr void parse(const char* cur, const char* end) {
+        cur = skip_spaces(cur, end);
+        bool first_term = true;
+        while (cur != end) {
+            float sign = 1.0f;
+            if (*cur == '+' || *cur == '-') {
+                if (*cur == '-') {
+                    sign = -1.0f;
+                }
+                cur = skip_spaces(cur + 1, end);
+                if (cur == end) {
+                    throw std::invalid_argument("Polynom literal: sign without a term");
+                }
+            }
+            else if (!first_term) {
+                throw std::invalid_argument("Polynom literal: unexpected character");
+            }
+
+            float ratio = 1.0f;
+            bool has_number = false;
+            if (is_digit(*cur) || *cur == '.') {
+                cur = skip_spaces(parse_decimal(cur, end, ratio), end);
+                has_number = true;
+            }
+
+            int powers[3] = { 0, 0, 0 };
+            bool has_var = false;
+            while (cur != end && var_index(*cur) >= 0) {
+                const int var = var_index(*cur);
+                has_var = true;
+                cur = skip_spaces(cur + 1, end);
+                int power = 1;
+                if (cur != end && *cur == '^') {
+                    cur = skip_spaces(cur + 1, end);
+                    bool negative = false;
+                    if (cur != end && (*cur == '-' || *cur == '+')) {
+                        negative = *cur == '-';
+                        cur = skip_spaces(cur + 1, end);
+                    }
+                    cur = skip_spaces(parse_integer(cur, end, power), end);
+                    if (negative) {
+                        power = -power;
+                    }
+                }
+                powers[var] += power;
+            }
+
+            if (!has_number && !has_var) {
+                throw std::invalid_argument("Polynom literal: expected a coefficient or a variable");
+            }
+            // as PolynomBuilder::add
+            const float value = sign * ratio;
+            if (!(value < EPSILON && value > -EPSILON)) {
+                if (count == MAX_TERMS) {
+                    throw std::invalid_argument("Polynom literal: too many terms");
+                }
+                terms[count++] = { value, { powers[0], powers[1], powers[2] }, powers[0] + powers[1] + powers[2] };
+            }
+            first_term = false;
+        }
+    }
+
+    // Stable insertion sort and merge of equal powers in order, as Polynom::normalize does for short input
+    constexpr void sort_and_merge() {
+        for (size_t i = 1; i < count; ++i) {
+            const PolyTerm key = terms[i];
+            size_t j = i;
+            while (j > 0 && compare_powers(key.powers, terms[j - 1].powers) > 0) {
+                terms[j] = terms[j - 1];
+                --j;
+            }
+            terms[j] = key;
+        }
+        size_t merged = 0;
+        for (size_t i = 0; i < count;) {
+            PolyTerm current = terms[i];
+            size_t j = i + 1;
+            for (; j < count && compare_powers(current.powers, terms[j].powers) == 0; ++j) {
+                current.ratio += terms[j].ratio;
+            }
+            if (current.ratio > EPSILON || current.ratio < -EPSILON) {
+                terms[merged++] = current;
+            }
+            i = j;
+        }
+        for (size_t i = merged; i < count; ++i) {
+            terms[i] = {};
+        }
+        count = merged;
+    }
+};
+
+namespace polynom_literals {
+
+constexpr PolynomLiteral operator""_poly(const char* text, size_t length) {
+    return PolynomLiteral(text, length);
+}
+
+}
@@ -0,0 +1,609 @@
+#include "polynom_multiply.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+struct MultiplyPlanner::Layout {
+    bool packable = false;
+    int lo[3] = { 0, 0, 0 };        // product box
+    int extent[3] = { 0, 0, 0 };
+    int lo_a[3] = { 0, 0, 0 };
+    int lo_b[3] = { 0, 0, 0 };
+    uint64_t stride[3] = { 0, 0, 0 };
+    uint64_t volume = 0;
+    uint64_t length_a = 0;          // packed index of the highest cell of a's box + 1
+    uint64_t length_b = 0;
+};
+
+static const uint64_t MAX_PACKED_VOLUME = uint64_t(1) << 62;
+static const uint64_t EMPTY_SLOT = ~uint64_t(0);
+
+static std::atomic<MultiplyKernel> override_kernel_value(MultiplyKernel::AUTO);
+static std::mutex costs_mutex;
+static MultiplyCosts current_costs;
+static std::atomic<bool> log_enabled(false);
+static std::mutex log_mutex;
+static std::function<void(const MultiplyPlan&)> log_sink;
+
+const char* kernel_name(MultiplyKernel kernel) {
+    switch (kernel) {
+    case MultiplyKernel::AUTO: return "auto";
+    case MultiplyKernel::NAIVE: return "naive";
+    case MultiplyKernel::HEAP: return "heap";
+    case MultiplyKernel::HASH: return "hash";
+    case MultiplyKernel::DENSE: return "dense";
+    case MultiplyKernel::KARATSUBA: return "karatsuba";
+    case MultiplyKernel::FFT: return "fft";
+    }
+    return "unknown";
+}
+
+std::ostream& operator<<(std::ostream& os, const MultiplyPlan& plan) {
+    os << "multiply: " << kernel_name(plan.kernel) << (plan.forced ? " (forced)" : "")
+        << ", pairs " << plan.pairs << ", estimated terms " << plan.estimated_terms
+        << ", volume " << plan.volume << ", density " << plan.estimated_density
+        << ", cost " << plan.estimated_cost << " ns";
+    return os;
+}
+
+
+// Schoolbook below KARATSUBA_BASE_LENGTH; out receives all 2n - 1 coefficients
+static void karatsuba(const double* a, const double* b, size_t n, double* out) {
+    if (n <= MultiplyPlanner::KARATSUBA_BASE_LENGTH) {
+        std::fill(out, out + 2 * n - 1, 0.0);
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                out[i + j] += a[i] * b[j];
+            }
+        }
+        return;
+    }
+    size_t low = (n + 1) / 2;
+    size_t high = n - low;
+    std::vector<double> sum_a(a, a + low);
+    std::vector<double> sum_b(b, b + low);
+    for (size_t i = 0; i < high; ++i) {
+        sum_a[i] += a[low + i];
+        sum_b[i] += b[low + i];
+    }
+    std::vector<double> middle(2 * low - 1);
+
+    karatsuba(a, b, low, out);
+    out[2 * low - 1] = 0.0;
+    karatsuba(a + low, b + low, high, out + 2 * low);
+    karatsuba(sum_a.data(), sum_b.data(), low, middle.data());
+    for (size_t i = 0; i < 2 * low - 1; ++i) {
+        middle[i] -= out[i];
+    }
+    for (size_t i = 0; i < 2 * high - 1; ++i) {
+        middle[i] -= out[2 * low + i];
+    }
+    for (size_t i = 0; i < 2 * low - 1; ++i) {
+        out[low + i] += middle[i];
+    }
+}
+
+// Splits the longer operand into chunks as long as the shorter one
+static void karatsuba_multiply(const double* a, size_t na, const double* b, size_t nb, double* out) {
+    if (na < nb) {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+    std::fill(out, out + na + nb - 1, 0.0);
+    std::vector<double> chunk(nb);
+    std::vector<double> product(2 * nb - 1);
+    for (size_t offset = 0; offset < na; offset += nb) {
+        size_t length = std::min(nb, na - offset);
+        std::copy(a + offset, a + offset + length, chunk.begin());
+        std::fill(chunk.begin() + length, chunk.end(), 0.0);
+        karatsuba(chunk.data(), b, nb, product.data());
+        for (size_t k = 0; k < length + nb - 1; ++k) {
+            out[offset + k] += product[k];
+        }
+    }
+}
+
+static void fft(std::complex<double>* data, size_t n, const std::complex<double>* roots, bool inverse) {
+    for (size_t i = 1, j = 0; i < n; ++i) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(data[i], data[j]);
+        }
+    }
+    for (size_t length = 2; length <= n; length <<= 1) {
+        size_t step = n / length;
+        for (size_t start = 0; start < n; start += length) {
+            for (size_t k = 0; k < length / 2; ++k) {
+                std::complex<double> w = inverse ? std::conj(roots[k * step]) : roots[k * step];
+                std::complex<double> u = data[start + k];
+                std::complex<double> v = data[start + k + length / 2] * w;
+                data[start + k] = u + v;
+                data[start + k + length / 2] = u - v;
+            }
+        }
+    }
+}
+
+// Both real inputs share one complex transform (a in the real part, b in the imaginary part)
+static void fft_multiply(const double* a, size_t na, const double* b, size_t nb, double* out) {
+    size_t n = 1;
+    while (n < na + nb - 1) {
+        n <<= 1;
+    }
+    const double pi = std::acos(-1.0);
+    std::vector<std::complex<double>> roots(std::max<size_t>(n / 2, 1));
+    for (size_t k = 0; k < n / 2; ++k) {
+        roots[k] = std::polar(1.0, 2.0 * pi * static_cast<double>(k) / static_cast<double>(n));
+    }
+
+    // b is scaled to the norm of a, otherwise rounding errors of the larger input swamp the smaller one
+    double norm_a = 0.0;
+    double norm_b = 0.0;
+    for (size_t i = 0; i < na; ++i) {
+        norm_a += a[i] * a[i];
+    }
+    for (size_t i = 0; i < nb; ++i) {
+        norm_b += b[i] * b[i];
+    }
+    double scale = norm_a > 0.0 && norm_b > 0.0 ? std::sqrt(norm_a / norm_b) : 1.0;
+
+    std::vector<std::complex<double>> packed(n);
+    for (size_t i = 0; i < na; ++i) {
+        packed[i].real(a[i]);
+    }
+    for (size_t i = 0; i < nb; ++i) {
+        packed[i].imag(b[i] * scale);
+    }
+    fft(packed.data(), n, roots.data(), false);
+
+    std::vector<std::complex<double>> product(n);
+    for (size_t k = 0; k < n; ++k) {
+        std::complex<double> mirror = std::conj(packed[(n - k) & (n - 1)]);
+        std::complex<double> spectrum_a = (packed[k] + mirror) * 0.5;
+        std::complex<double> spectrum_b = (packed[k] - mirror) * std::complex<double>(0.0, -0.5);
+        product[k] = spectrum_a * spectrum_b;
+    }
+    fft(product.data(), n, roots.data(), true);
+    for (size_t i = 0; i < na + nb - 1; ++i) {
+        out[i] = product[i].real() / (static_cast<double>(n) * scale);
+    }
+}
+
+
+void MultiplyPlanner::make_layout(const Polynom& a, const Polynom& b, Layout& layout) {
+    Polynom::Box box_a = a.bounding_box();
+    Polynom::Box box_b = b.bounding_box();
+    double volume = 1.0;
+    for (size_t i = 0; i < 3; ++i) {
+        int64_t lo = static_cast<int64_t>(box_a.lo[i]) + box_b.lo[i];
+        int64_t hi = static_cast<int64_t>(box_a.hi[i]) + box_b.hi[i];
+        if (lo < INT_MIN || hi > INT_MAX) {
+            return;
+        }
+        layout.lo[i] = static_cast<int>(lo);
+        layout.extent[i] = static_cast<int>(hi - lo + 1);
+        layout.lo_a[i] = box_a.lo[i];
+        layout.lo_b[i] = box_b.lo[i];
+        volume *= static_cast<double>(hi - lo + 1);
+    }
+    if (volume >= static_cast<double>(MAX_PACKED_VOLUME)) {
+        return;
+    }
+    layout.stride[2] = 1;
+    layout.stride[1] = static_cast<uint64_t>(layout.extent[2]);
+    layout.stride[0] = layout.stride[1] * static_cast<uint64_t>(layout.extent[1]);
+    layout.volume = layout.stride[0] * static_cast<uint64_t>(layout.extent[0]);
+    layout.length_a = 1;
+    layout.length_b = 1;
+    for (size_t i = 0; i < 3; ++i) {
+        layout.length_a += static_cast<uint64_t>(box_a.hi[i] - box_a.lo[i]) * layout.stride[i];
+        layout.length_b += static_cast<uint64_t>(box_b.hi[i] - box_b.lo[i]) * layout.stride[i];
+    }
+    layout.packable = true;
+}
+
+MultiplyPlan MultiplyPlanner::make_plan(const Polynom& a, const Polynom& b, const Layout& layout, MultiplyKernel kernel) {
+    MultiplyPlan plan;
+    plan.pairs = a.size() * b.size();
+    double estimate = static_cast<double>(plan.pairs);
+    if (layout.packable) {
+        plan.volume = layout.volume;
+        estimate = std::min(estimate, static_cast<double>(layout.volume));
+        if (layout.lo[0] >= 0 && layout.lo[1] >= 0 && layout.lo[2] >= 0) {
+            // monoms of total degree <= deg(a) + deg(b)
+            double degree = static_cast<double>(a.degree()) + b.degree();
+            estimate = std::min(estimate, (degree + 1) * (degree + 2) * (degree + 3) / 6);
+        }
+        plan.estimated_density = estimate / static_cast<double>(layout.volume);
+    }
+    plan.estimated_terms = static_cast<size_t>(estimate);
+
+    const MultiplyCosts costs = MultiplyPlanner::costs();
+    const double pairs = static_cast<double>(plan.pairs);
+    const double terms = static_cast<double>(plan.estimated_terms);
+    const bool packed_fits = layout.packable && layout.volume <= Polynom::DENSE_MAX_VOLUME;
+
+    auto applicable = [&](MultiplyKernel k) {
+        switch (k) {
+        case MultiplyKernel::HEAP:
+        case MultiplyKernel::HASH:
+            return layout.packable;
+        case MultiplyKernel::DENSE:
+        case MultiplyKernel::KARATSUBA:
+        case MultiplyKernel::FFT:
+            return packed_fits;
+        default:
+            return true;
+        }
+    };
+    auto cost_of = [&](MultiplyKernel k) {
+        double cells = static_cast<double>(layout.volume) * costs.dense_cell;
+        switch (k) {
+        case MultiplyKernel::HEAP: {
+            double levels = std::log2(static_cast<double>(std::min(a.size(), b.size())) + 1.0);
+            return pairs * levels * costs.heap_pair + terms * costs.output_term;
+        }
+        case MultiplyKernel::HASH:
+            return pairs * costs.hash_pair + terms * costs.output_term;
+        case MultiplyKernel::DENSE:
+            return pairs * costs.dense_pair + cells;
+        case MultiplyKernel::KARATSUBA: {
+            double shorter = static_cast<double>(std::min(layout.length_a, layout.length_b));
+            double chunks = std::ceil(static_cast<double>(std::max(layout.length_a, layout.length_b)) / shorter);
+            return chunks * std::pow(shorter, std::log2(3.0)) * costs.karatsuba_op + cells;
+        }
+        case MultiplyKernel::FFT: {
+            double length = 1.0;
+            while (length < static_cast<double>(layout.volume)) {
+                length *= 2.0;
+            }
+            return length * std::log2(length) * costs.fft_op + cells;
+        }
+        default:
+            return pairs * costs.naive_pair;
+        }
+    };
+
+    if (kernel != MultiplyKernel::AUTO) {
+        plan.forced = true;
+        plan.kernel = applicable(kernel) ? kernel : MultiplyKernel::NAIVE;
+        plan.estimated_cost = cost_of(plan.kernel);
+        return plan;
+    }
+
+    plan.kernel = MultiplyKernel::NAIVE;
+    plan.estimated_cost = cost_of(MultiplyKernel::NAIVE);
+    const MultiplyKernel candidates[] = { MultiplyKernel::HEAP, MultiplyKernel::HASH, MultiplyKernel::DENSE,
+        MultiplyKernel::KARATSUBA, MultiplyKernel::FFT };
+    for (MultiplyKernel candidate : candidates) {
+        bool packed_kernel = candidate != MultiplyKernel::HEAP && candidate != MultiplyKernel::HASH;
+        if (!applicable(candidate) || plan.pairs <= NAIVE_MAX_PAIRS ||
+            (packed_kernel && plan.estimated_terms < Polynom::DENSE_MIN_TERMS)) {
+            continue;
+        }
+        double cost = cost_of(candidate);
+        if (cost < plan.estimated_cost) {
+            plan.kernel = candidate;
+            plan.estimated_cost = cost;
+        }
+    }
+    return plan;
+}
+
+MultiplyPlan MultiplyPlanner::plan(const Polynom& a, const Polynom& b) {
+    Layout layout;
+    make_layout(a, b, layout);
+    return make_plan(a, b, layout, override_kernel());
+}
+
+Polynom MultiplyPlanner::multiply(const Polynom& a, const Polynom& b) {
+    return multiply(a, b, override_kernel());
+}
+
+Polynom MultiplyPlanner::multiply(const Polynom& a, const Polynom& b, MultiplyKernel kernel) {
+    if (a.size() == 0 || b.size() == 0) {
+        return Polynom();
+    }
+    bool logging = log_enabled.load(std::memory_order_relaxed);
+    if (kernel == MultiplyKernel::AUTO && !logging && a.size() * b.size() <= NAIVE_MAX_PAIRS) {
+        return multiply_naive(a, b);
+    }
+
+    Layout layout;
+    make_layout(a, b, layout);
+    MultiplyPlan plan = make_plan(a, b, layout, kernel);
+    if (logging) {
+        std::lock_guard<std::mutex> lock(log_mutex);
+        if (log_sink) {
+            log_sink(plan);
+        }
+    }
+
+    switch (plan.kernel) {
+    case MultiplyKernel::HEAP:
+        return multiply_heap(a, b, layout);
+    case MultiplyKernel::HASH:
+        return multiply_hash(a, b, layout, plan.estimated_terms);
+    case MultiplyKernel::DENSE: {
+        Polynom::Box box;
+        for (size_t i = 0; i < 3; ++i) {
+            box.lo[i] = layout.lo[i];
+            box.hi[i] = layout.lo[i] + layout.extent[i] - 1;
+        }
+        return a.multiply_dense(b, box);
+    }
+    case MultiplyKernel::KARATSUBA:
+    case MultiplyKernel::FFT:
+        return multiply_packed(a, b, layout, plan.kernel);
+    default:
+        return multiply_naive(a, b);
+    }
+}
+
+void MultiplyPlanner::set_override(MultiplyKernel kernel) {
+    override_kernel_value = kernel;
+}
+
+MultiplyKernel MultiplyPlanner::override_kernel() {
+    return override_kernel_value;
+}
+
+void MultiplyPlanner::set_costs(const MultiplyCosts& costs) {
+    std::lock_guard<std::mutex> lock(costs_mutex);
+    current_costs = costs;
+}
+
+MultiplyCosts MultiplyPlanner::costs() {
+    std::lock_guard<std::mutex> lock(costs_mutex);
+    return current_costs;
+}
+
+void MultiplyPlanner::set_log(std::function<void(const MultiplyPlan&)> sink) {
+    std::lock_guard<std::mutex> lock(log_mutex);
+    log_enabled = static_cast<bool>(sink);
+    log_sink = std::move(sink);
+}
+
+
+void MultiplyPlanner::pack(const Polynom& p, const int* lo, const Layout& layout, uint64_t* keys, float* ratios) {
+    size_t idx = 0;
+    p.for_each_term_unordered([&](float ratio, const int* powers) {
+        keys[idx] = static_cast<uint64_t>(powers[0] - lo[0]) * layout.stride[0] +
+            static_cast<uint64_t>(powers[1] - lo[1]) * layout.stride[1] + static_cast<uint64_t>(powers[2] - lo[2]);
+        ratios[idx] = ratio;
+        ++idx;
+    });
+}
+
+Polynom MultiplyPlanner::sparse_result(const Layout& layout, const uint64_t* keys, const float* ratios, size_t count) {
+    Polynom result;
+    result.terms.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t key = keys[i];
+        int powers[3];
+        powers[0] = layout.lo[0] + static_cast<int>(key / layout.stride[0]);
+        key %= layout.stride[0];
+        powers[1] = layout.lo[1] + static_cast<int>(key / layout.stride[1]);
+        powers[2] = layout.lo[2] + static_cast<int>(key % layout.stride[1]);
+        result.terms.push_back(make_term(ratios[i], powers));
+    }
+    result.normalize();
+    return result;
+}
+
+Polynom MultiplyPlanner::dense_result(const Layout& layout, const double* coeffs, size_t count) {
+    Polynom::DenseStorage cells(layout.volume, 0.0f, polynom_resource());
+    for (size_t i = 0; i < count; ++i) {
+        cells[i] = static_cast<float>(coeffs[i]);
+    }
+    Polynom::Box box;
+    for (size_t i = 0; i < 3; ++i) {
+        box.lo[i] = layout.lo[i];
+        box.hi[i] = layout.lo[i] + layout.extent[i] - 1;
+    }
+    Polynom result;
+    result.assign_dense(box, std::move(cells));
+    return result;
+}
+
+
+Polynom MultiplyPlanner::multiply_naive(const Polynom& a, const Polynom& b) {
+    if (a.dense || b.dense) {
+        return multiply_naive(a.as_sparse(), b.as_sparse());
+    }
+    Polynom result;
+    result.terms.reserve(a.terms.size() * b.terms.size());
+    a.append_products(b, result.terms);
+    result.normalize();
+    return result;
+}
+
+// Johnson's heap merge over packed exponents, which (unlike the polynom order) respect
+// multiplication: the stream of a[i] * b[0..] is ascending, so a heap over the smaller operand
+// yields all products in key order and like terms arrive together. Row i + 1 enters the heap only
+// once row i has produced its first product, which keeps the heap small.
+Polynom MultiplyPlanner::multiply_heap(const Polynom& a, const Polynom& b, const Layout& layout) {
+    bool a_smaller = a.size() <= b.size();
+    const Polynom& rows = a_smaller ? a : b;
+    const Polynom& cols = a_smaller ? b : a;
+    size_t row_count = rows.size();
+    size_t col_count = cols.size();
+
+    std::vector<std::pair<uint64_t, float>> row_terms(row_count);
+    std::vector<std::pair<uint64_t, float>> col_terms(col_count);
+    {
+        std::unique_ptr<uint64_t[]> keys(new uint64_t[std::max(row_count, col_count)]);
+        std::unique_ptr<float[]> ratios(new float[std::max(row_count, col_count)]);
+        pack(rows, a_smaller ? layout.lo_a : layout.lo_b, layout, keys.get(), ratios.get());
+        for (size_t i = 0; i < row_count; ++i) {
+            row_terms[i] = { keys[i], ratios[i] };
+        }
+        pack(cols, a_smaller ? layout.lo_b : layout.lo_a, layout, keys.get(), ratios.get());
+        for (size_t i = 0; i < col_count; ++i) {
+            col_terms[i] = { keys[i], ratios[i] };
+        }
+    }
+    auto by_key = [](const std::pair<uint64_t, float>& x, const std::pair<uint64_t, float>& y) { return x.first < y.first; };
+    std::sort(row_terms.begin(), row_terms.end(), by_key);
+    std::sort(col_terms.begin(), col_terms.end(), by_key);
+
+    struct Entry {
+        uint64_t key;
+        size_t row;
+        size_t col;
+    };
+    auto later = [](const Entry& x, const Entry& y) { return x.key > y.key; };
+    std::vector<Entry> heap;
+    heap.reserve(row_count);
+    heap.push_back({ row_terms[0].first + col_terms[0].first, 0, 0 });
+
+    std::vector<uint64_t> keys;
+    std::vector<float> ratios;
+    uint64_t current = heap.front().key;
+    float sum = 0.0f;
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), later);
+        Entry entry = heap.back();
+        heap.pop_back();
+        if (entry.key != current) {
+            if (std::abs(sum) > EPSILON) {
+                keys.push_back(current);
+                ratios.push_back(sum);
+            }
+            current = entry.key;
+            sum = 0.0f;
+        }
+        float product = row_terms[entry.row].second * col_terms[entry.col].second;
+        if (std::abs(product) > EPSILON) {
+            sum += product;
+        }
+        if (entry.col == 0 && entry.row + 1 < row_count) {
+            heap.push_back({ row_terms[entry.row + 1].first + col_terms[0].first, entry.row + 1, 0 });
+            std::push_heap(heap.begin(), heap.end(), later);
+        }
+        if (entry.col + 1 < col_count) {
+            heap.push_back({ row_terms[entry.row].first + col_terms[entry.col + 1].first, entry.row, entry.col + 1 });
+            std::push_heap(heap.begin(), heap.end(), later);
+        }
+    }
+    if (std::abs(sum) > EPSILON) {
+        keys.push_back(current);
+        ratios.push_back(sum);
+    }
+    return sparse_result(layout, keys.data(), ratios.data(), keys.size());
+}
+
+// Open addressing on packed exponents; estimated_terms bounds the number of distinct keys,
+// so a table of twice that size never fills up
+Polynom MultiplyPlanner::multiply_hash(const Polynom& a, const Polynom& b, const Layout& layout, size_t estimated_terms) {
+    size_t count_a = a.size();
+    size_t count_b = b.size();
+    std::unique_ptr<uint64_t[]> keys_a(new uint64_t[count_a]);
+    std::unique_ptr<float[]> ratios_a(new float[count_a]);
+    std::unique_ptr<uint64_t[]> keys_b(new uint64_t[count_b]);
+    std::unique_ptr<float[]> ratios_b(new float[count_b]);
+    pack(a, layout.lo_a, layout, keys_a.get(), ratios_a.get());
+    pack(b, layout.lo_b, layout, keys_b.get(), ratios_b.get());
+
+    unsigned bits = 4;
+    while ((size_t(1) << bits) < 2 * std::max<size_t>(estimated_terms, 1)) {
+        ++bits;
+    }
+    size_t capacity = size_t(1) << bits;
+    size_t mask = capacity - 1;
+    std::unique_ptr<uint64_t[]> slots(new uint64_t[capacity]);
+    std::unique_ptr<float[]> sums(new float[capacity]);
+    std::fill(slots.get(), slots.get() + capacity, EMPTY_SLOT);
+    std::fill(sums.get(), sums.get() + capacity, 0.0f);
+
+    for (size_t i = 0; i < count_a; ++i) {
+        for (size_t j = 0; j < count_b; ++j) {
+            float product = ratios_a[i] * ratios_b[j];
+            if (std::abs(product) <= EPSILON) {
+                continue;
+            }
+            uint64_t key = keys_a[i] + keys_b[j];
+            size_t slot = static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> (64 - bits));
+            while (slots[slot] != key && slots[slot] != EMPTY_SLOT) {
+                slot = (slot + 1) & mask;
+            }
+            slots[slot] = key;
+            sums[slot] += product;
+        }
+    }
+
+    size_t count = 0;
+    for (size_t slot = 0; slot < capacity; ++slot) {
+        if (slots[slot] != EMPTY_SLOT && std::abs(sums[slot]) > EPSILON) {
+            slots[count] = slots[slot];
+            sums[count] = sums[slot];
+            ++count;
+        }
+    }
+    return sparse_result(layout, slots.get(), sums.get(), count);
+}
+
+// Kronecker substitution: with the strides of the product box, packing is additive, so the
+// product of the packed univariate coefficient arrays is exactly the dense product box
+Polynom MultiplyPlanner::multiply_packed(const Polynom& a, const Polynom& b, const Layout& layout, MultiplyKernel kernel) {
+    std::vector<double> coeffs_a(layout.length_a, 0.0);
+    std::vector<double> coeffs_b(layout.length_b, 0.0);
+    auto scatter = [&layout](const Polynom& p, const int* lo, std::vector<double>& out) {
+        p.for_each_term_unordered([&](float ratio, const int* powers) {
+            out[static_cast<uint64_t>(powers[0] - lo[0]) * layout.stride[0] +
+                static_cast<uint64_t>(powers[1] - lo[1]) * layout.stride[1] + static_cast<uint64_t>(powers[2] - lo[2])] = ratio;
+        });
+    };
+    scatter(a, layout.lo_a, coeffs_a);
+    scatter(b, layout.lo_b, coeffs_b);
+
+    std::vector<double> product(coeffs_a.size() + coeffs_b.size() - 1);
+    if (kernel == MultiplyKernel::KARATSUBA) {
+        karatsuba_multiply(coeffs_a.data(), coeffs_a.size(), coeffs_b.data(), coeffs_b.size(), product.data());
+    }
+    else {
+        fft_multiply(coeffs_a.data(), coeffs_a.size(), coeffs_b.data(), coeffs_b.size(), product.data());
+    }
+    return dense_result(layout, product.data(), product.size());
+}
+
+void MultiplyPlanner::multiply_coefficients(const double* a, size_t na, const double* b, size_t nb, double* out) {
+    if (na == 0 || nb == 0) {
+        return;
+    }
+    const MultiplyCosts costs = MultiplyPlanner::costs();
+    const double shorter = static_cast<double>(std::min(na, nb));
+    const double longer = static_cast<double>(std::max(na, nb));
+    double length = 1.0;
+    while (length < shorter + longer - 1.0) {
+        length *= 2.0;
+    }
+    double schoolbook_cost = shorter * longer * costs.dense_pair;
+    double karatsuba_cost = std::ceil(longer / shorter) * std::pow(shorter, std::log2(3.0)) * costs.karatsuba_op;
+    double fft_cost = length * std::log2(length) * costs.fft_op;
+
+    if (schoolbook_cost <= karatsuba_cost && schoolbook_cost <= fft_cost) {
+        std::fill(out, out + na + nb - 1, 0.0);
+        for (size_t i = 0; i < na; ++i) {
+            for (size_t j = 0; j < nb; ++j) {
+                out[i + j] += a[i] * b[j];
+            }
+        }
+    }
+    else if (karatsuba_cost <= fft_cost) {
+        karatsuba_multiply(a, na, b, nb, out);
+    }
+    else {
+        fft_multiply(a, na, b, nb, out);
+    }
+}
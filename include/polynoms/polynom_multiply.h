@@ -0,0 +1,90 @@
+#pragma once
+
+#include "polynoms.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+
+enum class MultiplyKernel {
+    AUTO,       // let the planner decide
+    NAIVE,      // all term pairs, then one sort + merge
+    HEAP,       // heap merge of packed exponent streams, output-sized sort
+    HASH,       // hash accumulation of packed exponents, output-sized sort
+    DENSE,      // term pairs accumulated into the dense product box
+    KARATSUBA,  // Karatsuba on the Kronecker-packed coefficient arrays
+    FFT         // FFT convolution of the Kronecker-packed coefficient arrays
+};
+
+const char* kernel_name(MultiplyKernel kernel);
+
+// Estimated nanoseconds per unit of work of every kernel. The defaults come from
+// bench_multiply_calibrate on the development machine; run it on the target machine to retune.
+struct MultiplyCosts {
+    double naive_pair = 80.0;       // per term pair, including the sort + merge
+    double hash_pair = 100.0;       // per term pair accumulated into the hash table
+    double heap_pair = 15.0;        // per term pair and level of the heap (log2 of the smaller operand)
+    double output_term = 45.0;      // per result term sorted into polynom order
+    double dense_pair = 1.1;        // per term pair accumulated into the product box
+    double dense_cell = 2.7;        // per cell of the product box (zeroing, scanning)
+    double karatsuba_op = 2.2;      // per n^log2(3) for packed operands of length n
+    double fft_op = 4.6;            // per L*log2(L) for a transform of length L
+};
+
+struct MultiplyPlan {
+    MultiplyKernel kernel = MultiplyKernel::NAIVE;
+    bool forced = false;            // kernel came from an override instead of the cost model
+    size_t pairs = 0;               // size(a) * size(b)
+    size_t estimated_terms = 0;     // upper bound on the result size
+    uint64_t volume = 0;            // cells of the product box, 0 if its exponents cannot be packed
+    double estimated_density = 0.0; // estimated_terms / volume
+    double estimated_cost = 0.0;    // nanoseconds by the current MultiplyCosts
+};
+
+std::ostream& operator<<(std::ostream& os, const MultiplyPlan& plan);
+
+// Chooses a multiplication kernel from operand metadata: term counts, total degrees and exponent
+// bounding boxes give an upper bound on the result size and density, and MultiplyCosts turn the
+// work of every applicable kernel into a comparable estimate. Every product of two polynoms goes through here.
+class MultiplyPlanner {
+public:
+    // Products with at most NAIVE_MAX_PAIRS term pairs skip planning and use NAIVE
+    static const size_t NAIVE_MAX_PAIRS = 64;
+    // The Karatsuba recursion switches to schoolbook multiplication below this length
+    static const size_t KARATSUBA_BASE_LENGTH = 32;
+
+    static MultiplyPlan plan(const Polynom& a, const Polynom& b);
+    static Polynom multiply(const Polynom& a, const Polynom& b);
+    // A kernel that cannot handle the operands (exponents too wide to pack, product box over
+    // Polynom::DENSE_MAX_VOLUME for the dense kernels) falls back to NAIVE
+    static Polynom multiply(const Polynom& a, const Polynom& b, MultiplyKernel kernel);
+
+    // Product of dense univariate coefficient arrays into out[0 .. na + nb - 2] by the cheapest of
+    // schoolbook, Karatsuba and FFT under the current MultiplyCosts
+    static void multiply_coefficients(const double* a, size_t na, const double* b, size_t nb, double* out);
+
+    // Forces one kernel for every multiplication; AUTO restores planning
+    static void set_override(MultiplyKernel kernel);
+    static MultiplyKernel override_kernel();
+
+    static void set_costs(const MultiplyCosts& costs);
+    static MultiplyCosts costs();
+
+    // Receives the plan of every multiplication, possibly from several threads at once (calls are
+    // serialized); an empty function turns logging off
+    static void set_log(std::function<void(const MultiplyPlan&)> sink);
+
+private:
+    struct Layout;
+
+    static void make_layout(const Polynom& a, const Polynom& b, Layout& layout);
+    static MultiplyPlan make_plan(const Polynom& a, const Polynom& b, const Layout& layout, MultiplyKernel kernel);
+    static void pack(const Polynom& p, const int* lo, const Layout& layout, uint64_t* keys, float* ratios);
+    static Polynom sparse_result(const Layout& layout, const uint64_t* keys, const float* ratios, size_t count);
+    static Polynom dense_result(const Layout& layout, const double* coeffs, size_t count);
+
+    static Polynom multiply_naive(const Polynom& a, const Polynom& b);
+    static Polynom multiply_heap(const Polynom& a, const Polynom& b, const Layout& layout);
+    static Polynom multiply_hash(const Polynom& a, const Polynom& b, const Layout& layout, size_t estimated_terms);
+    static Polynom multiply_packed(const Polynom& a, const Polynom& b, const Layout& layout, MultiplyKernel kernel);
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+// Runs func(0) .. func(threads - 1), all but the first on worker threads. An exception thrown by
+// any of them is rethrown here once every thread has finished (that of the lowest t if several).
+template <typename F>
+void run_parallel(size_t threads, F&& func) {
+    std::vector<std::exception_ptr> errors(threads);
+    auto guarded = [&func, &errors](size_t t) {
+        try {
+            func(t);
+        }
+        catch (...) {
+            errors[t] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (size_t t = 1; t < threads; ++t) {
+        workers.emplace_back([&guarded, t]() { guarded(t); });
+    }
+    guarded(0);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    for (const std::exception_ptr& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
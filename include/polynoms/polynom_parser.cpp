@@ -0,0 +1,184 @@
+#include "polynom_parser.h"
+#include "number_parser.h"
+#include <climits>
+#include <cmath>
+#include <cstdint>
+
+namespace {
+
+bool is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+int var_index(char c) {
+    switch (c) {
+    case 'x': return 0;
+    case 'y': return 1;
+    case 'z': return 2;
+    default: return -1;
+    }
+}
+
+const char* skip_spaces(const char* cur, const char* end) {
+    while (cur != end && is_space(*cur)) {
+        ++cur;
+    }
+    return cur;
+}
+
+ParseResult make_error(ParseStatus status, const char* begin, const char* at) {
+    ParseResult result;
+    result.status = status;
+    result.offset = static_cast<size_t>(at - begin);
+    return result;
+}
+
+}
+
+const char* ParseResult::message() const {
+    switch (status) {
+    case ParseStatus::OK: return "OK";
+    case ParseStatus::DANGLING_SIGN: return "Sign without a term";
+    case ParseStatus::EXPECTED_TERM: return "Expected a coefficient or a variable";
+    case ParseStatus::UNEXPECTED_CHAR: return "Unexpected character";
+    case ParseStatus::INVALID_NUMBER: return "Invalid number format";
+    case ParseStatus::MISSING_EXPONENT: return "Missing exponent value after '^'";
+    case ParseStatus::NUMBER_OUT_OF_RANGE: return "Number out of range";
+    }
+    return "Unknown parse error";
+}
+
+
+void PolynomBuilder::reserve(size_t count) {
+    pending.reserve(count);
+}
+
+void PolynomBuilder::clear() {
+    pending.clear();
+}
+
+size_t PolynomBuilder::size() const {
+    return pending.size();
+}
+
+void PolynomBuilder::add(float ratio, int px, int py, int pz) {
+    if (std::abs(ratio) < EPSILON) {
+        return;
+    }
+    int powers[3] = { px, py, pz };
+    pending.push_back(make_term(ratio, powers));
+}
+
+void PolynomBuilder::add(const Monom& monom) {
+    add(monom.ratio, monom.powers[0], monom.powers[1], monom.powers[2]);
+}
+
+Polynom PolynomBuilder::build() {
+    Polynom result;
+    build(result);
+    return result;
+}
+
+void PolynomBuilder::build(Polynom& result) {
+    result = Polynom();
+    if (pending.empty()) {
+        return;
+    }
+
+    // The collected terms become the polynom's storage; normalize sorts and merges them in place
+    result.terms = std::move(pending);
+    result.normalize();
+}
+
+
+ParseResult PolynomParser::parse(std::string_view input, PolynomBuilder& builder) {
+    const char* begin = input.data();
+    const char* end = begin + input.size();
+    const char* cur = skip_spaces(begin, end);
+    bool first_term = true;
+
+    while (cur != end) {
+        const char* term_start = cur;
+        float sign = 1.0f;
+        if (*cur == '+' || *cur == '-') {
+            if (*cur == '-') sign = -1.0f;
+            cur = skip_spaces(cur + 1, end);
+            if (cur == end) {
+                return make_error(ParseStatus::DANGLING_SIGN, begin, term_start);
+            }
+        }
+        else if (!first_term) {
+            return make_error(ParseStatus::UNEXPECTED_CHAR, begin, cur);
+        }
+
+        float ratio = 1.0f;
+        bool has_number = false;
+        if (is_digit(*cur) || *cur == '.') {
+            NumberResult number = NumberParser::parse_decimal(cur, end, ratio);
+            if (number.status == NumberStatus::OUT_OF_RANGE) {
+                return make_error(ParseStatus::NUMBER_OUT_OF_RANGE, begin, cur);
+            }
+            if (number.status != NumberStatus::OK) {
+                return make_error(ParseStatus::INVALID_NUMBER, begin, cur);
+            }
+            has_number = true;
+            cur = skip_spaces(number.ptr, end);
+        }
+
+        int powers[3] = { 0, 0, 0 };
+        bool has_var = false;
+        while (cur != end) {
+            const char* var_start = cur;
+            int var_idx = var_index(*cur);
+            if (var_idx < 0) break;
+            has_var = true;
+            cur = skip_spaces(cur + 1, end);
+
+            int power_val = 1;
+            if (cur != end && *cur == '^') {
+                const char* exp_start = cur;
+                cur = skip_spaces(cur + 1, end);
+                bool neg_pow = false;
+                if (cur != end && (*cur == '-' || *cur == '+')) {
+                    neg_pow = (*cur == '-');
+                    cur = skip_spaces(cur + 1, end);
+                }
+                NumberResult number = NumberParser::parse_integer(cur, end, power_val);
+                if (number.status == NumberStatus::INVALID) {
+                    return make_error(ParseStatus::MISSING_EXPONENT, begin, exp_start);
+                }
+                if (number.status == NumberStatus::OUT_OF_RANGE) {
+                    return make_error(ParseStatus::NUMBER_OUT_OF_RANGE, begin, cur);
+                }
+                if (neg_pow) power_val = -power_val;
+                cur = skip_spaces(number.ptr, end);
+            }
+            // a repeated variable adds its exponents, as in "x^2x"
+            int64_t power_sum = static_cast<int64_t>(powers[var_idx]) + power_val;
+            if (power_sum > INT_MAX || power_sum < INT_MIN) {
+                return make_error(ParseStatus::NUMBER_OUT_OF_RANGE, begin, var_start);
+            }
+            powers[var_idx] = static_cast<int>(power_sum);
+        }
+
+        if (!has_number && !has_var) {
+            return make_error(ParseStatus::EXPECTED_TERM, begin, cur);
+        }
+        builder.add(sign * ratio, powers[0], powers[1], powers[2]);
+        first_term = false;
+    }
+    return ParseResult();
+}
+
+ParseResult PolynomParser::parse(std::string_view input, Polynom& result) {
+    PolynomBuilder builder;
+    ParseResult status = parse(input, builder);
+    if (status.ok()) {
+        builder.build(result);
+    }
+    return status;
+}
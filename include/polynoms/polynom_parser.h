@@ -0,0 +1,47 @@
+#pragma once
+
+#include "polynoms.h"
+#include <string_view>
+
+enum class ParseStatus {
+    OK,
+    DANGLING_SIGN,
+    EXPECTED_TERM,
+    UNEXPECTED_CHAR,
+    INVALID_NUMBER,
+    MISSING_EXPONENT,
+    NUMBER_OUT_OF_RANGE
+};
+
+struct ParseResult {
+    ParseStatus status = ParseStatus::OK;
+    size_t offset = 0;
+
+    bool ok() const { return status == ParseStatus::OK; }
+    const char* message() const;
+};
+
+// Collects terms in any order and turns them into a normalized Polynom in one sort + merge pass.
+class PolynomBuilder {
+private:
+    Polynom::TermStorage pending{ polynom_resource() };
+
+public:
+    void reserve(size_t count);
+    void clear();
+    size_t size() const;
+
+    void add(float ratio, int px, int py, int pz);
+    void add(const Monom& monom);
+
+    Polynom build();
+    void build(Polynom& result);
+};
+
+// Single-pass parser of polynom literals like "3.5x^2y-4z^3+7".
+// Whitespace between tokens is ignored; on failure offset points at the offending character.
+class PolynomParser {
+public:
+    static ParseResult parse(std::string_view input, PolynomBuilder& builder);
+    static ParseResult parse(std::string_view input, Polynom& result);
+};
@@ -0,0 +1,667 @@
+#include "polynoms.h"
+#include "polynom_parallel.h"
+#include "polynom_parser.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Signed integer of any size for the exact square-free step, where coefficients are multiplied
+class BigInt {
+public:
+    BigInt() = default;
+    explicit BigInt(int64_t value) : negative(value < 0) {
+        for (uint64_t magnitude = value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+            magnitude != 0; magnitude >>= 32) {
+            limbs.push_back(static_cast<uint32_t>(magnitude));
+        }
+    }
+
+    int sign() const { return limbs.empty() ? 0 : (negative ? -1 : 1); }
+    // Magnitude in 32-bit limbs, least significant first, no zero on top
+    const std::vector<uint32_t>& magnitude() const { return limbs; }
+
+    BigInt& operator+=(const BigInt& oth) {
+        add(oth, oth.negative);
+        return *this;
+    }
+    BigInt& operator-=(const BigInt& oth) {
+        add(oth, !oth.negative);
+        return *this;
+    }
+    BigInt operator*(const BigInt& oth) const {
+        BigInt result;
+        if (limbs.empty() || oth.limbs.empty()) {
+            return result;
+        }
+        result.limbs.assign(limbs.size() + oth.limbs.size(), 0);
+        for (size_t i = 0; i < limbs.size(); ++i) {
+            uint64_t carry = 0;
+            for (size_t j = 0; j < oth.limbs.size(); ++j) {
+                uint64_t current = result.limbs[i + j] + static_cast<uint64_t>(limbs[i]) * oth.limbs[j] + carry;
+                result.limbs[i + j] = static_cast<uint32_t>(current);
+                carry = current >> 32;
+            }
+            result.limbs[i + oth.limbs.size()] = static_cast<uint32_t>(carry);
+        }
+        result.negative = negative != oth.negative;
+        result.trim();
+        return result;
+    }
+
+    void shift_left(size_t bits) {
+        if (limbs.empty()) {
+            return;
+        }
+        limbs.insert(limbs.begin(), bits / 32, 0);
+        const unsigned shift = bits % 32;
+        if (shift != 0) {
+            uint32_t carry = 0;
+            for (uint32_t& limb : limbs) {
+                const uint32_t next = limb >> (32 - shift);
+                limb = limb << shift | carry;
+                carry = next;
+            }
+            if (carry != 0) {
+                limbs.push_back(carry);
+            }
+        }
+    }
+
+private:
+    std::vector<uint32_t> limbs;
+    bool negative = false;
+
+    void trim() {
+        while (!limbs.empty() && limbs.back() == 0) {
+            limbs.pop_back();
+        }
+        if (limbs.empty()) {
+            negative = false;
+        }
+    }
+    bool magnitude_less(const BigInt& oth) const {
+        if (limbs.size() != oth.limbs.size()) {
+            return limbs.size() < oth.limbs.size();
+        }
+        for (size_t i = limbs.size(); i-- > 0;) {
+            if (limbs[i] != oth.limbs[i]) {
+                return limbs[i] < oth.limbs[i];
+            }
+        }
+        return false;
+    }
+    // a -= b for magnitudes with a >= b
+    static void subtract(std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+        uint32_t borrow = 0;
+        for (size_t i = 0; i < a.size() && (borrow != 0 || i < b.size()); ++i) {
+            const uint64_t subtrahend = static_cast<uint64_t>(i < b.size() ? b[i] : 0) + borrow;
+            borrow = a[i] < subtrahend ? 1 : 0;
+            a[i] = static_cast<uint32_t>(a[i] - subtrahend);
+        }
+    }
+    void add(const BigInt& oth, bool oth_negative) {
+        if (&oth == this) {
+            add(BigInt(oth), oth_negative);
+            return;
+        }
+        if (oth_negative == negative || limbs.empty()) {
+            negative = oth_negative;
+            if (limbs.size() < oth.limbs.size()) {
+                limbs.resize(oth.limbs.size(), 0);
+            }
+            uint64_t carry = 0;
+            for (size_t i = 0; i < limbs.size() && (carry != 0 || i < oth.limbs.size()); ++i) {
+                const uint64_t sum = limbs[i] + carry + (i < oth.limbs.size() ? oth.limbs[i] : 0);
+                limbs[i] = static_cast<uint32_t>(sum);
+                carry = sum >> 32;
+            }
+            if (carry != 0) {
+                limbs.push_back(static_cast<uint32_t>(carry));
+            }
+        }
+        else if (magnitude_less(oth)) {
+            std::vector<uint32_t> difference(oth.limbs);
+            subtract(difference, limbs);
+            limbs = std::move(difference);
+            negative = oth_negative;
+        }
+        else {
+            subtract(limbs, oth.limbs);
+        }
+        trim();
+    }
+};
+
+using Integers = std::vector<BigInt>;
+
+// Bits of a nonzero limb
+int limb_bits(uint64_t limb) {
+#if defined(__GNUC__)
+    return 64 - __builtin_clzll(limb);
+#else
+    int bits = 0;
+    for (; limb != 0; limb >>= 1) {
+        ++bits;
+    }
+    return bits;
+#endif
+}
+
+int limb_trailing_zeros(uint64_t limb) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(limb);
+#else
+    int bits = 0;
+    for (; (limb & 1) == 0; limb >>= 1) {
+        ++bits;
+    }
+    return bits;
+#endif
+}
+
+// Integer coefficients by ascending power, in two's complement of the same number of 64-bit limbs,
+// least significant first, in one block. The bisection only adds and shifts them, so a sum is one
+// carry loop; fit() widens them ahead of the growth an operation can cause and narrows them again
+// once they have shrunk.
+class WideCoefficients {
+public:
+    explicit WideCoefficients(const Integers& c) : count(c.size()) {
+        size_t limbs = 1;
+        for (const BigInt& value : c) {
+            limbs = std::max(limbs, value.magnitude().size() / 2 + 1);
+        }
+        width = limbs;
+        data.assign(count * width, 0);
+        for (size_t i = 0; i < count; ++i) {
+            const std::vector<uint32_t>& magnitude = c[i].magnitude();
+            for (size_t k = 0; k < magnitude.size(); ++k) {
+                value(i)[k / 2] |= static_cast<uint64_t>(magnitude[k]) << (32 * (k % 2));
+            }
+            if (c[i].sign() < 0) {
+                negate(i);
+            }
+        }
+    }
+
+    size_t size() const { return count; }
+    int sign(size_t i) const {
+        const uint64_t* v = value(i);
+        if (v[width - 1] >> 63) {
+            return -1;
+        }
+        for (size_t k = 0; k < width; ++k) {
+            if (v[k] != 0) {
+                return 1;
+            }
+        }
+        return 0;
+    }
+    // Bits of |c[i]|, one less for some negative values
+    size_t bit_length(size_t i) const {
+        const uint64_t* v = value(i);
+        const uint64_t extension = v[width - 1] >> 63 ? ~uint64_t(0) : 0;
+        for (size_t k = width; k-- > 0;) {
+            if (v[k] != extension) {
+                return 64 * k + limb_bits(v[k] ^ extension);
+            }
+        }
+        return 0;
+    }
+    // c[i] times 2^-shift, rounded
+    double to_double(size_t i, long shift) const {
+        const uint64_t* v = value(i);
+        const bool negative = v[width - 1] >> 63;
+        double result = 0.0;
+        uint64_t carry = 1;
+        for (size_t k = 0; k < width; ++k) {
+            uint64_t limb = v[k];
+            if (negative) {
+                limb = ~limb + carry;
+                carry = carry && limb == 0;
+            }
+            result += std::ldexp(static_cast<double>(limb), static_cast<int>(64 * static_cast<long>(k) - shift));
+        }
+        return negative ? -result : result;
+    }
+
+    // Room for every value times 2^headroom
+    void fit(size_t headroom) {
+        size_t bits = 0;
+        for (size_t i = 0; i < count; ++i) {
+            bits = std::max(bits, bit_length(i));
+        }
+        const size_t limbs = (bits + headroom + 1) / 64 + 1;
+        if (limbs > width || limbs + 2 < width) {
+            std::vector<uint64_t> resized(count * limbs);
+            for (size_t i = 0; i < count; ++i) {
+                const uint64_t* v = value(i);
+                const uint64_t extension = v[width - 1] >> 63 ? ~uint64_t(0) : 0;
+                for (size_t k = 0; k < limbs; ++k) {
+                    resized[i * limbs + k] = k < width ? v[k] : extension;
+                }
+            }
+            data = std::move(resized);
+            width = limbs;
+        }
+    }
+    // c[target] += c[source]
+    void add(size_t target, size_t source) {
+        uint64_t* a = value(target);
+        const uint64_t* b = value(source);
+        uint64_t carry = 0;
+        for (size_t k = 0; k < width; ++k) {
+            const uint64_t partial = a[k] + carry;
+            const uint64_t sum = partial + b[k];
+            carry = static_cast<uint64_t>(partial < carry) + static_cast<uint64_t>(sum < partial);
+            a[k] = sum;
+        }
+    }
+    void negate(size_t i) {
+        uint64_t* v = value(i);
+        uint64_t carry = 1;
+        for (size_t k = 0; k < width; ++k) {
+            v[k] = ~v[k] + carry;
+            carry = carry && v[k] == 0;
+        }
+    }
+    void shift_left(size_t i, size_t bits) {
+        uint64_t* v = value(i);
+        const size_t limbs = bits / 64;
+        const unsigned shift = bits % 64;
+        for (size_t k = width; k-- > 0;) {
+            const uint64_t high = k >= limbs ? v[k - limbs] : 0;
+            const uint64_t low = k >= limbs + 1 ? v[k - limbs - 1] : 0;
+            v[k] = shift == 0 ? high : high << shift | low >> (64 - shift);
+        }
+    }
+    // Divides out the common power of two
+    void divide_out_twos() {
+        size_t shift = std::numeric_limits<size_t>::max();
+        for (size_t i = 0; i < count; ++i) {
+            const uint64_t* v = value(i);
+            for (size_t k = 0; k < width && 64 * k < shift; ++k) {
+                if (v[k] != 0) {
+                    shift = std::min(shift, 64 * k + limb_trailing_zeros(v[k]));
+                    break;
+                }
+            }
+        }
+        if (shift == 0 || shift == std::numeric_limits<size_t>::max()) {
+            return;
+        }
+        const size_t limbs = shift / 64;
+        const unsigned bits = shift % 64;
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t* v = value(i);
+            const uint64_t extension = v[width - 1] >> 63 ? ~uint64_t(0) : 0;
+            for (size_t k = 0; k < width; ++k) {
+                const uint64_t low = k + limbs < width ? v[k + limbs] : extension;
+                const uint64_t high = k + limbs + 1 < width ? v[k + limbs + 1] : extension;
+                v[k] = bits == 0 ? low : low >> bits | high << (64 - bits);
+            }
+        }
+    }
+    void erase_front() {
+        data.erase(data.begin(), data.begin() + width);
+        --count;
+    }
+    void reverse() {
+        for (size_t i = 0, j = count - 1; i < j; ++i, --j) {
+            std::swap_ranges(value(i), value(i) + width, value(j));
+        }
+    }
+    // c(x + 1), in place; values grow by at most 2^(n + 1)
+    void taylor_shift() {
+        fit(count + 1);
+        for (size_t i = 0; i + 1 < count; ++i) {
+            for (size_t j = count - 1; j-- > i;) {
+                add(j, j + 1);
+            }
+        }
+    }
+
+private:
+    std::vector<uint64_t> data;
+    size_t width;
+    size_t count;
+
+    uint64_t* value(size_t i) { return data.data() + i * width; }
+    const uint64_t* value(size_t i) const { return data.data() + i * width; }
+};
+
+// By ascending power
+using Coefficients = std::vector<double>;
+
+// Bisection depth at which an interval still holding several roots is no longer split
+const int MAX_DEPTH = 64;
+
+double horner(const Coefficients& c, double x, double& derivative) {
+    double value = 0.0;
+    derivative = 0.0;
+    for (size_t i = c.size(); i-- > 0;) {
+        derivative = derivative * x + value;
+        value = value * x + c[i];
+    }
+    return value;
+}
+
+// Coefficients of terms (power, ratio), powers from 0, times the power of two that makes every
+// float an integer
+Integers exact_coefficients(const std::map<int, float>& terms) {
+    int lowest = std::numeric_limits<int>::max();
+    for (const auto& term : terms) {
+        int exponent;
+        std::frexp(term.second, &exponent);
+        lowest = std::min(lowest, exponent - std::numeric_limits<float>::digits);
+    }
+    Integers c(static_cast<size_t>(terms.rbegin()->first) + 1);
+    for (const auto& term : terms) {
+        int exponent;
+        const double mantissa = std::frexp(term.second, &exponent);
+        BigInt& value = c[term.first];
+        value = BigInt(static_cast<int64_t>(std::ldexp(mantissa, std::numeric_limits<float>::digits)));
+        value.shift_left(static_cast<size_t>(exponent - std::numeric_limits<float>::digits - lowest));
+    }
+    return c;
+}
+
+// lead(b)^k * a = quotient * b for k = deg a - deg b + 1; a power of lead(b) changes no sign
+// pattern, so the quotient is as good as a / b for Descartes' rule. False if b does not divide a.
+bool pseudo_divide(const Integers& a, const Integers& b, Integers& quotient) {
+    const size_t m = b.size();
+    Integers rest(a);
+    quotient.assign(a.size() - m + 1, BigInt());
+    for (size_t i = quotient.size(); i-- > 0;) {
+        const BigInt top = rest[i + m - 1];
+        for (size_t j = i + 1; j < quotient.size(); ++j) {
+            quotient[j] = quotient[j] * b.back();
+        }
+        for (size_t j = 0; j + 1 < i + m; ++j) {
+            rest[j] = rest[j] * b.back();
+        }
+        quotient[i] = top;
+        rest[i + m - 1] = BigInt();
+        for (size_t j = 0; j + 1 < m; ++j) {
+            rest[i + j] -= top * b[j];
+        }
+    }
+    for (const BigInt& value : rest) {
+        if (value.sign() != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t sign_variations(const WideCoefficients& c) {
+    size_t variations = 0;
+    int previous = 0;
+    for (size_t i = 0; i < c.size(); ++i) {
+        const int sign = c.sign(i);
+        if (sign != 0) {
+            if (previous != 0 && sign != previous) {
+                ++variations;
+            }
+            previous = sign;
+        }
+    }
+    return variations;
+}
+
+// Descartes' rule on (0, 1): sign variations of (1 + x)^n c(1 / (1 + x)) bound the roots there and
+// have their parity; 0 and 1 are exact. Only 0, 1 or more matters, and pass i of the Taylor shift
+// leaves coefficient i final, so the shift stops at the second variation. transformed is scratch.
+size_t descartes_bound(const WideCoefficients& c, WideCoefficients& transformed) {
+    if (sign_variations(c) == 0) {
+        return 0;
+    }
+    transformed = c;
+    transformed.reverse();
+    transformed.fit(transformed.size() + 1);
+    const size_t n = transformed.size() - 1;
+    size_t variations = 0;
+    int previous = 0;
+    for (size_t i = 0; i <= n; ++i) {
+        for (size_t j = n; j-- > i;) {
+            transformed.add(j, j + 1);
+        }
+        const int sign = transformed.sign(i);
+        if (sign != 0) {
+            if (previous != 0 && sign != previous) {
+                if (++variations == 2) {
+                    return variations;
+                }
+            }
+            previous = sign;
+        }
+    }
+    return variations;
+}
+
+// Sign of c just right of 0 and just left of 1; c(0) != 0, and at a root in 1, which is simple,
+// the sign there is that of -c'(1). Suffix sums s_k = c_k + ... + c_n give c(1) = s_0 and
+// c'(1) = s_1 + ... + s_n.
+std::pair<int, int> end_signs(const WideCoefficients& c) {
+    WideCoefficients sums(c);
+    sums.fit(2 * sums.size());
+    for (size_t k = sums.size() - 1; k-- > 0;) {
+        sums.add(k, k + 1);
+    }
+    const int at_one = sums.sign(0);
+    for (size_t k = sums.size() - 1; k-- > 1;) {
+        sums.add(k, k + 1);
+    }
+    return { c.sign(0), at_one != 0 ? at_one : -sums.sign(1) };
+}
+
+struct Isolated {
+    double lo;
+    double hi;
+    bool negative_at_lo;
+};
+
+// Vincent-Collins-Akritas bisection of the roots of q(sign * x) in (0, 2^exponent): each interval
+// carries q(sign * x) moved onto (0, 1), up to a positive factor. Appends the intervals (in the
+// coordinates of q) with a sign change between their ends to intervals, and roots hit exactly by a
+// bisection point to roots.
+void isolate(const WideCoefficients& q, double sign, int exponent, std::vector<Isolated>& intervals,
+    std::vector<double>& roots) {
+    struct Interval {
+        WideCoefficients c;
+        double lo;
+        double width;
+        int depth;
+    };
+    WideCoefficients start(q);
+    start.fit(start.size() * static_cast<size_t>(exponent));
+    for (size_t i = 0; i < start.size(); ++i) {
+        start.shift_left(i, i * static_cast<size_t>(exponent));
+        if (sign < 0.0 && i % 2) {
+            start.negate(i);
+        }
+    }
+    start.divide_out_twos();
+
+    WideCoefficients scratch(start);
+    std::vector<Interval> pending;
+    pending.push_back({ std::move(start), 0.0, std::ldexp(1.0, exponent), 0 });
+    while (!pending.empty()) {
+        Interval current = std::move(pending.back());
+        pending.pop_back();
+        const size_t count = descartes_bound(current.c, scratch);
+        if (count == 0) {
+            continue;
+        }
+        // One root, or a cluster narrower than the bisection goes: kept only with a sign change,
+        // which a single simple root always has
+        if (count == 1 || current.depth == MAX_DEPTH) {
+            const std::pair<int, int> ends = end_signs(current.c);
+            if (ends.first != ends.second) {
+                const double hi = current.lo + current.width;
+                intervals.push_back(sign > 0.0 ? Isolated{ current.lo, hi, ends.first < 0 }
+                    : Isolated{ -hi, -current.lo, ends.second < 0 });
+            }
+            continue;
+        }
+        const double half = current.width / 2.0;
+        // left half: 2^n c(x / 2); right half: 2^n c((x + 1) / 2)
+        WideCoefficients left(std::move(current.c));
+        left.fit(left.size());
+        for (size_t i = 0; i < left.size(); ++i) {
+            left.shift_left(i, left.size() - 1 - i);
+        }
+        WideCoefficients right(left);
+        right.taylor_shift();
+        if (right.sign(0) == 0) {
+            roots.push_back(sign * (current.lo + half));
+            while (right.sign(0) == 0) {
+                right.erase_front();
+            }
+        }
+        left.divide_out_twos();
+        right.divide_out_twos();
+        pending.push_back({ std::move(right), current.lo + half, half, current.depth + 1 });
+        pending.push_back({ std::move(left), current.lo, half, current.depth + 1 });
+    }
+}
+
+// Newton steps kept inside an interval with a verified sign change. A step that leaves the interval
+// or is not at most half the one before is replaced by bisection, so the interval keeps shrinking
+// even where Newton converges slowly (far from a root of x^n).
+double refine(const Coefficients& q, const Isolated& interval) {
+    double lo = interval.lo;
+    double hi = interval.hi;
+    double x = lo + (hi - lo) / 2.0;
+    double previous_step = hi - lo;
+    for (int iteration = 0; iteration < 400; ++iteration) {
+        double derivative;
+        const double f = horner(q, x, derivative);
+        if (f == 0.0) {
+            break;
+        }
+        if ((f < 0.0) == interval.negative_at_lo) {
+            lo = x;
+        }
+        else {
+            hi = x;
+        }
+        double next = x - f / derivative;
+        if (!(next > lo && next < hi) || !(2.0 * std::abs(next - x) <= previous_step)) {
+            next = lo + (hi - lo) / 2.0;
+        }
+        previous_step = std::abs(next - x);
+        if (next == x || next == lo || next == hi) {
+            break;
+        }
+        x = next;
+    }
+    return x;
+}
+
+}
+
+std::vector<double> Polynom::real_roots() const {
+    if (size() == 0) {
+        throw std::invalid_argument("Polynom::real_roots: every point is a root of the zero polynom");
+    }
+    if (!is_univariate()) {
+        throw std::invalid_argument("Polynom::real_roots: needs a polynom in x only");
+    }
+    // x^low * r(x) with r(0) != 0: 0 is a root exactly when low > 0, a pole when low < 0
+    std::map<int, float> terms;
+    for_each_term_unordered([&terms](float ratio, const int* powers) {
+        terms.emplace(powers[0], ratio);
+    });
+    const int low = terms.begin()->first;
+    std::map<int, float> shifted;
+    PolynomBuilder builder;
+    for (const auto& term : terms) {
+        shifted.emplace(term.first - low, term.second);
+        builder.add(term.second, term.first - low, 0, 0);
+    }
+    Polynom r = builder.build();
+
+    std::vector<double> roots;
+    if (low > 0) {
+        roots.push_back(0.0);
+    }
+    if (r.degree(0) == 0) {
+        return roots;
+    }
+
+    // Square-free part r / gcd(r, r'), exactly; its roots are simple, so every isolating interval
+    // has a sign change. Coefficients too large for the exact gcd leave r as it is, and roots of
+    // even multiplicity are then missed.
+    const Integers exact = exact_coefficients(shifted);
+    Integers q = exact;
+    try {
+        const Polynom common = r.gcd(r.derivative(0));
+        if (common.degree(0) > 0) {
+            std::map<int, float> divisor;
+            common.for_each_term_unordered([&divisor](float ratio, const int* powers) {
+                divisor.emplace(powers[0], ratio);
+            });
+            if (!pseudo_divide(exact, exact_coefficients(divisor), q)) {
+                q = exact;
+            }
+        }
+    }
+    catch (const std::out_of_range&) {
+    }
+    WideCoefficients wide(q);
+    wide.divide_out_twos();
+
+    size_t bits = 0;
+    for (size_t i = 0; i < wide.size(); ++i) {
+        bits = std::max(bits, wide.bit_length(i));
+    }
+    Coefficients values(wide.size());
+    for (size_t i = 0; i < wide.size(); ++i) {
+        values[i] = wide.to_double(i, static_cast<long>(bits) - 60);
+    }
+    // Cauchy: every root is below 1 + max |q_i / q_n|, taken in doubles with a margin for rounding.
+    // If q_n underflows, 1 + 2^(bits of q_i - bits of q_n + 2) bounds it too (bit_length() may
+    // count a bit less).
+    double bound = 0.0;
+    for (size_t i = 0; i + 1 < values.size(); ++i) {
+        bound = std::max(bound, std::abs(values[i] / values.back()));
+    }
+    int exponent;
+    if (std::isfinite(bound) && std::abs(values.back()) >= std::numeric_limits<double>::min()) {
+        std::frexp((bound + 1.0) * (1.0 + 0x1p-40), &exponent);
+    }
+    else {
+        exponent = std::max(static_cast<int>(bits) - static_cast<int>(wide.bit_length(wide.size() - 1)) + 2, 0) + 1;
+    }
+
+    std::vector<Isolated> intervals;
+    isolate(wide, 1.0, exponent, intervals, roots);
+    isolate(wide, -1.0, exponent, intervals, roots);
+    for (const Isolated& interval : intervals) {
+        roots.push_back(refine(values, interval));
+    }
+    std::sort(roots.begin(), roots.end());
+    roots.erase(std::unique(roots.begin(), roots.end()), roots.end());
+    return roots;
+}
+
+std::vector<std::vector<double>> Polynom::real_roots(const std::vector<Polynom>& polynoms) {
+    std::vector<std::vector<double>> result(polynoms.size());
+    size_t threads = polynoms.size() >= PARALLEL_ROOTS_MIN_COUNT ? std::min(parallel_threads(), polynoms.size()) : 1;
+    // Degrees differ, so the threads take polynoms one at a time instead of in fixed chunks
+    std::atomic<size_t> next(0);
+    run_parallel(threads, [&](size_t) {
+        for (size_t i = next++; i < polynoms.size(); i = next++) {
+            result[i] = polynoms[i].real_roots();
+        }
+    });
+    return result;
+}
@@ -0,0 +1,179 @@
+#include "polynom_system.h"
+#include "polynom_parallel.h"
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <map>
+#include <utility>
+#include <vector>
+
+const size_t PolynomSystem::BATCH;
+
+using MonomKey = std::array<int, 3>;
+
+static int64_t monom_norm(const MonomKey& key) {
+    return std::llabs(key[0]) + std::llabs(key[1]) + std::llabs(key[2]);
+}
+
+// key with one power moved one step toward zero; factor is what multiplies it back
+static MonomKey monom_parent(const MonomKey& key, size_t var, uint32_t& factor) {
+    MonomKey parent = key;
+    if (key[var] > 0) {
+        --parent[var];
+        factor = static_cast<uint32_t>(var);
+    }
+    else {
+        ++parent[var];
+        factor = static_cast<uint32_t>(var + 3);
+    }
+    return parent;
+}
+
+PolynomSystem::PolynomSystem(const std::vector<Polynom>& polynoms) {
+    std::vector<std::vector<std::pair<MonomKey, double>>> entries(polynoms.size());
+    // monom -> (parent, factor); the constant 1 has no parent
+    std::map<MonomKey, std::pair<MonomKey, uint32_t>> monoms;
+    const MonomKey one = { 0, 0, 0 };
+    monoms.emplace(one, std::make_pair(one, 0u));
+    for (size_t p = 0; p < polynoms.size(); ++p) {
+        polynoms[p].for_each_term_unordered([&](float ratio, const int* powers) {
+            MonomKey key = { powers[0], powers[1], powers[2] };
+            entries[p].emplace_back(key, ratio);
+            monoms.emplace(key, std::make_pair(one, 0u));
+        });
+    }
+
+    // Prefer a parent that is already needed; otherwise lower z, then y, then x and add the parent
+    // as a helper, which finds its own parent the same way
+    std::vector<MonomKey> pending;
+    for (const auto& item : monoms) {
+        pending.push_back(item.first);
+    }
+    while (!pending.empty()) {
+        MonomKey key = pending.back();
+        pending.pop_back();
+        if (key == one) {
+            continue;
+        }
+        uint32_t factor = 0;
+        MonomKey parent = one;
+        bool found = false;
+        for (size_t var = 3; var-- > 0 && !found;) {
+            if (key[var] != 0) {
+                parent = monom_parent(key, var, factor);
+                found = monoms.count(parent) != 0;
+            }
+        }
+        if (!found) {
+            size_t var = key[2] != 0 ? 2 : key[1] != 0 ? 1 : 0;
+            parent = monom_parent(key, var, factor);
+            if (monoms.emplace(parent, std::make_pair(one, 0u)).second) {
+                pending.push_back(parent);
+            }
+        }
+        monoms[key] = std::make_pair(parent, factor);
+    }
+
+    std::vector<MonomKey> order;
+    order.reserve(monoms.size());
+    for (const auto& item : monoms) {
+        order.push_back(item.first);
+    }
+    std::stable_sort(order.begin(), order.end(), [](const MonomKey& a, const MonomKey& b) {
+        return monom_norm(a) < monom_norm(b);
+    });
+    std::map<MonomKey, uint32_t> index;
+    for (size_t m = 0; m < order.size(); ++m) {
+        index.emplace(order[m], static_cast<uint32_t>(m));
+    }
+    steps.reserve(order.size() - 1);
+    for (size_t m = 1; m < order.size(); ++m) {
+        const std::pair<MonomKey, uint32_t>& source = monoms[order[m]];
+        steps.push_back({ index[source.first], source.second });
+        uses_inverse = uses_inverse || source.second >= 3;
+    }
+
+    for (const std::vector<std::pair<MonomKey, double>>& polynom : entries) {
+        for (const std::pair<MonomKey, double>& entry : polynom) {
+            monom_index.push_back(index[entry.first]);
+            ratios.push_back(entry.second);
+        }
+        offsets.push_back(ratios.size());
+    }
+}
+
+size_t PolynomSystem::size() const {
+    return offsets.size() - 1;
+}
+
+size_t PolynomSystem::monom_count() const {
+    return steps.size() + 1;
+}
+
+void PolynomSystem::evaluate(double x, double y, double z, double* values) const {
+    evaluate_range(&x, &y, &z, 0, 1, 1, values);
+}
+
+std::vector<double> PolynomSystem::evaluate(double x, double y, double z) const {
+    std::vector<double> values(size());
+    evaluate(x, y, z, values.data());
+    return values;
+}
+
+void PolynomSystem::evaluate_batch(const double* xs, const double* ys, const double* zs, size_t count, double* out) const {
+    if (count == 0) {
+        return;
+    }
+    size_t batches = (count + BATCH - 1) / BATCH;
+    size_t work = (monom_count() + ratios.size()) * count;
+    size_t threads = work >= Polynom::PARALLEL_EVALUATE_MIN_WORK ? std::min(Polynom::parallel_threads(), batches) : 1;
+    size_t chunk = (batches + threads - 1) / threads * BATCH;
+    run_parallel(threads, [&](size_t t) {
+        size_t begin = std::min(count, t * chunk);
+        size_t end = std::min(count, begin + chunk);
+        evaluate_range(xs, ys, zs, begin, end, count, out);
+    });
+}
+
+void PolynomSystem::evaluate_range(const double* xs, const double* ys, const double* zs, size_t begin, size_t end,
+    size_t count, double* out) const {
+    // values[m * BATCH + k] is monom m at point k of the batch
+    std::vector<double> values(monom_count() * BATCH);
+    for (size_t start = begin; start < end; start += BATCH) {
+        size_t length = std::min(BATCH, end - start);
+        double factors[6][BATCH];
+        for (size_t k = 0; k < BATCH; ++k) {
+            factors[0][k] = k < length ? xs[start + k] : 1.0;
+            factors[1][k] = k < length ? ys[start + k] : 1.0;
+            factors[2][k] = k < length ? zs[start + k] : 1.0;
+            values[k] = 1.0;
+        }
+        if (uses_inverse) {
+            for (size_t var = 0; var < 3; ++var) {
+                for (size_t k = 0; k < BATCH; ++k) {
+                    factors[var + 3][k] = 1.0 / factors[var][k];
+                }
+            }
+        }
+        for (size_t m = 1; m < monom_count(); ++m) {
+            const Step& step = steps[m - 1];
+            const double* parent = values.data() + step.parent * BATCH;
+            const double* factor = factors[step.factor];
+            double* current = values.data() + m * BATCH;
+            for (size_t k = 0; k < BATCH; ++k) {
+                current[k] = parent[k] * factor[k];
+            }
+        }
+        for (size_t p = 0; p < size(); ++p) {
+            double acc[BATCH] = {};
+            for (size_t e = offsets[p]; e < offsets[p + 1]; ++e) {
+                const double ratio = ratios[e];
+                const double* monom = values.data() + monom_index[e] * BATCH;
+                for (size_t k = 0; k < BATCH; ++k) {
+                    acc[k] += ratio * monom[k];
+                }
+            }
+            std::copy(acc, acc + length, out + p * count + start);
+        }
+    }
+}
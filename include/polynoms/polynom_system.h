@@ -0,0 +1,47 @@
+#pragma once
+
+#include "polynoms.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Several polynoms evaluated together at the same points. The union of their monoms is computed
+// once per point: monoms are ordered so that each one is an earlier monom times x, y or z (or their
+// inverses for negative powers), with helper monoms filling the gaps, and every polynom is then a
+// sparse dot product of its ratios with the monom values.
+class PolynomSystem {
+public:
+    // Points evaluated together by evaluate_batch; the per-monom loops run over a whole batch
+    static const size_t BATCH = 8;
+
+    PolynomSystem() = default;
+    explicit PolynomSystem(const std::vector<Polynom>& polynoms);
+
+    size_t size() const;
+    // Distinct monoms evaluated per point, including the helper monoms and the constant 1
+    size_t monom_count() const;
+
+    // values[p] receives polynom p at (x, y, z)
+    void evaluate(double x, double y, double z, double* values) const;
+    std::vector<double> evaluate(double x, double y, double z) const;
+    // Points given as coordinate arrays; out[p * count + i] receives polynom p at point i.
+    // Large inputs are split across Polynom::parallel_threads().
+    void evaluate_batch(const double* xs, const double* ys, const double* zs, size_t count, double* out) const;
+
+private:
+    // monom = monoms[parent] * factor, where factor 0..2 is x, y, z and 3..5 is 1/x, 1/y, 1/z
+    struct Step {
+        uint32_t parent;
+        uint32_t factor;
+    };
+
+    std::vector<Step> steps;            // steps[m - 1] builds monom m; monom 0 is 1
+    bool uses_inverse = false;
+    // Polynom p is the sum of ratios[e] * monom[monom_index[e]] for e in offsets[p] .. offsets[p + 1]
+    std::vector<size_t> offsets{ 0 };
+    std::vector<uint32_t> monom_index;
+    std::vector<double> ratios;
+
+    void evaluate_range(const double* xs, const double* ys, const double* zs, size_t begin, size_t end,
+        size_t count, double* out) const;
+};
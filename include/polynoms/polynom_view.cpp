@@ -0,0 +1,118 @@
+#include "polynom_view.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+size_t TermView::size() const {
+    if (excluded == 0) {
+        return count;
+    }
+    return static_cast<size_t>(std::distance(begin(), end()));
+}
+
+TermView TermView::without(size_t var) const {
+    if (var > 2) {
+        throw std::out_of_range("TermView::without: var must be 0 (x), 1 (y) or 2 (z)");
+    }
+    TermView view = *this;
+    view.excluded |= 1u << var;
+    return view;
+}
+
+Polynom TermView::to_polynom() const {
+    Polynom result;
+    result.terms.reserve(size());
+    for (const PolyTerm& term : *this) {
+        result.terms.push_back(term);
+    }
+    result.refresh();
+    return result;
+}
+
+
+DegreeIndex::DegreeIndex(const Polynom& p) {
+    if (p.dense) {
+        listed.reserve(p.size());
+        p.for_each_term([this](float ratio, const int* powers) {
+            listed.push_back(make_term(ratio, powers));
+        });
+    }
+    else {
+        source = &p;
+    }
+    const PolyTerm* base = terms();
+    const size_t count = size();
+    if (count > std::numeric_limits<uint32_t>::max()) {
+        throw std::out_of_range("DegreeIndex: too many terms");
+    }
+
+    // Both orders are stable, so each degree keeps polynom order: counting sort when the degrees
+    // span at most COUNTING_SPAN per term, a comparison sort otherwise
+    const int64_t COUNTING_SPAN = 4;
+    positions.resize(count);
+    int low = 0;
+    int high = -1;
+    for (size_t i = 0; i < count; ++i) {
+        low = i == 0 ? base[i].degree : std::min(low, base[i].degree);
+        high = i == 0 ? base[i].degree : std::max(high, base[i].degree);
+    }
+    const int64_t span = static_cast<int64_t>(high) - low + 1;
+    if (span <= COUNTING_SPAN * static_cast<int64_t>(count) + 1) {
+        std::vector<size_t> starts(static_cast<size_t>(span) + 1, 0);
+        for (size_t i = 0; i < count; ++i) {
+            ++starts[static_cast<size_t>(base[i].degree - low) + 1];
+        }
+        for (size_t d = 1; d < starts.size(); ++d) {
+            starts[d] += starts[d - 1];
+        }
+        for (size_t i = 0; i < count; ++i) {
+            positions[starts[static_cast<size_t>(base[i].degree - low)]++] = static_cast<uint32_t>(i);
+        }
+    }
+    else {
+        for (size_t i = 0; i < count; ++i) {
+            positions[i] = static_cast<uint32_t>(i);
+        }
+        std::stable_sort(positions.begin(), positions.end(), [base](uint32_t a, uint32_t b) {
+            return base[a].degree < base[b].degree;
+        });
+    }
+    for (size_t i = 0; i < count; ++i) {
+        const int degree = base[positions[i]].degree;
+        if (distinct.empty() || distinct.back() != degree) {
+            distinct.push_back(degree);
+            offsets.push_back(i);
+        }
+    }
+    offsets.push_back(count);
+}
+
+const PolyTerm* DegreeIndex::terms() const {
+    return source ? source->terms.data() : listed.data();
+}
+
+size_t DegreeIndex::size() const {
+    return source ? source->terms.size() : listed.size();
+}
+
+const std::vector<int>& DegreeIndex::degrees() const {
+    return distinct;
+}
+
+TermView DegreeIndex::all() const {
+    return TermView(terms(), nullptr, size());
+}
+
+TermView DegreeIndex::degree(int k) const {
+    auto found = std::lower_bound(distinct.begin(), distinct.end(), k);
+    if (found == distinct.end() || *found != k) {
+        return TermView();
+    }
+    const size_t slice = static_cast<size_t>(found - distinct.begin());
+    return TermView(terms(), positions.data() + offsets[slice], offsets[slice + 1] - offsets[slice]);
+}
+
+TermView DegreeIndex::leading(size_t k) const {
+    return TermView(terms(), nullptr, std::min(k, size()));
+}
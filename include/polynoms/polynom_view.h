@@ -0,0 +1,125 @@
+#pragma once
+
+#include "polynoms.h"
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+// Non-owning range of the terms of a polynom, in polynom order: a run of the stored terms or the
+// positions of a degree slice, optionally filtered to terms without some vars. Nothing is copied
+// until to_polynom(). A view is invalidated by any change to the polynom it refers to, and by a
+// change to or move of the DegreeIndex it came from.
+class TermView {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = PolyTerm;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const PolyTerm*;
+        using reference = const PolyTerm&;
+
+        iterator() = default;
+
+        reference operator*() const { return term(); }
+        pointer operator->() const { return &term(); }
+        iterator& operator++() {
+            ++index;
+            skip();
+            return *this;
+        }
+        iterator operator++(int) {
+            iterator old = *this;
+            ++*this;
+            return old;
+        }
+        bool operator==(const iterator& oth) const { return index == oth.index; }
+        bool operator!=(const iterator& oth) const { return index != oth.index; }
+
+    private:
+        friend class TermView;
+
+        const PolyTerm* base = nullptr;
+        const uint32_t* positions = nullptr;
+        size_t count = 0;
+        unsigned excluded = 0;
+        size_t index = 0;
+
+        iterator(const TermView& view, size_t index)
+            : base(view.base), positions(view.positions), count(view.count), excluded(view.excluded), index(index) {
+            skip();
+        }
+
+        const PolyTerm& term() const { return positions ? base[positions[index]] : base[index]; }
+        void skip() {
+            if (excluded == 0) {
+                return;
+            }
+            for (; index < count; ++index) {
+                const int* powers = term().powers;
+                if (!((excluded & 1u) && powers[0]) && !((excluded & 2u) && powers[1]) && !((excluded & 4u) && powers[2])) {
+                    return;
+                }
+            }
+        }
+    };
+
+    TermView() = default;
+
+    iterator begin() const { return iterator(*this, 0); }
+    iterator end() const { return iterator(*this, count); }
+    bool empty() const { return begin() == end(); }
+    // O(1) without a filter, one pass over the range with one
+    size_t size() const;
+
+    // Terms of this view where var (x 0, y 1, z 2) has power 0; chains, so
+    // view.without(2) keeps the terms in x and y alone. Throws std::out_of_range for another var.
+    TermView without(size_t var) const;
+
+    // The terms as a Polynom: they are already sorted and distinct, so this is one copy, no merge
+    Polynom to_polynom() const;
+
+private:
+    friend class DegreeIndex;
+
+    const PolyTerm* base = nullptr;
+    const uint32_t* positions = nullptr;    // nullptr: base[0 .. count - 1] themselves
+    size_t count = 0;
+    unsigned excluded = 0;                  // bit var set: only terms with powers[var] == 0
+
+    TermView(const PolyTerm* base, const uint32_t* positions, size_t count)
+        : base(base), positions(positions), count(count) {}
+};
+
+// Terms of a polynom grouped by total degree. Term positions are sorted by degree once, by counting
+// (or in O(n log n) when the degrees are far apart); a degree slice is then found by binary search
+// over the distinct degrees, O(log n), and views it
+// in polynom order without copying. A sparse polynom is referenced and must outlive the index and
+// stay unchanged; the cells of a dense one are listed once into the index itself.
+class DegreeIndex {
+public:
+    DegreeIndex() = default;
+    explicit DegreeIndex(const Polynom& p);
+    // Would refer to a temporary
+    DegreeIndex(Polynom&&) = delete;
+
+    size_t size() const;
+    // Distinct total degrees, ascending
+    const std::vector<int>& degrees() const;
+
+    TermView all() const;
+    // Homogeneous component of total degree k (empty if there is none)
+    TermView degree(int k) const;
+    // The first k terms in polynom order (all of them if there are fewer)
+    TermView leading(size_t k) const;
+
+private:
+    const PolyTerm* terms() const;
+
+    const Polynom* source = nullptr;                        // sparse polynom, or
+    Polynom::TermStorage listed{ polynom_resource() };     // terms of a dense polynom
+    std::vector<uint32_t> positions;        // by degree, then position
+    std::vector<int> distinct;
+    std::vector<size_t> offsets;            // degree distinct[i] is positions[offsets[i] .. offsets[i + 1] - 1]
+};
@@ -1,4 +1,8 @@
 #include "polynoms.h"
+#include "polynom_parser.h"
+#include "polynom_literal.h"
+#include "polynom_multiply.h"
+#include "polynom_parallel.h"
 #include <iostream>
 #include <string>
 #include <vector>
@@ -6,8 +10,14 @@
 #include <algorithm>    
 #include <cmath>         
 #include <functional>      
-
-const float EPSILON = 1e-6f;
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <optional>
 
 Monom::Monom(float ratio_val, std::vector<int> powers_val) {
     this->ratio = ratio_val;
@@ -111,16 +121,8 @@ bool Monom::operator>(const Monom& oth) const {
     if (!this_is_zero && oth_is_zero) return true;     
     if (this_is_zero && oth_is_zero) return false;       
 
-    int max_this = (powers.empty() ? 0 : *std::max_element(powers.begin(), powers.end()));
-    int max_oth = (oth.powers.empty() ? 0 : *std::max_element(oth.powers.begin(), oth.powers.end()));
-
-    if (max_this > max_oth) return true;
-    if (max_this < max_oth) return false;
-
-    for (size_t i = 0; i < 3; ++i) {
-        if (this->powers[i] > oth.powers[i]) return true;
-        if (this->powers[i] < oth.powers[i]) return false;
-    }
+    int order = compare_powers(powers.data(), oth.powers.data());
+    if (order != 0) return order > 0;
 
     if (this->ratio > oth.ratio) return true;
 
@@ -135,271 +137,937 @@ bool Monom::operator<(const Monom& oth) const {
     if (!this_is_zero && oth_is_zero) return false;    
     if (this_is_zero && oth_is_zero) return false;       
 
-    int max_this = (powers.empty() ? 0 : *std::max_element(powers.begin(), powers.end()));
-    int max_oth = (oth.powers.empty() ? 0 : *std::max_element(oth.powers.begin(), oth.powers.end()));
+    return compare_powers(powers.data(), oth.powers.data()) < 0;
+}
+
+// Writes the monom into out (at least MAX_MONOM_CHARS long), returns the number of chars written
+static size_t format_monom(float ratio, const int* powers, char* out) {
+    char* cur = out;
+    char* end = out + Monom::MAX_MONOM_CHARS;
+    if (std::abs(ratio) < EPSILON) {
+        *cur++ = '0';
+        return 1;
+    }
 
-    if (max_this < max_oth) return true;
-    if (max_this > max_oth) return false;
+    bool all_powers_zero = powers[0] == 0 && powers[1] == 0 && powers[2] == 0;
 
+    if (ratio == -1.0f && !all_powers_zero) {
+        *cur++ = '-';
+    }
+    else if (ratio == 1.0f && !all_powers_zero) {
+    }
+    else {
+        const float LLONG_LIMIT = 9.2e18f;
+        if (std::abs(ratio) < LLONG_LIMIT && ratio == static_cast<long long>(ratio)) {
+            cur = std::to_chars(cur, end, static_cast<long long>(ratio)).ptr;
+        }
+        else {
+            cur = std::to_chars(cur, end, ratio, std::chars_format::general, 6).ptr;
+        }
+    }
+
+    const char vars[] = { 'x', 'y', 'z' };
     for (size_t i = 0; i < 3; ++i) {
-        if (this->powers[i] < oth.powers[i]) return true;
-        if (this->powers[i] > oth.powers[i]) return false;
+        if (powers[i] != 0) {
+            *cur++ = vars[i];
+            if (powers[i] != 1) {
+                *cur++ = '^';
+                cur = std::to_chars(cur, end, powers[i]).ptr;
+            }
+        }
     }
-    return false;   
+    return static_cast<size_t>(cur - out);
+}
+
+void Monom::format_to(std::string& buffer) const {
+    char chars[MAX_MONOM_CHARS];
+    buffer.append(chars, format_monom(ratio, powers.data(), chars));
 }
 
 std::ostream& operator<<(std::ostream& os, const Monom& monom) {
-    if (std::abs(monom.ratio) < EPSILON) {
-        os << 0;
-        return os;
+    char chars[Monom::MAX_MONOM_CHARS];
+    os.write(chars, static_cast<std::streamsize>(format_monom(monom.ratio, monom.powers.data(), chars)));
+    return os;
+}
+
+static bool term_before(const PolyTerm& a, const PolyTerm& b) {
+    return compare_powers(a.powers, b.powers) > 0;
+}
+
+static PolyTerm to_term(const Monom& monom) {
+    return make_term(monom.ratio, monom.powers.data());
+}
+
+static const int PACKED_BIAS = 1 << 15;
+
+// 64-bit key whose ascending order is the polynom order: the biased max power, x, y and z take
+// 16 bits each and the whole key is complemented. Fails for powers outside [-32768, 32767].
+static bool packed_key(const int* powers, uint64_t& key) {
+    int max_power = std::max(powers[0], std::max(powers[1], powers[2]));
+    int min_power = std::min(powers[0], std::min(powers[1], powers[2]));
+    if (min_power < -PACKED_BIAS || max_power >= PACKED_BIAS) {
+        return false;
     }
+    key = ~((static_cast<uint64_t>(max_power + PACKED_BIAS) << 48) |
+        (static_cast<uint64_t>(powers[0] + PACKED_BIAS) << 32) |
+        (static_cast<uint64_t>(powers[1] + PACKED_BIAS) << 16) |
+        static_cast<uint64_t>(powers[2] + PACKED_BIAS));
+    return true;
+}
 
-    bool all_powers_zero = true;
-    for (int p : monom.powers) {
-        if (p != 0) {
-            all_powers_zero = false;
-            break;
+static void unpack_key(uint64_t key, int* powers) {
+    key = ~key;
+    powers[0] = static_cast<int>((key >> 32) & 0xFFFF) - PACKED_BIAS;
+    powers[1] = static_cast<int>((key >> 16) & 0xFFFF) - PACKED_BIAS;
+    powers[2] = static_cast<int>(key & 0xFFFF) - PACKED_BIAS;
+}
+
+// Stable LSD radix sort of (key, ratio) pairs, one byte per pass; passes where every key has the
+// same byte are skipped. tmp_keys/tmp_ratios are scratch of the same size; returns true if the
+// sorted pairs ended up there rather than in keys/ratios.
+static bool radix_sort_pairs(uint64_t* keys, float* ratios, uint64_t* tmp_keys, float* tmp_ratios, size_t n) {
+    const size_t RADIX = 256;
+    const size_t PASSES = sizeof(uint64_t);
+    if (n == 0) {
+        return false;
+    }
+    size_t counts[PASSES][RADIX] = {};
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t pass = 0; pass < PASSES; ++pass) {
+            counts[pass][(keys[i] >> (8 * pass)) & 0xFF]++;
         }
     }
 
-    if (monom.ratio == -1.0f && !all_powers_zero) {
-        os << "-";
+    bool swapped = false;
+    for (size_t pass = 0; pass < PASSES; ++pass) {
+        size_t* count = counts[pass];
+        if (count[(keys[0] >> (8 * pass)) & 0xFF] == n) {
+            continue;
+        }
+        size_t offset = 0;
+        for (size_t digit = 0; digit < RADIX; ++digit) {
+            size_t bucket = count[digit];
+            count[digit] = offset;
+            offset += bucket;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            size_t pos = count[(keys[i] >> (8 * pass)) & 0xFF]++;
+            tmp_keys[pos] = keys[i];
+            tmp_ratios[pos] = ratios[i];
+        }
+        std::swap(keys, tmp_keys);
+        std::swap(ratios, tmp_ratios);
+        swapped = !swapped;
     }
-    else if (monom.ratio == 1.0f && !all_powers_zero) {
+    return swapped;
+}
+
+// Combines runs of equal keys, drops zero sums and decodes the powers into out; returns the term count
+static size_t merge_sorted_pairs(const uint64_t* keys, const float* ratios, size_t n, PolyTerm* out) {
+    size_t count = 0;
+    for (size_t i = 0; i < n;) {
+        uint64_t key = keys[i];
+        float ratio = ratios[i];
+        size_t j = i + 1;
+        for (; j < n && keys[j] == key; ++j) {
+            ratio += ratios[j];
+        }
+        if (std::abs(ratio) > EPSILON) {
+            int powers[3];
+            unpack_key(key, powers);
+            out[count++] = make_term(ratio, powers);
+        }
+        i = j;
     }
-    else {
-        if (monom.ratio == static_cast<long long>(monom.ratio)) {
-            os << static_cast<long long>(monom.ratio);
+    return count;
+}
+
+// Normalizes unsorted terms by radix sorting packed keys, moving only (key, ratio) pairs.
+// With several threads the keys are split into key ranges by sampled splitters, every range is
+// sorted and merged on its own thread and the results are concatenated. The split keeps input order
+// within a range, so like terms are summed in the same order as by the serial path.
+// Returns false (terms untouched) if a power does not fit the packed key.
+static bool radix_normalize(PolyTerm* terms, size_t n, size_t threads, size_t& out_count) {
+    std::unique_ptr<uint64_t[]> keys(new uint64_t[2 * n]);
+    std::unique_ptr<float[]> ratios(new float[2 * n]);
+    uint64_t* src_keys = keys.get();
+    float* src_ratios = ratios.get();
+    uint64_t* part_keys = keys.get() + n;
+    float* part_ratios = ratios.get() + n;
+
+    std::atomic<bool> packed(true);
+    const size_t chunk = (n + threads - 1) / threads;
+    run_parallel(threads, [&](size_t t) {
+        size_t end = std::min(n, (t + 1) * chunk);
+        for (size_t i = t * chunk; i < end; ++i) {
+            if (!packed_key(terms[i].powers, src_keys[i])) {
+                packed = false;
+                return;
+            }
+            src_ratios[i] = terms[i].ratio;
         }
-        else {
-            os << monom.ratio;
+    });
+    if (!packed) {
+        return false;
+    }
+
+    if (threads == 1) {
+        bool in_tmp = radix_sort_pairs(src_keys, src_ratios, part_keys, part_ratios, n);
+        out_count = in_tmp ? merge_sorted_pairs(part_keys, part_ratios, n, terms)
+            : merge_sorted_pairs(src_keys, src_ratios, n, terms);
+        return true;
+    }
+
+    // Splitters from a sorted sample; equal keys always land in the same range
+    const size_t SAMPLES_PER_THREAD = 64;
+    std::vector<uint64_t> sample;
+    for (size_t i = 0; i < threads * SAMPLES_PER_THREAD; ++i) {
+        sample.push_back(src_keys[i * (n / (threads * SAMPLES_PER_THREAD))]);
+    }
+    std::sort(sample.begin(), sample.end());
+    std::vector<uint64_t> splitters;
+    for (size_t t = 1; t < threads; ++t) {
+        splitters.push_back(sample[t * SAMPLES_PER_THREAD]);
+    }
+    auto range_of = [&splitters](uint64_t key) {
+        return static_cast<size_t>(std::upper_bound(splitters.begin(), splitters.end(), key) - splitters.begin());
+    };
+
+    // counts[chunk][range] turn into scatter offsets laid out range by range, chunk by chunk
+    std::vector<size_t> counts(threads * threads, 0);
+    run_parallel(threads, [&](size_t t) {
+        size_t end = std::min(n, (t + 1) * chunk);
+        for (size_t i = t * chunk; i < end; ++i) {
+            counts[t * threads + range_of(src_keys[i])]++;
+        }
+    });
+    std::vector<size_t> range_begin(threads + 1, 0);
+    size_t offset = 0;
+    for (size_t r = 0; r < threads; ++r) {
+        range_begin[r] = offset;
+        for (size_t t = 0; t < threads; ++t) {
+            size_t count = counts[t * threads + r];
+            counts[t * threads + r] = offset;
+            offset += count;
+        }
+    }
+    range_begin[threads] = n;
+    run_parallel(threads, [&](size_t t) {
+        size_t end = std::min(n, (t + 1) * chunk);
+        size_t* cursor = counts.data() + t * threads;
+        for (size_t i = t * chunk; i < end; ++i) {
+            size_t pos = cursor[range_of(src_keys[i])]++;
+            part_keys[pos] = src_keys[i];
+            part_ratios[pos] = src_ratios[i];
         }
+    });
+
+    // Each range is merged into its own slot of terms, then the slots are compacted
+    std::vector<size_t> merged(threads, 0);
+    run_parallel(threads, [&](size_t r) {
+        size_t begin = range_begin[r];
+        size_t size = range_begin[r + 1] - begin;
+        bool in_tmp = radix_sort_pairs(part_keys + begin, part_ratios + begin, src_keys + begin, src_ratios + begin, size);
+        merged[r] = in_tmp ? merge_sorted_pairs(src_keys + begin, src_ratios + begin, size, terms + begin)
+            : merge_sorted_pairs(part_keys + begin, part_ratios + begin, size, terms + begin);
+    });
+    size_t out = 0;
+    for (size_t r = 0; r < threads; ++r) {
+        std::memmove(terms + out, terms + range_begin[r], merged[r] * sizeof(PolyTerm));
+        out += merged[r];
     }
+    out_count = out;
+    return true;
+}
 
-    const char vars[] = { 'x', 'y', 'z' };
-    for (size_t i = 0; i < monom.powers.size() && i < 3; ++i) {
-        if (monom.powers[i] != 0) {
-            os << vars[i];
-            if (monom.powers[i] != 1) {
-                os << "^" << monom.powers[i];
+// Combines runs of equal powers in sorted terms and drops zero sums, returns the new count
+static size_t merge_sorted_terms(PolyTerm* terms, size_t n) {
+    size_t out = 0;
+    for (size_t i = 0; i < n;) {
+        PolyTerm current = terms[i];
+        size_t j = i + 1;
+        while (j < n && compare_powers(current.powers, terms[j].powers) == 0) {
+            current.ratio += terms[j].ratio;
+            ++j;
+        }
+        if (std::abs(current.ratio) > EPSILON) {
+            terms[out++] = current;
+        }
+        i = j;
+    }
+    return out;
+}
+
+// Sorts into polynom order and merges equal powers: insertion sort keeps small inputs allocation-free,
+// bulk input goes through the radix sort, stable_sort covers powers too large for packed keys
+static void sort_and_merge(Polynom::TermStorage& terms) {
+    const size_t SMALL_SORT = 16;
+    const size_t RADIX_SORT_MIN_TERMS = 1024;
+    if (terms.size() <= SMALL_SORT) {
+        for (size_t i = 1; i < terms.size(); ++i) {
+            PolyTerm key = terms[i];
+            size_t j = i;
+            while (j > 0 && term_before(key, terms[j - 1])) {
+                terms[j] = terms[j - 1];
+                --j;
             }
+            terms[j] = key;
         }
     }
-    return os;
+    else {
+        size_t merged = 0;
+        size_t threads = terms.size() >= Polynom::PARALLEL_NORMALIZE_MIN_TERMS ? Polynom::parallel_threads() : 1;
+        if (terms.size() >= RADIX_SORT_MIN_TERMS && radix_normalize(terms.data(), terms.size(), threads, merged)) {
+            terms.resize(merged);
+            return;
+        }
+        std::stable_sort(terms.begin(), terms.end(), term_before);
+    }
+    terms.resize(merge_sorted_terms(terms.data(), terms.size()));
+}
+
+static std::atomic<size_t> parallel_thread_count(0);
+
+void Polynom::set_parallel_threads(size_t count) {
+    parallel_thread_count = count;
+}
+
+size_t Polynom::parallel_threads() {
+    size_t count = parallel_thread_count;
+    if (count == 0) {
+        count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    return count;
 }
 
 void Polynom::normalize() {
-    if (terms.empty()) {
-        return;
+    sort_and_merge(terms);
+    refresh();
+}
+
+
+static uint64_t mix64(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+static uint64_t term_hash(float ratio, const int* powers) {
+    uint32_t bits;
+    std::memcpy(&bits, &ratio, sizeof(bits));
+    uint64_t h = mix64((static_cast<uint64_t>(static_cast<uint32_t>(powers[0])) << 32) | static_cast<uint32_t>(powers[1]));
+    return mix64(h ^ ((static_cast<uint64_t>(static_cast<uint32_t>(powers[2])) << 32) | bits));
+}
+
+// The hash is a sum of term hashes, so it does not depend on term order and can be updated per term
+void Polynom::add_term_metadata(const PolyTerm& term) {
+    content_hash += term_hash(term.ratio, term.powers);
+    max_degree = std::max(max_degree, term.degree);
+    for (size_t i = 0; i < 3; ++i) {
+        var_degree[i] = std::max(var_degree[i], term.powers[i]);
+    }
+    if (leading.ratio == 0.0f || compare_powers(term.powers, leading.powers) > 0) {
+        leading = term;
     }
-    if (terms.size() == 1 && std::abs(terms[0].ratio) < EPSILON) {
-        terms.clear();
+}
+
+void Polynom::rebuild_metadata() {
+    max_degree = ZERO_DEGREE;
+    for (size_t i = 0; i < 3; ++i) {
+        var_degree[i] = ZERO_DEGREE;
+    }
+    leading = { 0.0f, { 0, 0, 0 }, 0 };
+    content_hash = 0;
+    for_each_term_unordered([this](float ratio, const int* powers) {
+        add_term_metadata(make_term(ratio, powers));
+    });
+}
+
+// Called after the coefficient at powers went from old_ratio to new_ratio (0 meaning absent)
+void Polynom::change_term_metadata(const int* powers, float old_ratio, float new_ratio) {
+    if (old_ratio == 0.0f) {
+        add_term_metadata(make_term(new_ratio, powers));
         return;
     }
-    if (terms.size() < 2 && !(terms.size() == 1 && std::abs(terms[0].ratio) < EPSILON)) {       
+    content_hash -= term_hash(old_ratio, powers);
+    if (new_ratio != 0.0f) {
+        content_hash += term_hash(new_ratio, powers);
+        if (compare_powers(powers, leading.powers) == 0) {
+            leading.ratio = new_ratio;
+        }
         return;
     }
+    // A vanished term only matters if it held one of the maxima (the leading term always does)
+    bool extreme = powers[0] + powers[1] + powers[2] == max_degree;
+    for (size_t i = 0; i < 3; ++i) {
+        extreme = extreme || powers[i] == var_degree[i];
+    }
+    if (extreme) {
+        rebuild_metadata();
+    }
+}
 
+void Polynom::copy_metadata(const Polynom& oth) {
+    max_degree = oth.max_degree;
+    std::copy(oth.var_degree, oth.var_degree + 3, var_degree);
+    leading = oth.leading;
+    content_hash = oth.content_hash;
+}
 
-    terms.sort(true);       
+void Polynom::refresh() {
+    rebuild_metadata();
+    update_representation();
+}
 
-    CyclicList<Monom> normalized_terms;
-    auto* current_node_ptr = terms.get_head_node();      
-    if (!current_node_ptr) {          
-        terms = normalized_terms;    
-        return;
+
+static uint64_t box_volume(const int* lo, const int* hi) {
+    uint64_t volume = 1;
+    for (size_t i = 0; i < 3; ++i) {
+        volume *= static_cast<uint64_t>(static_cast<int64_t>(hi[i]) - lo[i] + 1);
+        if (volume > Polynom::DENSE_MAX_VOLUME) {
+            return Polynom::DENSE_MAX_VOLUME + 1;
+        }
+    }
+    return volume;
+}
+
+Polynom::Box Polynom::bounding_box() const {
+    Box box = { { 0, 0, 0 }, { 0, 0, 0 } };
+    if (dense) {
+        for (size_t i = 0; i < 3; ++i) {
+            box.lo[i] = dense_lo[i];
+            box.hi[i] = dense_lo[i] + dense_extent[i] - 1;
+        }
+        return box;
     }
+    bool first = true;
+    for_each_term_unordered([&box, &first](float, const int* powers) {
+        for (size_t i = 0; i < 3; ++i) {
+            if (first || powers[i] < box.lo[i]) box.lo[i] = powers[i];
+            if (first || powers[i] > box.hi[i]) box.hi[i] = powers[i];
+        }
+        first = false;
+    });
+    return box;
+}
 
-    Monom current_aggregate = current_node_ptr->data;
-    current_node_ptr = current_node_ptr->next;     
+bool Polynom::fits_dense(const Box& box, size_t expected_terms) {
+    if (expected_terms < DENSE_MIN_TERMS) {
+        return false;
+    }
+    uint64_t volume = box_volume(box.lo, box.hi);
+    return volume <= DENSE_MAX_VOLUME && expected_terms >= DENSE_ENTER_DENSITY * static_cast<double>(volume);
+}
 
-    for (size_t i = 1; i < terms.size(); ++i) {        
-        const Monom& next_monom = current_node_ptr->data;
+size_t Polynom::dense_index(const int* powers) const {
+    return (static_cast<size_t>(powers[0] - dense_lo[0]) * dense_extent[1] + static_cast<size_t>(powers[1] - dense_lo[1]))
+        * dense_extent[2] + static_cast<size_t>(powers[2] - dense_lo[2]);
+}
 
-        if (current_aggregate.powers == next_monom.powers) {
-            current_aggregate.ratio += next_monom.ratio;
+bool Polynom::dense_contains(const int* powers) const {
+    for (size_t i = 0; i < 3; ++i) {
+        if (powers[i] < dense_lo[i] || powers[i] >= dense_lo[i] + dense_extent[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Polynom::to_dense(const Box& box) {
+    DenseStorage coeffs(box_volume(box.lo, box.hi), 0.0f, dense_coeffs.get_allocator());
+    for (size_t i = 0; i < 3; ++i) {
+        dense_lo[i] = box.lo[i];
+        dense_extent[i] = box.hi[i] - box.lo[i] + 1;
+    }
+    for (const PolyTerm& term : terms) {
+        coeffs[dense_index(term.powers)] = term.ratio;
+    }
+    dense_terms = terms.size();
+    dense_coeffs = std::move(coeffs);
+    terms.reset();
+    dense = true;
+}
+
+void Polynom::to_sparse() {
+    if (!dense) {
+        return;
+    }
+    terms.reserve(dense_terms);
+    for_each_term([this](float ratio, const int* powers) {
+        terms.push_back(make_term(ratio, powers));
+    });
+    dense = false;
+    dense_coeffs = DenseStorage(dense_coeffs.get_allocator());
+    dense_terms = 0;
+    for (size_t i = 0; i < 3; ++i) {
+        dense_lo[i] = 0;
+        dense_extent[i] = 0;
+    }
+}
+
+void Polynom::assign_dense(const Box& box, DenseStorage&& coeffs) {
+    terms.reset();
+    for (size_t i = 0; i < 3; ++i) {
+        dense_lo[i] = box.lo[i];
+        dense_extent[i] = box.hi[i] - box.lo[i] + 1;
+    }
+    dense_terms = 0;
+    for (float& c : coeffs) {
+        if (std::abs(c) < EPSILON) {
+            c = 0.0f;
         }
         else {
-            if (std::abs(current_aggregate.ratio) > EPSILON) {
-                normalized_terms.push_back(current_aggregate);
-            }
-            current_aggregate = next_monom;    
+            dense_terms++;
         }
-        current_node_ptr = current_node_ptr->next;
     }
+    dense_coeffs = std::move(coeffs);
+    dense = true;
+    refresh();
+}
 
-    if (std::abs(current_aggregate.ratio) > EPSILON) {
-        normalized_terms.push_back(current_aggregate);
+void Polynom::update_representation() {
+    if (dense) {
+        if (dense_terms >= DENSE_MIN_TERMS / 2 &&
+            dense_terms >= DENSE_LEAVE_DENSITY * static_cast<double>(dense_coeffs.size())) {
+            return;
+        }
+        to_sparse();
+    }
+    if (terms.size() < DENSE_MIN_TERMS) {
+        return;
+    }
+    Box box = bounding_box();
+    if (fits_dense(box, terms.size())) {
+        to_dense(box);
     }
+}
+
+Polynom Polynom::as_sparse() const {
+    if (!dense) {
+        return *this;
+    }
+    Polynom result;
+    result.terms.reserve(dense_terms);
+    for_each_term([&result](float ratio, const int* powers) {
+        result.terms.push_back(make_term(ratio, powers));
+    });
+    result.copy_metadata(*this);
+    return result;
+}
 
-    terms = std::move(normalized_terms);
+void Polynom::scatter_to(float factor, const Box& box, float* out) const {
+    const size_t extent_y = static_cast<size_t>(box.hi[1] - box.lo[1] + 1);
+    const size_t extent_z = static_cast<size_t>(box.hi[2] - box.lo[2] + 1);
+    if (!dense) {
+        for_each_term_unordered([&](float ratio, const int* powers) {
+            size_t idx = (static_cast<size_t>(powers[0] - box.lo[0]) * extent_y + static_cast<size_t>(powers[1] - box.lo[1]))
+                * extent_z + static_cast<size_t>(powers[2] - box.lo[2]);
+            out[idx] += factor * ratio;
+        });
+        return;
+    }
+    const float* src = dense_coeffs.data();
+    for (int x = 0; x < dense_extent[0]; ++x) {
+        for (int y = 0; y < dense_extent[1]; ++y) {
+            float* dst = out + (static_cast<size_t>(dense_lo[0] + x - box.lo[0]) * extent_y + static_cast<size_t>(dense_lo[1] + y - box.lo[1]))
+                * extent_z + static_cast<size_t>(dense_lo[2] - box.lo[2]);
+            for (int z = 0; z < dense_extent[2]; ++z) {
+                dst[z] += factor * src[z];
+            }
+            src += dense_extent[2];
+        }
+    }
 }
 
 
-Polynom::Polynom(const CyclicList<Monom>& list) : terms(list) {    
-    normalize();
+Polynom::Polynom(const Polynom& oth)
+    : terms(oth.terms, polynom_resource()),
+    dense(oth.dense),
+    dense_coeffs(oth.dense_coeffs, polynom_resource()),
+    dense_terms(oth.dense_terms) {
+    std::copy(oth.dense_lo, oth.dense_lo + 3, dense_lo);
+    std::copy(oth.dense_extent, oth.dense_extent + 3, dense_extent);
+    copy_metadata(oth);
 }
 
-Polynom::Polynom(CyclicList<Monom>&& list) : terms(std::move(list)) {
+Polynom::Polynom(const CyclicList<Monom>& list) {
+    terms.reserve(list.size());
+    auto* node = list.get_head_node();
+    for (size_t count = 0; count < list.size(); ++count) {
+        terms.push_back(to_term(node->data));
+        node = node->next;
+    }
     normalize();
 }
 
+Polynom::Polynom(CyclicList<Monom>&& list) : Polynom(static_cast<const CyclicList<Monom>&>(list)) {
+}
+
+Polynom::Polynom(std::string_view text) {
+    ParseResult status = PolynomParser::parse(text, *this);
+    if (!status.ok()) {
+        throw std::invalid_argument(std::string(status.message()) + " at position " + std::to_string(status.offset) + " in: " + std::string(text));
+    }
+}
+
+Polynom::Polynom(const PolynomLiteral& literal) {
+    terms.reserve(literal.size());
+    for (size_t i = 0; i < literal.size(); ++i) {
+        terms.push_back(literal[i]);
+    }
+    refresh();
+}
+
+size_t Polynom::size() const {
+    return dense ? dense_terms : terms.size();
+}
+
+bool Polynom::is_dense() const {
+    return dense;
+}
+
+int Polynom::degree() const {
+    return max_degree;
+}
+
+int Polynom::degree(size_t var) const {
+    if (var >= 3) {
+        throw std::out_of_range("Polynom::degree: variable index out of range");
+    }
+    return var_degree[var];
+}
+
+Monom Polynom::leading_term() const {
+    if (leading.ratio == 0.0f) {
+        return Monom();
+    }
+    return Monom(leading.ratio, { leading.powers[0], leading.powers[1], leading.powers[2] });
+}
+
+uint64_t Polynom::hash() const {
+    return content_hash;
+}
 
 void Polynom::addMonom(const Monom& monom_to_add) {
     if (std::abs(monom_to_add.ratio) < EPSILON) {
         return;     
     }
 
-    CyclicList<Monom> new_terms;
-    auto* current_node_ptr = terms.get_head_node();
-    size_t count = 0;
-    const size_t original_size = terms.size();
-    bool inserted_or_merged = false;
-
-    while (count < original_size) {
-        const Monom& list_monom = current_node_ptr->data;
-
-        if (!inserted_or_merged) {
-            if (list_monom.powers == monom_to_add.powers) {
-                Monom sum = list_monom;  
-                sum.ratio += monom_to_add.ratio;
-                if (std::abs(sum.ratio) > EPSILON) {
-                    new_terms.push_back(sum);
-                }
-                inserted_or_merged = true;
+    if (dense) {
+        if (dense_contains(monom_to_add.powers.data())) {
+            float& cell = dense_coeffs[dense_index(monom_to_add.powers.data())];
+            float old_ratio = cell;
+            cell += monom_to_add.ratio;
+            if (std::abs(cell) < EPSILON) {
+                cell = 0.0f;
+                if (old_ratio != 0.0f) dense_terms--;
             }
-            else if (monom_to_add > list_monom) {     
-                new_terms.push_back(monom_to_add);
-                new_terms.push_back(list_monom);     
-                inserted_or_merged = true;
+            else if (old_ratio == 0.0f) {
+                dense_terms++;
             }
-            else {      
-                new_terms.push_back(list_monom);
-            }
-        }
-        else {        
-            new_terms.push_back(list_monom);
+            change_term_metadata(monom_to_add.powers.data(), old_ratio, cell);
+            update_representation();
+            return;
         }
-        current_node_ptr = current_node_ptr->next;
-        count++;
+        to_sparse();
     }
 
-    if (!inserted_or_merged) {         
-        new_terms.push_back(monom_to_add);
+    // Binary search for the first term that does not go before the new one
+    PolyTerm term = to_term(monom_to_add);
+    size_t lo = 0;
+    size_t hi = terms.size();
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (term_before(terms[mid], term)) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
     }
 
-    terms = std::move(new_terms);
+    if (lo < terms.size() && compare_powers(terms[lo].powers, term.powers) == 0) {
+        float old_ratio = terms[lo].ratio;
+        float new_ratio = old_ratio + term.ratio;
+        if (std::abs(new_ratio) <= EPSILON) {
+            terms.erase(lo);
+            new_ratio = 0.0f;
+        }
+        else {
+            terms[lo].ratio = new_ratio;
+        }
+        change_term_metadata(term.powers, old_ratio, new_ratio);
+    }
+    else {
+        terms.insert(lo, term);
+        add_term_metadata(term);
+    }
+    update_representation();
 }
 
 void Polynom::deleteMonom(const size_t index) {
-    if (index >= terms.size()) {
+    if (index >= size()) {
         throw std::out_of_range("Polynom::deleteMonom: index out of range");
     }
+    to_sparse();
+    PolyTerm removed = terms[index];
     terms.erase(index);  
+    change_term_metadata(removed.powers, removed.ratio, 0.0f);
 }
 
 
-Polynom Polynom::operator+(const Polynom& oth) const {
-    Polynom result;    
-    auto* p1_node = this->terms.get_head_node();
-    auto* p2_node = oth.terms.get_head_node();
+Polynom Polynom::add_dense(const Polynom& oth, float factor, const Box& box) const {
+    DenseStorage coeffs(box_volume(box.lo, box.hi), 0.0f, polynom_resource());
+    scatter_to(1.0f, box, coeffs.data());
+    oth.scatter_to(factor, box, coeffs.data());
+    Polynom result;
+    result.assign_dense(box, std::move(coeffs));
+    return result;
+}
 
-    size_t p1_count = 0;
-    size_t p2_count = 0;
+Polynom Polynom::add_scaled(const Polynom& oth, float factor) const {
+    if (dense || oth.dense) {
+        if (oth.size() == 0) {
+            return *this;
+        }
+        Box box = oth.bounding_box();
+        if (size() != 0) {
+            Box this_box = bounding_box();
+            for (size_t i = 0; i < 3; ++i) {
+                box.lo[i] = std::min(box.lo[i], this_box.lo[i]);
+                box.hi[i] = std::max(box.hi[i], this_box.hi[i]);
+            }
+        }
+        if (fits_dense(box, std::max(size(), oth.size()))) {
+            return add_dense(oth, factor, box);
+        }
+        if (dense) {
+            return as_sparse().add_scaled(oth, factor);
+        }
+        return add_scaled(oth.as_sparse(), factor);
+    }
+
+    Polynom result;
     const size_t p1_size = this->terms.size();
     const size_t p2_size = oth.terms.size();
-
-    while (p1_count < p1_size && p2_count < p2_size) {
-        const Monom& m1 = p1_node->data;
-        const Monom& m2 = p2_node->data;
-
-        if (m1.powers == m2.powers) {
-            Monom sum_monom = m1;      
-            sum_monom.ratio += m2.ratio;
-            if (std::abs(sum_monom.ratio) > EPSILON) {
-                result.terms.push_back(sum_monom);
+    size_t p1 = 0;
+    size_t p2 = 0;
+
+    while (p1 < p1_size && p2 < p2_size) {
+        const PolyTerm& m1 = this->terms[p1];
+        const PolyTerm& m2 = oth.terms[p2];
+        int order = compare_powers(m1.powers, m2.powers);
+
+        if (order == 0) {
+            PolyTerm sum = m1;
+            sum.ratio += factor * m2.ratio;
+            if (std::abs(sum.ratio) > EPSILON) {
+                result.terms.push_back(sum);
             }
-            p1_node = p1_node->next;
-            p2_node = p2_node->next;
-            p1_count++;
-            p2_count++;
+            p1++;
+            p2++;
         }
-        else if (m1 > m2) {        
+        else if (order > 0) {
             result.terms.push_back(m1);
-            p1_node = p1_node->next;
-            p1_count++;
+            p1++;
         }
-        else {        
-            result.terms.push_back(m2);
-            p2_node = p2_node->next;
-            p2_count++;
+        else {
+            PolyTerm scaled = m2;
+            scaled.ratio *= factor;
+            result.terms.push_back(scaled);
+            p2++;
         }
     }
 
-    while (p1_count < p1_size) {
-        result.terms.push_back(p1_node->data);
-        p1_node = p1_node->next;
-        p1_count++;
+    for (; p1 < p1_size; ++p1) {
+        result.terms.push_back(this->terms[p1]);
     }
-    while (p2_count < p2_size) {
-        result.terms.push_back(p2_node->data);
-        p2_node = p2_node->next;
-        p2_count++;
+    for (; p2 < p2_size; ++p2) {
+        PolyTerm scaled = oth.terms[p2];
+        scaled.ratio *= factor;
+        result.terms.push_back(scaled);
     }
+    result.refresh();
     return result;
 }
 
-Polynom Polynom::operator+(const Monom& monom) const {
-    Polynom result = *this;      
+Polynom operator+(const Polynom& p, const Monom& monom) {
+    Polynom result = p;      
     result.addMonom(monom);      
     return result;
 }
 
-Polynom Polynom::operator-(const Polynom& oth) const {
-    Polynom neg_oth;   
-    auto* oth_node = oth.terms.get_head_node();
-    size_t count = 0;
-    const size_t oth_size = oth.terms.size();
+Polynom::Box Polynom::product_box(const Polynom& oth) const {
+    Box this_box = bounding_box();
+    Box oth_box = oth.bounding_box();
+    Box box;
+    for (size_t i = 0; i < 3; ++i) {
+        box.lo[i] = this_box.lo[i] + oth_box.lo[i];
+        box.hi[i] = this_box.hi[i] + oth_box.hi[i];
+    }
+    return box;
+}
+
+void Polynom::multiply_into(const Polynom& oth, const Box& box, float* out) const {
+    const size_t extent_y = static_cast<size_t>(box.hi[1] - box.lo[1] + 1);
+    const size_t extent_z = static_cast<size_t>(box.hi[2] - box.lo[2] + 1);
+
+    // The dense operand (if any) goes to the inner loop so that whole z rows are multiplied at once
+    const Polynom& inner = oth.dense ? oth : *this;
+    const Polynom& outer = oth.dense ? *this : oth;
+
+    outer.for_each_term_unordered([&](float ratio_a, const int* powers_a) {
+        if (!inner.dense) {
+            inner.for_each_term_unordered([&](float ratio_b, const int* powers_b) {
+                size_t idx = (static_cast<size_t>(powers_a[0] + powers_b[0] - box.lo[0]) * extent_y +
+                    static_cast<size_t>(powers_a[1] + powers_b[1] - box.lo[1])) * extent_z +
+                    static_cast<size_t>(powers_a[2] + powers_b[2] - box.lo[2]);
+                out[idx] += ratio_a * ratio_b;
+            });
+            return;
+        }
+        const float* src = inner.dense_coeffs.data();
+        for (int x = 0; x < inner.dense_extent[0]; ++x) {
+            for (int y = 0; y < inner.dense_extent[1]; ++y) {
+                float* dst = out + (static_cast<size_t>(powers_a[0] + inner.dense_lo[0] + x - box.lo[0]) * extent_y +
+                    static_cast<size_t>(powers_a[1] + inner.dense_lo[1] + y - box.lo[1])) * extent_z +
+                    static_cast<size_t>(powers_a[2] + inner.dense_lo[2] - box.lo[2]);
+                for (int z = 0; z < inner.dense_extent[2]; ++z) {
+                    dst[z] += ratio_a * src[z];
+                }
+                src += inner.dense_extent[2];
+            }
+        }
+    });
+}
 
-    while (count < oth_size) {
-        Monom temp = oth_node->data;  
-        temp.ratio *= -1.0f;
-        if (std::abs(temp.ratio) > EPSILON) {       
-            neg_oth.terms.push_back(temp);   
+void Polynom::append_products(const Polynom& oth, TermStorage& out) const {
+    for (const PolyTerm& a : this->terms) {
+        for (const PolyTerm& b : oth.terms) {
+            PolyTerm product = { a.ratio * b.ratio,
+                { a.powers[0] + b.powers[0], a.powers[1] + b.powers[1], a.powers[2] + b.powers[2] }, a.degree + b.degree };
+            if (std::abs(product.ratio) > EPSILON) {
+                out.push_back(product);
+            }
         }
-        oth_node = oth_node->next;
-        count++;
     }
-    return *this + neg_oth;     
 }
 
-Polynom Polynom::operator*(const Polynom& oth) const {
-    if (this->terms.empty() || oth.terms.empty()) {
-        return Polynom();        
+Polynom Polynom::multiply_dense(const Polynom& oth, const Box& box) const {
+    DenseStorage coeffs(box_volume(box.lo, box.hi), 0.0f, polynom_resource());
+    multiply_into(oth, box, coeffs.data());
+    Polynom result;
+    result.assign_dense(box, std::move(coeffs));
+    return result;
+}
+
+// The polynom order is not compatible with multiplication by a monom, so products cannot be
+// merged with c as sorted streams; instead products and c share one accumulation pass
+// (a dense buffer or a single sort + merge) and the product is never normalized on its own.
+Polynom Polynom::fma(const Polynom& a, const Polynom& b, const Polynom& c) {
+    if (a.size() == 0 || b.size() == 0) {
+        return c;
+    }
+    if (c.size() == 0) {
+        return a * b;
+    }
+
+    Box product = a.product_box(b);
+    Box box = c.bounding_box();
+    for (size_t i = 0; i < 3; ++i) {
+        box.lo[i] = std::min(box.lo[i], product.lo[i]);
+        box.hi[i] = std::max(box.hi[i], product.hi[i]);
+    }
+    if (fits_dense(box, std::max(a.size() * b.size(), c.size()))) {
+        DenseStorage coeffs(box_volume(box.lo, box.hi), 0.0f, polynom_resource());
+        a.multiply_into(b, box, coeffs.data());
+        c.scatter_to(1.0f, box, coeffs.data());
+        Polynom result;
+        result.assign_dense(box, std::move(coeffs));
+        return result;
+    }
+    if (fits_dense(product, a.size() * b.size())) {
+        return a.multiply_dense(b, product) + c;
+    }
+    if (a.dense || b.dense || c.dense) {
+        return fma(a.as_sparse(), b.as_sparse(), c.as_sparse());
+    }
+
+    Polynom result;
+    result.terms.reserve(a.terms.size() * b.terms.size() + c.terms.size());
+    a.append_products(b, result.terms);
+    for (const PolyTerm& term : c.terms) {
+        result.terms.push_back(term);
     }
+    result.normalize();
+    return result;
+}
 
-    CyclicList<Monom> temp_result_terms;
-    auto* this_node = this->terms.get_head_node();
-    size_t this_count = 0;
-    const size_t this_size = this->terms.size();
 
-    while (this_count < this_size) {
-        auto* oth_node = oth.terms.get_head_node();
-        size_t oth_count = 0;
-        const size_t oth_size = oth.terms.size();
-        while (oth_count < oth_size) {
-            Monom product = this_node->data * oth_node->data;
-            if (std::abs(product.ratio) > EPSILON) {
-                temp_result_terms.push_back(product);
+// Multiplies factors pairwise, smallest first, until at most target remain. Every level sorts the
+// factors by term count and pairs neighbours, so each product joins operands of similar size.
+// Workers allocate from their own thread's resource, never from the caller's arena.
+void Polynom::reduce_factors(std::vector<Polynom>& factors, size_t target) {
+    while (factors.size() > target) {
+        std::stable_sort(factors.begin(), factors.end(), [](const Polynom& a, const Polynom& b) {
+            return a.size() < b.size();
+        });
+        size_t pairs = std::min(factors.size() / 2, factors.size() - target);
+        size_t work = 0;
+        for (size_t i = 0; i < pairs; ++i) {
+            work += factors[2 * i].size() * factors[2 * i + 1].size();
+        }
+        size_t threads = work >= PARALLEL_PRODUCT_MIN_WORK ? std::min(parallel_threads(), pairs) : 1;
+
+        std::vector<std::optional<Polynom>> products(pairs);
+        run_parallel(threads, [&](size_t t) {
+            for (size_t i = t; i < pairs; i += threads) {
+                products[i].emplace(factors[2 * i] * factors[2 * i + 1]);
             }
-            oth_node = oth_node->next;
-            oth_count++;
+        });
+
+        std::vector<Polynom> next;
+        next.reserve(factors.size() - pairs);
+        for (std::optional<Polynom>& product : products) {
+            next.push_back(std::move(*product));
+        }
+        for (size_t i = 2 * pairs; i < factors.size(); ++i) {
+            next.push_back(std::move(factors[i]));
         }
-        this_node = this_node->next;
-        this_count++;
+        factors = std::move(next);
     }
+}
+
+Polynom Polynom::product(std::vector<Polynom> factors) {
+    if (factors.empty()) {
+        throw std::invalid_argument("Polynom::product: no factors");
+    }
+    for (const Polynom& factor : factors) {
+        if (factor.size() == 0) {
+            return Polynom();
+        }
+    }
+    reduce_factors(factors, 1);
+    return std::move(factors.front());
+}
 
-    return Polynom(temp_result_terms);
+Polynom Polynom::fma(std::vector<Polynom> factors, const Polynom& c) {
+    if (factors.empty()) {
+        throw std::invalid_argument("Polynom::fma: no factors");
+    }
+    for (const Polynom& factor : factors) {
+        if (factor.size() == 0) {
+            return c;
+        }
+    }
+    if (factors.size() == 1) {
+        return factors.front() + c;
+    }
+    reduce_factors(factors, 2);
+    return fma(factors[0], factors[1], c);
 }
 
 
@@ -423,118 +1091,223 @@ Polynom& Polynom::operator*=(const Polynom& oth) {
     return *this;
 }
 
-std::ostream& operator<<(std::ostream& os, const Polynom& poly) {
-    if (poly.terms.empty()) {
-        os << 0;
-        return os;
+void Polynom::format_to(std::string& buffer) const {
+    if (size() == 0) {
+        buffer += '0';
+        return;
     }
 
-    auto* current_node = poly.terms.get_head_node();
-    size_t count = 0;
-    const size_t terms_size = poly.terms.size();
-
+    char chars[Monom::MAX_MONOM_CHARS + 1];
+    buffer.reserve(buffer.size() + size() * 12);
     bool first_term = true;
-    while (count < terms_size) {
-        const Monom& term = current_node->data;
-        if (!first_term && term.ratio > 0) {          
-            os << "+";
+    for_each_term([&](float ratio, const int* powers) {
+        size_t len = 0;
+        if (!first_term && ratio > 0) {
+            chars[len++] = '+';
         }
-        os << term;
+        len += format_monom(ratio, powers, chars + len);
+        buffer.append(chars, len);
         first_term = false;
-        current_node = current_node->next;
-        count++;
-    }
+    });
+}
+
+void Polynom::print(std::ostream& os, std::string& buffer) const {
+    buffer.clear();
+    format_to(buffer);
+    os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+std::ostream& operator<<(std::ostream& os, const Polynom& poly) {
+    std::string buffer;
+    poly.print(os, buffer);
     return os;
 }
 
 Polynom& Polynom::operator=(std::string& oth_str_ref) {        
-    this->terms.clear();
-    std::string s = oth_str_ref;        
-    s.erase(std::remove_if(s.begin(), s.end(), ::isspace), s.end());
+    *this = Polynom(std::string_view(oth_str_ref));
+    return *this;
+}
 
-    if (s.empty()) return *this;
+static const unsigned char SERIAL_MAGIC[3] = { 'P', 'L', 'Y' };
+static const size_t SERIAL_HEADER_SIZE = 4;
+
+static uint64_t zigzag_encode(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
 
-    std::string current_term_str = s;      
+static int64_t zigzag_decode(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
 
-    float r = 1.0f;
-    std::vector<int> p = { 0, 0, 0 };    
-    std::string num_part;
-    size_t k = 0;
+static size_t varint_size(uint64_t value) {
+    size_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        size++;
+    }
+    return size;
+}
 
-    if (k < current_term_str.length() && current_term_str[k] == '+') {
-        k++;
+static unsigned char* write_varint(unsigned char* out, uint64_t value) {
+    while (value >= 0x80) {
+        *out++ = static_cast<unsigned char>(value | 0x80);
+        value >>= 7;
     }
-    else if (k < current_term_str.length() && current_term_str[k] == '-') {
-        r = -1.0f;
-        k++;
+    *out++ = static_cast<unsigned char>(value);
+    return out;
+}
+
+static const unsigned char* read_varint(const unsigned char* in, const unsigned char* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && in != end; shift += 7) {
+        unsigned char byte = *in++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return in;
+        }
     }
+    throw std::invalid_argument("Polynom::deserialize: truncated or malformed varint");
+}
 
-    while (k < current_term_str.length() && (isdigit(current_term_str[k]) || current_term_str[k] == '.')) {
-        num_part += current_term_str[k];
-        k++;
+const PolyTerm* Polynom::ordered_terms(std::vector<PolyTerm>& scratch) const {
+    if (!dense) {
+        return terms.data();
     }
+    scratch.clear();
+    scratch.reserve(dense_terms);
+    for_each_term_unordered([&scratch](float ratio, const int* powers) {
+        scratch.push_back(make_term(ratio, powers));
+    });
+    std::sort(scratch.begin(), scratch.end(), [](const PolyTerm& a, const PolyTerm& b) {
+        return compare_powers(a.powers, b.powers) > 0;
+    });
+    return scratch.data();
+}
 
-    if (!num_part.empty()) {
-        try {
-            r *= std::stof(num_part);
+// Powers are stored as zigzag varint deltas from the previous term
+static size_t serial_size(const PolyTerm* terms, size_t count) {
+    size_t bytes = SERIAL_HEADER_SIZE + varint_size(count);
+    int prev[3] = { 0, 0, 0 };
+    for (size_t t = 0; t < count; ++t) {
+        for (size_t i = 0; i < 3; ++i) {
+            bytes += varint_size(zigzag_encode(static_cast<int64_t>(terms[t].powers[i]) - prev[i]));
+            prev[i] = terms[t].powers[i];
         }
-        catch (const std::out_of_range&) {
-            throw std::invalid_argument("Coefficient number too large in: " + current_term_str);
+        bytes += sizeof(float);
+    }
+    return bytes;
+}
+
+static size_t write_serial(unsigned char* out, const PolyTerm* terms, size_t count) {
+    unsigned char* cur = out;
+    std::memcpy(cur, SERIAL_MAGIC, sizeof(SERIAL_MAGIC));
+    cur += sizeof(SERIAL_MAGIC);
+    *cur++ = Polynom::SERIAL_VERSION;
+    cur = write_varint(cur, count);
+
+    int prev[3] = { 0, 0, 0 };
+    for (size_t t = 0; t < count; ++t) {
+        for (size_t i = 0; i < 3; ++i) {
+            cur = write_varint(cur, zigzag_encode(static_cast<int64_t>(terms[t].powers[i]) - prev[i]));
+            prev[i] = terms[t].powers[i];
         }
-        catch (const std::invalid_argument&) {             
-            if (k < current_term_str.length() && (current_term_str[k] == 'x' || current_term_str[k] == 'y' || current_term_str[k] == 'z')) {
-            }
-            else {
-                throw std::invalid_argument("Invalid coefficient format in: " + current_term_str);
-            }
+        uint32_t bits;
+        std::memcpy(&bits, &terms[t].ratio, sizeof(bits));
+        for (size_t b = 0; b < sizeof(bits); ++b) {
+            *cur++ = static_cast<unsigned char>(bits >> (8 * b));
         }
     }
-    else {
-        if (k == current_term_str.length() && (s == "+" || s == "-")) {
-            throw std::invalid_argument("Invalid term (just a sign): " + current_term_str);
-        }
-    }
-
-
-    bool var_found_in_term = false;
-    for (; k < current_term_str.length(); ++k) {
-        var_found_in_term = true;
-        char var_char = current_term_str[k];
-        int var_idx = -1;
-        if (var_char == 'x') var_idx = 0;
-        else if (var_char == 'y') var_idx = 1;
-        else if (var_char == 'z') var_idx = 2;
-        else throw std::invalid_argument("Invalid variable character '" + std::string(1, var_char) + "' in term: " + current_term_str);
-
-        int power_val = 1;
-        if (k + 1 < current_term_str.length() && current_term_str[k + 1] == '^') {
-            k += 2;
-            std::string pow_str;
-            bool neg_pow = false;
-            if (k < current_term_str.length() && current_term_str[k] == '-') {
-                neg_pow = true;
-                k++;
-            }
-            while (k < current_term_str.length() && isdigit(current_term_str[k])) {
-                pow_str += current_term_str[k];
-                k++;
-            }
-            if (pow_str.empty()) throw std::invalid_argument("Missing exponent value after '^' in: " + current_term_str);
-            try {
-                power_val = std::stoi(pow_str);
-                if (neg_pow) power_val *= -1;
-            }
-            catch (const std::out_of_range&) {
-                throw std::invalid_argument("Exponent number too large in: " + current_term_str);
-            }
-            catch (const std::invalid_argument&) {
-                throw std::invalid_argument("Invalid exponent format in: " + current_term_str);
+    return static_cast<size_t>(cur - out);
+}
+
+size_t Polynom::serialized_size() const {
+    std::vector<PolyTerm> cells;
+    return serial_size(ordered_terms(cells), size());
+}
+
+size_t Polynom::serialize(unsigned char* out, size_t capacity) const {
+    std::vector<PolyTerm> cells;
+    const PolyTerm* ordered = ordered_terms(cells);
+    size_t needed = serial_size(ordered, size());
+    if (capacity < needed) {
+        throw std::out_of_range("Polynom::serialize: buffer too small, need " + std::to_string(needed) + " bytes");
+    }
+    return write_serial(out, ordered, size());
+}
+
+// One pass to order the terms, one to size the buffer, one to fill it
+std::vector<unsigned char> Polynom::serialize() const {
+    std::vector<PolyTerm> cells;
+    const PolyTerm* ordered = ordered_terms(cells);
+    std::vector<unsigned char> bytes(serial_size(ordered, size()));
+    write_serial(bytes.data(), ordered, size());
+    return bytes;
+}
+
+Polynom Polynom::deserialize(const unsigned char* data, size_t size, size_t& consumed) {
+    const unsigned char* cur = data;
+    const unsigned char* end = data + size;
+    if (size < SERIAL_HEADER_SIZE || std::memcmp(cur, SERIAL_MAGIC, sizeof(SERIAL_MAGIC)) != 0) {
+        throw std::invalid_argument("Polynom::deserialize: missing PLY header");
+    }
+    cur += sizeof(SERIAL_MAGIC);
+    if (*cur++ != SERIAL_VERSION) {
+        throw std::invalid_argument("Polynom::deserialize: unsupported format version");
+    }
+
+    uint64_t count = 0;
+    cur = read_varint(cur, end, count);
+    const uint64_t MIN_TERM_SIZE = 3 + sizeof(float);
+    if (count > static_cast<uint64_t>(end - cur) / MIN_TERM_SIZE) {
+        throw std::invalid_argument("Polynom::deserialize: term count exceeds buffer size");
+    }
+
+    Polynom result;
+    result.terms.reserve(static_cast<size_t>(count));
+    int64_t prev[3] = { 0, 0, 0 };
+    int prev_powers[3] = { 0, 0, 0 };
+    for (uint64_t t = 0; t < count; ++t) {
+        int powers[3];
+        for (size_t i = 0; i < 3; ++i) {
+            uint64_t encoded = 0;
+            cur = read_varint(cur, end, encoded);
+            int64_t value = prev[i] + zigzag_decode(encoded);
+            if (value < std::numeric_limits<int>::min() || value > std::numeric_limits<int>::max()) {
+                throw std::invalid_argument("Polynom::deserialize: power out of range");
             }
-            k--;      
+            prev[i] = value;
+            powers[i] = static_cast<int>(value);
+        }
+        if (end - cur < static_cast<std::ptrdiff_t>(sizeof(float))) {
+            throw std::invalid_argument("Polynom::deserialize: truncated coefficient");
+        }
+        uint32_t bits = 0;
+        for (size_t b = 0; b < sizeof(bits); ++b) {
+            bits |= static_cast<uint32_t>(*cur++) << (8 * b);
+        }
+        float ratio;
+        std::memcpy(&ratio, &bits, sizeof(ratio));
+
+        if (!std::isfinite(ratio) || std::abs(ratio) < EPSILON) {
+            throw std::invalid_argument("Polynom::deserialize: zero or non-finite coefficient");
+        }
+        if (t != 0 && compare_powers(prev_powers, powers) <= 0) {
+            throw std::invalid_argument("Polynom::deserialize: terms are not in normalized order");
         }
-        p[var_idx] += power_val;          
+        std::copy(powers, powers + 3, prev_powers);
+        result.terms.push_back(make_term(ratio, powers));
     }
 
-    this->addMonom(Monom(r, p));
-    return *this;
-}
\ No newline at end of file
+    result.refresh();
+    consumed = static_cast<size_t>(cur - data);
+    return result;
+}
+
+Polynom Polynom::deserialize(const unsigned char* data, size_t size) {
+    size_t consumed = 0;
+    Polynom result = deserialize(data, size, consumed);
+    if (consumed != size) {
+        throw std::invalid_argument("Polynom::deserialize: trailing bytes after polynom");
+    }
+    return result;
+}
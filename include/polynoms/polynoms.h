@@ -1,9 +1,29 @@
 ﻿#pragma once
 
 #include "cyclic_list.h"          
+#include "small_vector.h"
 #include <string>
 #include <vector>
+#include <memory_resource>
 #include <functional>      
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstdint>
+#include <string_view>
+
+constexpr float EPSILON = 1e-6f;
+
+// >0 if a goes before b in a polynom (max power, then x, y, z descending), <0 if after, 0 if equal
+constexpr int compare_powers(const int* a, const int* b) {
+    int max_a = std::max(a[0], std::max(a[1], a[2]));
+    int max_b = std::max(b[0], std::max(b[1], b[2]));
+    if (max_a != max_b) return max_a > max_b ? 1 : -1;
+    for (size_t i = 0; i < 3; ++i) {
+        if (a[i] != b[i]) return a[i] > b[i] ? 1 : -1;
+    }
+    return 0;
+}
 
 class Monom {
 public:
@@ -28,38 +48,321 @@ public:
     bool operator>(const Monom& oth) const;
     bool operator<(const Monom& oth) const;
 
+    // Upper bound of format_to output: 20-char coefficient plus three "x^-2147483648"
+    static const size_t MAX_MONOM_CHARS = 64;
+
+    void format_to(std::string& buffer) const;
     friend std::ostream& operator<<(std::ostream& os, const Monom& monom);
 };
 
 
+// Memory resource that newly created polynoms take their storage from: the heap by default,
+// the innermost active PolynomArena::Scope on this thread otherwise (see polynom_arena.h)
+std::pmr::memory_resource* polynom_resource();
+
+// Flat term record used by the sparse representation and by PolynomBuilder
+struct PolyTerm {
+    float ratio;
+    int powers[3];
+    int degree;     // powers[0] + powers[1] + powers[2]
+};
+
+inline PolyTerm make_term(float ratio, const int* powers) {
+    return { ratio, { powers[0], powers[1], powers[2] }, powers[0] + powers[1] + powers[2] };
+}
+
+class MultiplyPlanner;
+class PolynomSystem;
+class JacobianEvaluator;
+class PolynomLiteral;
+class ExpressionEvaluator;
+template <typename E>
+class PolynomExpression;
+
 class Polynom {
+public:
+    // Sparse polynoms with up to INLINE_TERMS terms live inside the object without heap allocation
+    static const size_t INLINE_TERMS = 4;
+    using TermStorage = SmallVector<PolyTerm, INLINE_TERMS>;
+
 private:
-    CyclicList<Monom> terms;    
+    using DenseStorage = std::pmr::vector<float>;
+
+public:
+    // Degree reported for the zero polynom
+    static constexpr int ZERO_DEGREE = INT_MIN;
+
+private:
+
+    struct Box {
+        int lo[3];
+        int hi[3];
+    };
+
+    // Sparse representation: nonzero terms in descending order
+    TermStorage terms{ polynom_resource() };
+
+    // Dense representation: coefficient of every monom in dense_lo .. dense_lo + dense_extent - 1, z fastest.
+    // Exactly one representation is active; zero cells hold 0.0f.
+    bool dense = false;
+    int dense_lo[3] = { 0, 0, 0 };
+    int dense_extent[3] = { 0, 0, 0 };
+    DenseStorage dense_coeffs{ polynom_resource() };
+    size_t dense_terms = 0;
+
+    // Cached metadata, kept in sync by every operation: bulk operations recompute it in refresh(),
+    // single-term edits adjust it and only rescan when an extreme term disappears
+    int max_degree = ZERO_DEGREE;
+    int var_degree[3] = { ZERO_DEGREE, ZERO_DEGREE, ZERO_DEGREE };
+    PolyTerm leading = { 0.0f, { 0, 0, 0 }, 0 };
+    uint64_t content_hash = 0;
+
+    void rebuild_metadata();
+    void add_term_metadata(const PolyTerm& term);
+    void change_term_metadata(const int* powers, float old_ratio, float new_ratio);
+    void copy_metadata(const Polynom& oth);
+
     void normalize();
 
+    Box bounding_box() const;
+    size_t dense_index(const int* powers) const;
+    bool dense_contains(const int* powers) const;
+    void to_dense(const Box& box);
+    void to_sparse();
+    void update_representation();
+    void refresh();
+    void assign_dense(const Box& box, DenseStorage&& coeffs);
+    void scatter_to(float factor, const Box& box, float* out) const;
+    Polynom as_sparse() const;
+    static bool fits_dense(const Box& box, size_t expected_terms);
+
+    Polynom add_scaled(const Polynom& oth, float factor) const;
+    Polynom add_dense(const Polynom& oth, float factor, const Box& box) const;
+    Polynom multiply_dense(const Polynom& oth, const Box& box) const;
+    Box product_box(const Polynom& oth) const;
+    void multiply_into(const Polynom& oth, const Box& box, float* out) const;
+    void append_products(const Polynom& oth, TermStorage& out) const;
+    static void reduce_factors(std::vector<Polynom>& factors, size_t target);
+
+    // Visits (ratio, powers) of every term: unordered is cheap, ordered follows the sparse order
+    template <typename F>
+    void for_each_term_unordered(F&& func) const;
+    template <typename F>
+    void for_each_term(F&& func) const;
+    // The size() terms in sparse order: the stored ones, or the cells of a dense polynom sorted
+    // once into scratch
+    const PolyTerm* ordered_terms(std::vector<PolyTerm>& scratch) const;
+
+    friend class PolynomBuilder;
+    friend class MultiplyPlanner;
+    friend class PolynomSystem;
+    friend class JacobianEvaluator;
+    friend class GroebnerBasis;
+    friend class ExpressionEvaluator;
+    friend class TermView;
+    friend class DegreeIndex;
+
 public:
+    // Switching thresholds: a polynom goes dense once it has DENSE_MIN_TERMS terms filling at least
+    // DENSE_ENTER_DENSITY of its exponent bounding box, and back to sparse below DENSE_LEAVE_DENSITY
+    static const size_t DENSE_MIN_TERMS = 32;
+    static constexpr double DENSE_ENTER_DENSITY = 0.25;
+    static constexpr double DENSE_LEAVE_DENSITY = 0.0625;
+    static const size_t DENSE_MAX_VOLUME = size_t(1) << 24;
+
+    // Normalizing at least PARALLEL_NORMALIZE_MIN_TERMS terms is split by key range across threads
+    static const size_t PARALLEL_NORMALIZE_MIN_TERMS = size_t(1) << 18;
+    // A product tree level with at least PARALLEL_PRODUCT_MIN_WORK term pairs multiplies its pairs across threads
+    static const size_t PARALLEL_PRODUCT_MIN_WORK = size_t(1) << 16;
+    // Multipoint and grid evaluation with at least PARALLEL_EVALUATE_MIN_WORK steps split the points across threads
+    static const size_t PARALLEL_EVALUATE_MIN_WORK = size_t(1) << 20;
+    // Batch root finding over at least PARALLEL_ROOTS_MIN_COUNT polynoms hands them out to threads
+    static const size_t PARALLEL_ROOTS_MIN_COUNT = 64;
+    static void set_parallel_threads(size_t count);    // 0 (default) means hardware_concurrency()
+    static size_t parallel_threads();
+
     Polynom() = default;
+    // Copies draw from the current polynom_resource() and assignments keep the target's resource,
+    // but a move-constructed polynom takes over the source's: one moved out of a PolynomArena::Scope
+    // still points into the arena, so results that outlive it are copied out after the scope ends
+    // (as Translator::processExpression does)
+    Polynom(const Polynom& oth);
+    Polynom(Polynom&& oth) = default;
+    Polynom& operator=(const Polynom& oth) = default;
+    Polynom& operator=(Polynom&& oth) = default;
 
     explicit Polynom(const CyclicList<Monom>& list);
     explicit Polynom(CyclicList<Monom>&& list);
+    // Parses a literal like "3x^2-y"; throws std::invalid_argument on malformed input
+    explicit Polynom(std::string_view text);
+    // Copies the terms of a literal already parsed, sorted and merged at compile time ("..."_poly)
+    Polynom(const PolynomLiteral& literal);
 
 
     void addMonom(const Monom& monom);
 
     void deleteMonom(const size_t index);
 
-    Polynom operator+(const Polynom& oth) const;    
-    Polynom operator+(const Monom& monom) const;    
-    Polynom operator-(const Polynom& oth) const;
-    Polynom operator*(const Polynom& oth) const;    
+    size_t size() const;
+    bool is_dense() const;
+
+    // O(1) cached metadata
+    int degree() const;                 // max total degree of a term
+    int degree(size_t var) const;       // max power of x (0), y (1) or z (2)
+    Monom leading_term() const;         // first term in polynom order, zero Monom for the zero polynom
+    uint64_t hash() const;              // equal polynoms hash equal regardless of representation
+
+    // a + b, a - b and a * b of polynoms and expressions build an expression (polynom_expression.h)
+    // that is evaluated on conversion to Polynom, printing or a member call: sums of n operands are
+    // merged in one pass and a product added to the rest goes through fma. The other binary operators are free functions
+    // below, so an expression converts on either side.
+
+    // a * b + c in one accumulation pass, without normalizing the product separately
+    static Polynom fma(const Polynom& a, const Polynom& b, const Polynom& c);
+    // Product of all factors in a balanced tree that pairs the smallest factors first;
+    // throws std::invalid_argument if factors is empty
+    static Polynom product(std::vector<Polynom> factors);
+    // product(factors) + c, with the last multiplication fused into fma
+    static Polynom fma(std::vector<Polynom> factors, const Polynom& c);
+
+    // Value at (x, y, z); negative powers divide
+    double evaluate(double x, double y, double z) const;
+
+    // Univariate slices: polynoms without y and z powers
+    bool is_univariate() const;
+    // Values at all points by sparse Horner run on a batch of points at once, O(terms * points).
+    // A subproduct tree would be asymptotically faster but loses all accuracy in floating point
+    // for more than a few dozen points, and unlike divide() its result cannot be cheaply checked
+    // and redone, so only the stable method is used. Throws std::invalid_argument unless
+    // is_univariate().
+    std::vector<double> evaluate(const std::vector<double>& xs) const;
+    // Polynom of degree < xs.size() through (xs[i], values[i]), by Newton divided differences over
+    // Leja-ordered points, O(n^2) for n points, for the same reason as evaluate(xs) above.
+    // Throws std::invalid_argument on mismatched sizes or repeated points
+    static Polynom interpolate(const std::vector<double>& xs, const std::vector<double>& values);
+    // Distinct real roots, ascending. The square-free part (divided by the exact gcd with the
+    // derivative) is isolated by Vincent-Collins-Akritas bisection: Descartes' rule of signs on
+    // (1 + x)^n q(1 / (1 + x)) counts the roots of each interval of (-bound, bound), with the Cauchy
+    // bound, in exact integer arithmetic. Only intervals whose ends have opposite signs are kept, and
+    // each is refined by safeguarded Newton steps kept inside it. A negative lowest power makes 0 a
+    // pole, not a root. Throws std::invalid_argument unless is_univariate()
+    // or for the zero polynom.
+    std::vector<double> real_roots() const;
+    // real_roots() of every polynom, across parallel_threads() for PARALLEL_ROOTS_MIN_COUNT or more
+    static std::vector<std::vector<double>> real_roots(const std::vector<Polynom>& polynoms);
+    // Values on the grid xs x ys x zs: out[(i * ys.size() + j) * zs.size() + k] is the value at
+    // (xs[i], ys[j], zs[k]). Uses per-axis power tables and contracts x, then y, then z for every
+    // x slab; slabs are split across threads for large grids.
+    void evaluate_grid(const std::vector<double>& xs, const std::vector<double>& ys, const std::vector<double>& zs,
+        std::vector<double>& out) const;
+
+    // Partial derivative by x (0), y (1) or z (2) in one pass over the terms. Distinct terms stay
+    // distinct, so nothing is summed: dense polynoms stay dense in the shifted box. Sparse terms
+    // whose max power drops and the others each stay in order, and the two runs are merged in O(n).
+    // Throws std::out_of_range for another var.
+    Polynom derivative(size_t var) const;
+    std::array<Polynom, 3> gradient() const;
+
+    // p(qx, qy, qz): Horner in x whose coefficients are Horner in y over linear combinations of
+    // powers of qz. Every power of a q is computed once, by squaring, and products go through
+    // MultiplyPlanner. Throws std::invalid_argument if the polynom has negative powers.
+    Polynom compose(const Polynom& qx, const Polynom& qy, const Polynom& qz) const;
+
+    // Division with remainder, this = quotient * divisor + remainder. Polynoms in x alone use
+    // univariate division: schoolbook, or once both the quotient and the divisor have
+    // DIVIDE_NEWTON_MIN_LENGTH coefficients, the reciprocal of the reversed divisor by Newton
+    // iteration and two fast products. The Newton result is kept only when the reciprocal stays
+    // bounded and the high part of this - quotient * divisor vanishes; an ill-conditioned divisor
+    // falls back to schoolbook, O(deg quotient * deg divisor). Other polynoms are divided under
+    // graded lex order (total degree, then x, y, z), because the storage order is not compatible
+    // with multiplication.
+    // Throws std::invalid_argument for a zero divisor or negative powers.
+    static const size_t DIVIDE_NEWTON_MIN_LENGTH = 64;
+    struct Division;
+    Division divide(const Polynom& divisor) const;
+    // Multivariate division by a divisor set under graded lex order: returns the quotients, one per
+    // divisor, and a remainder none of whose terms is divisible by a leading term of a divisor
+    std::vector<Polynom> divide(const std::vector<Polynom>& divisors, Polynom& remainder) const;
+
+    // Exact gcd over the rationals: every float is a power of two times an integer, so both
+    // polynoms are scaled to integer coefficients and gcds modulo primes below 2^31 (Brown's dense
+    // modular algorithm, evaluating z, then y, down to Euclid in x) are combined by the Chinese
+    // remainder theorem until the candidate divides both. The result has coprime integer
+    // coefficients and a positive leading coefficient in lex order; gcd(0, 0) is 0.
+    // Throws std::invalid_argument for negative powers, std::out_of_range if coefficients outgrow 64 bits.
+    Polynom gcd(const Polynom& oth) const;
 
     Polynom& operator+=(const Polynom& oth);
     Polynom& operator+=(const Monom& monom);
     Polynom& operator-=(const Polynom& oth);
+    template <typename E>
+    Polynom& operator+=(const PolynomExpression<E>& expression);
+    template <typename E>
+    Polynom& operator-=(const PolynomExpression<E>& expression);
     Polynom& operator*=(const Polynom& oth);
 
+    // Appends the text form to buffer; print() reuses a caller-owned buffer and writes it in one call
+    void format_to(std::string& buffer) const;
+    void print(std::ostream& os, std::string& buffer) const;
     friend std::ostream& operator<<(std::ostream& os, const Polynom& poly);
 
     Polynom& operator=(std::string& oth_str);
 
-};
\ No newline at end of file
+    // Binary format, little-endian: "PLY" + version byte, varint term count, then per term in
+    // stored order zigzag varint deltas of the x, y, z powers from the previous term and the raw float ratio
+    static const unsigned char SERIAL_VERSION = 1;
+    size_t serialized_size() const;
+    size_t serialize(unsigned char* out, size_t capacity) const;
+    std::vector<unsigned char> serialize() const;
+    static Polynom deserialize(const unsigned char* data, size_t size, size_t& consumed);
+    static Polynom deserialize(const unsigned char* data, size_t size);
+};
+
+struct Polynom::Division {
+    Polynom quotient;
+    Polynom remainder;
+};
+
+Polynom operator+(const Polynom& p, const Monom& monom);
+// Quotient and remainder of Polynom::divide
+Polynom operator/(const Polynom& a, const Polynom& b);
+Polynom operator%(const Polynom& a, const Polynom& b);
+
+template <typename F>
+void Polynom::for_each_term_unordered(F&& func) const {
+    if (!dense) {
+        for (const PolyTerm& term : terms) {
+            func(term.ratio, static_cast<const int*>(term.powers));
+        }
+        return;
+    }
+    size_t idx = 0;
+    int powers[3];
+    for (int x = 0; x < dense_extent[0]; ++x) {
+        powers[0] = dense_lo[0] + x;
+        for (int y = 0; y < dense_extent[1]; ++y) {
+            powers[1] = dense_lo[1] + y;
+            for (int z = 0; z < dense_extent[2]; ++z, ++idx) {
+                if (dense_coeffs[idx] != 0.0f) {
+                    powers[2] = dense_lo[2] + z;
+                    func(dense_coeffs[idx], static_cast<const int*>(powers));
+                }
+            }
+        }
+    }
+}
+
+template <typename F>
+void Polynom::for_each_term(F&& func) const {
+    if (!dense) {
+        for_each_term_unordered(func);
+        return;
+    }
+    std::vector<PolyTerm> cells;
+    ordered_terms(cells);
+    for (const PolyTerm& cell : cells) {
+        func(cell.ratio, static_cast<const int*>(cell.powers));
+    }
+}
+
+#include "polynom_expression.h"
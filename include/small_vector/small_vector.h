@@ -0,0 +1,215 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Vector that keeps up to N elements inside the object and only allocates when it grows past them.
+// Elements are moved with memcpy, so T has to be trivially copyable.
+// Heap storage comes from a std::pmr::memory_resource that stays with the vector like a pmr container's
+// allocator: copies use the default resource unless told otherwise, assignment keeps the target's resource.
+template <typename T, size_t N>
+class SmallVector {
+    static_assert(std::is_trivially_copyable<T>::value, "SmallVector requires a trivially copyable type");
+    static_assert(N > 0, "SmallVector needs at least one inline element");
+
+private:
+    T* data_;
+    std::pmr::memory_resource* resource_;
+    size_t size_ = 0;
+    size_t capacity_ = N;
+    alignas(T) unsigned char inline_storage[N * sizeof(T)];
+
+    T* inline_data() { return reinterpret_cast<T*>(inline_storage); }
+    bool is_inline() const { return data_ == reinterpret_cast<const T*>(inline_storage); }
+
+    void grow(size_t min_capacity) {
+        size_t new_capacity = capacity_ * 2;
+        if (new_capacity < min_capacity) {
+            new_capacity = min_capacity;
+        }
+        T* new_data = static_cast<T*>(resource_->allocate(new_capacity * sizeof(T), alignof(T)));
+        if (size_ != 0) {
+            std::memcpy(new_data, data_, size_ * sizeof(T));
+        }
+        release();
+        data_ = new_data;
+        capacity_ = new_capacity;
+    }
+
+    void release() {
+        if (!is_inline()) {
+            resource_->deallocate(data_, capacity_ * sizeof(T), alignof(T));
+        }
+        data_ = inline_data();
+        capacity_ = N;
+    }
+
+    void steal(SmallVector& oth) {
+        if (oth.is_inline()) {
+            data_ = inline_data();
+            capacity_ = N;
+            if (oth.size_ != 0) {
+                std::memcpy(data_, oth.data_, oth.size_ * sizeof(T));
+            }
+        }
+        else {
+            data_ = oth.data_;
+            capacity_ = oth.capacity_;
+        }
+        size_ = oth.size_;
+        oth.data_ = oth.inline_data();
+        oth.capacity_ = N;
+        oth.size_ = 0;
+    }
+
+public:
+    static const size_t INLINE_CAPACITY = N;
+
+    explicit SmallVector(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : data_(inline_data()), resource_(resource) {}
+
+    ~SmallVector() {
+        release();
+    }
+
+    SmallVector(const SmallVector& oth, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : data_(inline_data()), resource_(resource) {
+        reserve(oth.size_);
+        if (oth.size_ != 0) {
+            std::memcpy(data_, oth.data_, oth.size_ * sizeof(T));
+        }
+        size_ = oth.size_;
+    }
+
+    SmallVector(SmallVector&& oth) noexcept : data_(inline_data()), resource_(oth.resource_) {
+        steal(oth);
+    }
+
+    SmallVector& operator=(const SmallVector& oth) {
+        if (this == &oth) {
+            return *this;
+        }
+        size_ = 0;
+        reserve(oth.size_);
+        if (oth.size_ != 0) {
+            std::memcpy(data_, oth.data_, oth.size_ * sizeof(T));
+        }
+        size_ = oth.size_;
+        return *this;
+    }
+
+    // Heap buffers only change hands between equal resources, otherwise the elements are copied
+    SmallVector& operator=(SmallVector&& oth) {
+        if (this == &oth) {
+            return *this;
+        }
+        if (!oth.is_inline() && !resource_->is_equal(*oth.resource_)) {
+            return *this = static_cast<const SmallVector&>(oth);
+        }
+        release();
+        steal(oth);
+        return *this;
+    }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+    bool is_heap_allocated() const { return !is_inline(); }
+    std::pmr::memory_resource* resource() const { return resource_; }
+
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+    T* begin() { return data_; }
+    T* end() { return data_ + size_; }
+    const T* begin() const { return data_; }
+    const T* end() const { return data_ + size_; }
+
+    T& operator[](size_t index) { return data_[index]; }
+    const T& operator[](size_t index) const { return data_[index]; }
+
+    T& back() {
+        if (empty()) {
+            throw std::out_of_range("SmallVector is empty, cannot access back element.");
+        }
+        return data_[size_ - 1];
+    }
+
+    const T& back() const {
+        if (empty()) {
+            throw std::out_of_range("SmallVector is empty, cannot access back element.");
+        }
+        return data_[size_ - 1];
+    }
+
+    void reserve(size_t new_capacity) {
+        if (new_capacity > capacity_) {
+            grow(new_capacity);
+        }
+    }
+
+    void resize(size_t new_size) {
+        reserve(new_size);
+        for (size_t i = size_; i < new_size; ++i) {
+            data_[i] = T{};
+        }
+        size_ = new_size;
+    }
+
+    void clear() {
+        size_ = 0;
+    }
+
+    // Drops heap storage as well, returning to the inline buffer
+    void reset() {
+        release();
+        size_ = 0;
+    }
+
+    void push_back(const T& value) {
+        if (size_ == capacity_) {
+            T copy = value;
+            grow(size_ + 1);
+            data_[size_++] = copy;
+            return;
+        }
+        data_[size_++] = value;
+    }
+
+    void pop_back() {
+        if (empty()) {
+            throw std::out_of_range("SmallVector is empty");
+        }
+        size_--;
+    }
+
+    void insert(size_t index, const T& value) {
+        if (index > size_) {
+            throw std::out_of_range("Index out of range for insert");
+        }
+        T copy = value;
+        if (size_ == capacity_) {
+            grow(size_ + 1);
+        }
+        std::memmove(data_ + index + 1, data_ + index, (size_ - index) * sizeof(T));
+        data_[index] = copy;
+        size_++;
+    }
+
+    void erase(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Index out of range for erase or vector is empty");
+        }
+        std::memmove(data_ + index, data_ + index + 1, (size_ - index - 1) * sizeof(T));
+        size_--;
+    }
+
+    void swap(SmallVector& oth) {
+        SmallVector tmp(std::move(oth));
+        oth = std::move(*this);
+        *this = std::move(tmp);
+    }
+};
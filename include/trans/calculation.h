@@ -2,8 +2,9 @@
 #include "tokens.h"
 #include "polynoms.h"
 
-#include <stack>
 #include <string>
+#include <vector>
+#include <memory_resource>
 #include <stdexcept>    
 #include <optional>      
 #include <type_traits>    
@@ -19,99 +20,182 @@
 
 
 class Сalculation {
+private:
+    // Stack entry. A product is kept as its two factors until it is consumed, so that a following
+    // + can evaluate it as Polynom::fma(factor, factor, addend) instead of building it on its own.
+    // Longer chains like a*b*c*d collect every factor and are multiplied as a balanced product tree.
+    struct Operand {
+        Polynom value;
+        std::optional<Polynom> factor;
+        std::vector<Polynom> chain;
+
+        explicit Operand(Polynom&& val) : value(std::move(val)) {}
+        Operand(Polynom&& val, Polynom&& fac) : value(std::move(val)), factor(std::move(fac)) {}
+        explicit Operand(std::vector<Polynom>&& factors) : chain(std::move(factors)) {}
+
+        bool pending() const { return factor.has_value() || !chain.empty(); }
+    };
+
+    static Polynom take(Operand& operand) {
+        if (!operand.chain.empty()) {
+            return Polynom::product(std::move(operand.chain));
+        }
+        if (operand.factor.has_value()) {
+            return operand.value * *operand.factor;
+        }
+        return std::move(operand.value);
+    }
+
+    static Polynom fused(Operand& product, const Polynom& addend) {
+        if (!product.chain.empty()) {
+            return Polynom::fma(std::move(product.chain), addend);
+        }
+        return Polynom::fma(product.value, *product.factor, addend);
+    }
+
+    static void collect_factors(Operand& operand, std::vector<Polynom>& factors) {
+        if (!operand.chain.empty()) {
+            for (Polynom& factor : operand.chain) {
+                factors.push_back(std::move(factor));
+            }
+            return;
+        }
+        factors.push_back(std::move(operand.value));
+        if (operand.factor.has_value()) {
+            factors.push_back(std::move(*operand.factor));
+        }
+    }
+
+    template <typename StorageType>
+    static std::optional<Polynom> find_variable(StorageType& storage, const std::string& name) {
+        std::optional<Polynom> varValue;
+        if constexpr (std::is_same_v<StorageType, AddressHashTable<std::string, Polynom>>) {
+            auto it = storage.find(name);
+            if (it != storage.end()) {   
+                varValue = it->value;
+            }
+        }
+        else if constexpr (std::is_same_v<StorageType, ChainHash<std::string, Polynom>>) {
+            auto it = storage.find(name);
+            if (it != storage.end()) {   
+                varValue = it->second;     
+            }
+        }
+        else if constexpr (std::is_base_of_v<BSTree<std::string, Polynom>, StorageType> ||
+            std::is_same_v<StorageType, BSTree<std::string, Polynom>>) {
+            auto* node = storage.find(name);      
+            if (node) {
+                varValue = node->value;
+            }
+        }
+        else if constexpr (std::is_same_v<StorageType, OrderedTable<std::string, Polynom>> ||
+            std::is_same_v<StorageType, UnOrderedTable<std::string, Polynom>>) {
+            auto it = storage.find(name);
+            if (it != storage.end()) {    
+                varValue = it.value();     
+            }
+        }
+        else if constexpr (std::is_same_v<StorageType, std::map<std::string, Polynom>>) {
+            auto it = storage.find(name);
+            if (it != storage.end()) {
+                varValue = it->second;
+            }
+        }
+        else {
+            throw std::runtime_error("Unsupported storage type for variable lookup in Calculation class.");
+        }
+        return varValue;
+    }
+
 public:
     template <typename StorageType>
     Polynom evaluate(const std::vector<Token>& rpn, StorageType& storage) {
-        std::stack<Polynom> values;
+        // Operands are moved in and out of a preallocated stack; small polynoms keep their terms inline
+        std::pmr::vector<Operand> values(polynom_resource());
+        values.reserve(rpn.size());
         auto rpn_iter = rpn.begin();
 
         for (; rpn_iter != rpn.end(); ++rpn_iter) {
             const auto& token = *rpn_iter;
             switch (token.type) {
             case TokenType::POLYNOM_LITERAL: {
-                Polynom p_val;
-                std::string val_str = token.value;
-                p_val = val_str;
-                values.push(p_val);
+                values.emplace_back(Polynom(std::string_view(token.value)));
                 break;
             }
             case TokenType::IDENTIFIER: {
-                std::optional<Polynom> varValue;
-
-                if constexpr (std::is_same_v<StorageType, AddressHashTable<std::string, Polynom>>) {
-                    auto it = storage.find(token.value);
-                    if (it != storage.end()) {   
-                        varValue = it->value;
-                    }
-                }
-                else if constexpr (std::is_same_v<StorageType, ChainHash<std::string, Polynom>>) {
-                    auto it = storage.find(token.value);
-                    if (it != storage.end()) {   
-                        varValue = it->second;     
-                    }
-                }
-                else if constexpr (std::is_base_of_v<BSTree<std::string, Polynom>, StorageType> ||
-                    std::is_same_v<StorageType, BSTree<std::string, Polynom>>) {
-                    auto* node = storage.find(token.value);      
-                    if (node) {
-                        varValue = node->value;
-                    }
-                }
-                else if constexpr (std::is_same_v<StorageType, OrderedTable<std::string, Polynom>> ||
-                    std::is_same_v<StorageType, UnOrderedTable<std::string, Polynom>>) {
-                    auto it = storage.find(token.value);
-                    if (it != storage.end()) {    
-                        varValue = it.value();     
-                    }
-                }
-                else if constexpr (std::is_same_v<StorageType, std::map<std::string, Polynom>>) {
-                    auto it = storage.find(token.value);
-                    if (it != storage.end()) {
-                        varValue = it->second;
-                    }
-                }
-                else {
-                    throw std::runtime_error("Unsupported storage type for variable lookup in Calculation class.");
-                }
-
+                std::optional<Polynom> varValue = find_variable(storage, token.value);
                 if (varValue.has_value()) {
-                    values.push(varValue.value());
+                    values.emplace_back(std::move(*varValue));
                 }
                 else {
                     throw std::invalid_argument("Undefined variable: " + token.value);
                 }
                 break;
             }
+            case TokenType::SUBSTITUTE: {
+                if (values.size() < 3) throw std::invalid_argument("Invalid expression: not enough arguments for " + token.value + "(...)");
+                std::optional<Polynom> varValue = find_variable(storage, token.value);
+                if (!varValue.has_value()) {
+                    throw std::invalid_argument("Undefined variable: " + token.value);
+                }
+                Polynom qz = take(values.back()); values.pop_back();
+                Polynom qy = take(values.back()); values.pop_back();
+                Polynom qx = take(values.back()); values.pop_back();
+                values.emplace_back(varValue->compose(qx, qy, qz));
+                break;
+            }
             case TokenType::PLUS: {
                 if (values.size() < 2) throw std::invalid_argument("Invalid expression: not enough operands for +");
-                Polynom val2 = values.top(); values.pop();
-                Polynom val1 = values.top(); values.pop();
-                values.push(val1 + val2);
+                Operand val2 = std::move(values.back()); values.pop_back();
+                Operand val1 = std::move(values.back()); values.pop_back();
+                if (val2.pending()) {
+                    Polynom addend = take(val1);
+                    values.emplace_back(fused(val2, addend));
+                }
+                else if (val1.pending()) {
+                    values.emplace_back(fused(val1, val2.value));
+                }
+                else {
+                    values.emplace_back(val1.value + val2.value);
+                }
                 break;
             }
             case TokenType::MINUS: {
                 if (values.size() < 2) {
                     throw std::invalid_argument("Invalid expression: not enough operands for -");
                 }
-                Polynom val2 = values.top(); values.pop();
-                Polynom val1 = values.top(); values.pop();
-                values.push(val1 - val2);
+                Polynom val2 = take(values.back()); values.pop_back();
+                Polynom val1 = take(values.back()); values.pop_back();
+                values.emplace_back(val1 - val2);
+                break;
+            }
+            case TokenType::DIVIDE:
+            case TokenType::MODULO: {
+                if (values.size() < 2) throw std::invalid_argument("Invalid expression: not enough operands for " + token.value);
+                Polynom val2 = take(values.back()); values.pop_back();
+                Polynom val1 = take(values.back()); values.pop_back();
+                values.emplace_back(token.type == TokenType::DIVIDE ? val1 / val2 : val1 % val2);
                 break;
             }
             case TokenType::UNARY_MINUS: {
                 if (values.size() < 1) throw std::invalid_argument("Invalid expression: not enough operands for unary -");
-                Polynom val = values.top(); values.pop();
-                Polynom minus_one_poly;
-                std::string m_one_str = "-1";     
-                minus_one_poly = m_one_str;          
-                values.push(minus_one_poly * val);
+                Polynom val = take(values.back()); values.pop_back();
+                values.emplace_back(Polynom() - val);
                 break;
             }
             case TokenType::MULTIPLY: {
                 if (values.size() < 2) throw std::invalid_argument("Invalid expression: not enough operands for *");
-                Polynom val2 = values.top(); values.pop();
-                Polynom val1 = values.top(); values.pop();
-                values.push(val1 * val2);
+                Operand val2 = std::move(values.back()); values.pop_back();
+                Operand val1 = std::move(values.back()); values.pop_back();
+                if (!val1.pending() && !val2.pending()) {
+                    values.emplace_back(std::move(val1.value), std::move(val2.value));
+                }
+                else {
+                    std::vector<Polynom> factors;
+                    collect_factors(val1, factors);
+                    collect_factors(val2, factors);
+                    values.emplace_back(std::move(factors));
+                }
                 break;
             }
             default:
@@ -122,6 +206,6 @@ public:
             std::string error_msg = "Invalid expression: stack has " + std::to_string(values.size()) + " values after RPN evaluation, expected 1.";
             throw std::invalid_argument(error_msg);
         }
-        return values.top();
+        return take(values.back());
     }
 };
\ No newline at end of file
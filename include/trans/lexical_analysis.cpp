@@ -1,5 +1,43 @@
 #include "lexical_analysis.h"
+#include "number_parser.h"
 #include <cctype>
+#include <stdexcept>
+
+namespace {
+
+// A name directly followed by '(' (spaces allowed) is a substitution, not a variable
+TokenType identifier_type(const std::string& input, size_t next) {
+    while (next < input.size() && isspace(input[next])) {
+        ++next;
+    }
+    return next < input.size() && input[next] == '(' ? TokenType::SUBSTITUTE : TokenType::IDENTIFIER;
+}
+
+// Validates the number starting at input[i] and moves it into current_token in one step
+size_t consume_number(const std::string& input, size_t i, bool integer, std::string& current_token) {
+    const char* first = input.data() + i;
+    const char* last = input.data() + input.size();
+    NumberResult number;
+    if (integer) {
+        int power = 0;
+        number = NumberParser::parse_integer(first, last, power);
+    }
+    else {
+        float ratio = 0.0f;
+        number = NumberParser::parse_decimal(first, last, ratio);
+    }
+    if (number.status == NumberStatus::OUT_OF_RANGE) {
+        throw std::invalid_argument("SyntaxError: number out of range at position " + std::to_string(i));
+    }
+    if (number.status == NumberStatus::INVALID) {
+        current_token += input[i];
+        return i;
+    }
+    current_token.append(first, number.ptr);
+    return i + static_cast<size_t>(number.ptr - first) - 1;
+}
+
+}
 
 std::vector<Token> Lexical_analysis::lexus(const std::string& input) {
     if (input.empty()) {
@@ -18,7 +56,11 @@ std::vector<Token> Lexical_analysis::lexus(const std::string& input) {
             if (isspace(s)) {
                 continue;
             }
-            if (isdigit(s) || s == '.' || s == 'x' || s == 'y' || s == 'z') {
+            if (isdigit(s) || s == '.') {
+                i = consume_number(input, i, false, current_token);
+                state = LexerState::BUILDING_POLYNOM_LITERAL;
+            }
+            else if (s == 'x' || s == 'y' || s == 'z') {
                 current_token += s;
                 state = LexerState::BUILDING_POLYNOM_LITERAL;
             }
@@ -28,11 +70,16 @@ std::vector<Token> Lexical_analysis::lexus(const std::string& input) {
             else if (s == ')') {
                 tokens.push_back({ TokenType::RIGHT_PAREN, ")" });
             }
-            else if (s == '*' || s == '+' || s == '=') {
+            else if (s == ',') {
+                tokens.push_back({ TokenType::COMMA, "," });
+            }
+            else if (s == '*' || s == '/' || s == '%' || s == '+' || s == '=') {
                 TokenType type;
                 switch (s) {
                 case '+': type = TokenType::PLUS; break;
                 case '*': type = TokenType::MULTIPLY; break;
+                case '/': type = TokenType::DIVIDE; break;
+                case '%': type = TokenType::MODULO; break;
                 case '=': type = TokenType::EQUAL; break;
                 default:  type = TokenType::UNKNOWN; break;
                 }
@@ -48,6 +95,9 @@ std::vector<Token> Lexical_analysis::lexus(const std::string& input) {
                     tokens.back().type == TokenType::PLUS ||
                     tokens.back().type == TokenType::MINUS ||
                     tokens.back().type == TokenType::MULTIPLY ||
+                    tokens.back().type == TokenType::DIVIDE ||
+                    tokens.back().type == TokenType::MODULO ||
+                    tokens.back().type == TokenType::COMMA ||
                     tokens.back().type == TokenType::EQUAL) {
                     tokens.push_back({ TokenType::UNARY_MINUS, "-" });
                 }
@@ -63,7 +113,11 @@ std::vector<Token> Lexical_analysis::lexus(const std::string& input) {
             break;
 
         case LexerState::BUILDING_POLYNOM_LITERAL:
-            if (isdigit(s) || s == '.' || s == 'x' || s == 'y' || s == 'z' || s == '^') {
+            if (isdigit(s) || s == '.') {
+                bool exponent = !current_token.empty() && current_token.back() == '^';
+                i = consume_number(input, i, exponent, current_token);
+            }
+            else if (s == 'x' || s == 'y' || s == 'z' || s == '^') {
                 current_token += s;
             }
             else {
@@ -83,7 +137,7 @@ std::vector<Token> Lexical_analysis::lexus(const std::string& input) {
                     tokens.push_back({ TokenType::POLYNOM_LITERAL, current_token });
                 }
                 else {
-                    tokens.push_back({ TokenType::IDENTIFIER, current_token });
+                    tokens.push_back({ identifier_type(input, i), current_token });
                 }
                 current_token.clear();
                 state = LexerState::START;
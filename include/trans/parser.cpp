@@ -5,6 +5,8 @@ int Parser::get_priority(TokenType type) {
     case TokenType::UNARY_MINUS:
         return 3;
     case TokenType::MULTIPLY:
+    case TokenType::DIVIDE:
+    case TokenType::MODULO:
         return 2;
     case TokenType::PLUS:
     case TokenType::MINUS:
@@ -27,6 +29,8 @@ std::vector<Token> Parser::transform(const std::vector<Token>& tokens) {
         case TokenType::PLUS:
         case TokenType::MINUS:
         case TokenType::MULTIPLY:
+        case TokenType::DIVIDE:
+        case TokenType::MODULO:
             while (!operators.empty() && operators.top().type != TokenType::LEFT_PAREN &&
                 get_priority(operators.top().type) >= get_priority(token.type)) {
                 rpn.push_back(operators.top());
@@ -35,8 +39,18 @@ std::vector<Token> Parser::transform(const std::vector<Token>& tokens) {
             operators.push(token);
             break;
         case TokenType::UNARY_MINUS:
+        case TokenType::SUBSTITUTE:
             operators.push(token);
             break;
+        case TokenType::COMMA:
+            while (!operators.empty() && operators.top().type != TokenType::LEFT_PAREN) {
+                rpn.push_back(operators.top());
+                operators.pop();
+            }
+            if (operators.empty()) {
+                throw std::invalid_argument("Comma outside of a substitution");
+            }
+            break;
         case TokenType::LEFT_PAREN:
             operators.push(token);
             break;
@@ -47,6 +61,10 @@ std::vector<Token> Parser::transform(const std::vector<Token>& tokens) {
             }
             if (!operators.empty() && operators.top().type == TokenType::LEFT_PAREN) {
                 operators.pop();
+                if (!operators.empty() && operators.top().type == TokenType::SUBSTITUTE) {
+                    rpn.push_back(operators.top());
+                    operators.pop();
+                }
             }
             else {
                 throw std::invalid_argument("Mismatched parentheses");
@@ -1,9 +1,12 @@
 #include "syntax_analysis.h"
 #include <stdexcept>
+#include <vector>
 
 void Syntax_analysis::analyze(const std::vector<Token>& tokens) {
     SyntaxState state = SyntaxState::START;
     int paren_count = 0;
+    // One entry per open '(': the commas seen so far for a substitution, -1 for grouping
+    std::vector<int> commas;
 
     if (tokens.empty() || tokens.front().type == TokenType::END_OF_EXPRESSION) {
         if (tokens.empty() || (tokens.size() == 1 && tokens.front().type == TokenType::END_OF_EXPRESSION))
@@ -18,6 +21,22 @@ void Syntax_analysis::analyze(const std::vector<Token>& tokens) {
 
         if (paren_count < 0) throw std::invalid_argument("SyntaxError: Mismatched parentheses, unexpected ')'");
 
+        if (token.type == TokenType::LEFT_PAREN) {
+            commas.push_back(state == SyntaxState::SUBSTITUTE_S ? 0 : -1);
+        }
+        else if (token.type == TokenType::COMMA) {
+            if (commas.empty() || commas.back() < 0) {
+                throw std::invalid_argument("SyntaxError: ',' outside of a substitution");
+            }
+            commas.back()++;
+        }
+        else if (token.type == TokenType::RIGHT_PAREN) {
+            if (commas.back() >= 0 && commas.back() != 2) {
+                throw std::invalid_argument("SyntaxError: substitution needs 3 arguments, got " + std::to_string(commas.back() + 1));
+            }
+            commas.pop_back();
+        }
+
         switch (state) {
         case SyntaxState::START:
             if (token.type == TokenType::POLYNOM_LITERAL) {
@@ -26,6 +45,9 @@ void Syntax_analysis::analyze(const std::vector<Token>& tokens) {
             else if (token.type == TokenType::IDENTIFIER) {
                 state = SyntaxState::IDENTIFIER_S;
             }
+            else if (token.type == TokenType::SUBSTITUTE) {
+                state = SyntaxState::SUBSTITUTE_S;
+            }
             else if (token.type == TokenType::LEFT_PAREN) {
                 state = SyntaxState::LBRACK_S;
             }
@@ -46,7 +68,10 @@ void Syntax_analysis::analyze(const std::vector<Token>& tokens) {
         case SyntaxState::POLYNOM_LITERAL_S:
             if (token.type == TokenType::PLUS ||
                 token.type == TokenType::MINUS ||
-                token.type == TokenType::MULTIPLY) {
+                token.type == TokenType::MULTIPLY ||
+                token.type == TokenType::DIVIDE ||
+                token.type == TokenType::MODULO ||
+                token.type == TokenType::COMMA) {
                 state = SyntaxState::OPERATOR_S;
             }
             else if (token.type == TokenType::RIGHT_PAREN) {
@@ -63,7 +88,10 @@ void Syntax_analysis::analyze(const std::vector<Token>& tokens) {
         case SyntaxState::IDENTIFIER_S:
             if (token.type == TokenType::PLUS ||
                 token.type == TokenType::MINUS ||
-                token.type == TokenType::MULTIPLY) {
+                token.type == TokenType::MULTIPLY ||
+                token.type == TokenType::DIVIDE ||
+                token.type == TokenType::MODULO ||
+                token.type == TokenType::COMMA) {
                 state = SyntaxState::OPERATOR_S;
             }
             else if (token.type == TokenType::RIGHT_PAREN) {
@@ -87,6 +115,9 @@ void Syntax_analysis::analyze(const std::vector<Token>& tokens) {
             else if (token.type == TokenType::IDENTIFIER) {
                 state = SyntaxState::IDENTIFIER_S;
             }
+            else if (token.type == TokenType::SUBSTITUTE) {
+                state = SyntaxState::SUBSTITUTE_S;
+            }
             else {
                 throw std::invalid_argument("SyntaxError: invalid syntax after unary -, token: " + token.value);
             }
@@ -99,6 +130,9 @@ void Syntax_analysis::analyze(const std::vector<Token>& tokens) {
             else if (token.type == TokenType::IDENTIFIER) {
                 state = SyntaxState::IDENTIFIER_S;
             }
+            else if (token.type == TokenType::SUBSTITUTE) {
+                state = SyntaxState::SUBSTITUTE_S;
+            }
             else if (token.type == TokenType::LEFT_PAREN) {
                 state = SyntaxState::LBRACK_S;
             }
@@ -113,10 +147,22 @@ void Syntax_analysis::analyze(const std::vector<Token>& tokens) {
             }
             break;
 
+        case SyntaxState::SUBSTITUTE_S:
+            if (token.type == TokenType::LEFT_PAREN) {
+                state = SyntaxState::LBRACK_S;
+            }
+            else {
+                throw std::invalid_argument("SyntaxError: expected '(' after " + tokens[i - 1].value);
+            }
+            break;
+
         case SyntaxState::RBRACK_S:
             if (token.type == TokenType::PLUS ||
                 token.type == TokenType::MINUS ||
-                token.type == TokenType::MULTIPLY) {
+                token.type == TokenType::MULTIPLY ||
+                token.type == TokenType::DIVIDE ||
+                token.type == TokenType::MODULO ||
+                token.type == TokenType::COMMA) {
                 state = SyntaxState::OPERATOR_S;
             }
             else if (token.type == TokenType::RIGHT_PAREN) {
@@ -137,6 +183,9 @@ void Syntax_analysis::analyze(const std::vector<Token>& tokens) {
             else if (token.type == TokenType::IDENTIFIER) {
                 state = SyntaxState::IDENTIFIER_S;
             }
+            else if (token.type == TokenType::SUBSTITUTE) {
+                state = SyntaxState::SUBSTITUTE_S;
+            }
             else if (token.type == TokenType::LEFT_PAREN) {
                 state = SyntaxState::LBRACK_S;
             }
@@ -159,6 +208,8 @@ void Syntax_analysis::analyze(const std::vector<Token>& tokens) {
         if (last_meaningful_token.type == TokenType::PLUS ||
             last_meaningful_token.type == TokenType::MINUS ||
             last_meaningful_token.type == TokenType::MULTIPLY ||
+            last_meaningful_token.type == TokenType::DIVIDE ||
+            last_meaningful_token.type == TokenType::MODULO ||
             last_meaningful_token.type == TokenType::UNARY_MINUS ||
             last_meaningful_token.type == TokenType::LEFT_PAREN) {
             throw std::invalid_argument("SyntaxError: expression ends with an operator or '('");
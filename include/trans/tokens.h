@@ -7,9 +7,13 @@
 enum class TokenType {
     POLYNOM_LITERAL,
     IDENTIFIER,
+    SUBSTITUTE,         // name of a variable called as name(qx, qy, qz)
+    COMMA,
     PLUS,
     MINUS,
     MULTIPLY,
+    DIVIDE,
+    MODULO,
     LEFT_PAREN,
     RIGHT_PAREN,
     EQUAL,
@@ -36,5 +40,6 @@ enum class SyntaxState {
     OPERATOR_S,
     UNARY_MINUS_S,
     POLYNOM_LITERAL_S,
-    IDENTIFIER_S
+    IDENTIFIER_S,
+    SUBSTITUTE_S
 };
\ No newline at end of file
@@ -5,6 +5,9 @@
 #include "parser.h"
 #include "calculation.h"   
 #include "polynoms.h"
+#include "polynom_arena.h"
+#include "polynom_system.h"
+#include "polynom_groebner.h"
 
 #include "address_hash.h"
 #include "chain_hash.h"
@@ -20,6 +23,7 @@
 #include <iostream>    
 #include <algorithm>   
 #include <optional>      
+#include <stdexcept>
 #include <type_traits>    
 
 template <typename StorageType>
@@ -29,14 +33,24 @@ private:
     Parser parser;
     Syntax_analysis syn;
     StorageType variables;     
+    PolynomArena::Stats last_line_stats;
 
+    // Temporaries of the line live in an arena; only the final result is copied out to the heap
     Polynom processExpression(const std::string& input) {
-        alculation evaluator_instance;    
+        Сalculation evaluator_instance;    
         try {
             std::vector<Token> tokens = lex.lexus(input);
             syn.analyze(tokens);
             std::vector<Token> rpn = parser.transform(tokens);
-            return evaluator_instance.evaluate(rpn, variables);
+
+            PolynomArena arena;
+            std::optional<Polynom> line_result;
+            {
+                PolynomArena::Scope scope(arena);
+                line_result.emplace(evaluator_instance.evaluate(rpn, variables));
+            }
+            last_line_stats = arena.stats();
+            return Polynom(*line_result);
         }
         catch (const std::exception& e) {
             std::cerr << "Error processing expression \"" << input << "\": " << e.what() << std::endl;
@@ -44,9 +58,69 @@ private:
         }
     }
 
+    std::optional<Polynom> findVariable(const std::string& name) {
+        std::optional<Polynom> found;
+        if constexpr (std::is_same_v<StorageType, AddressHashTable<std::string, Polynom>>) {
+            auto it = variables.find(name);
+            if (it != variables.end()) { found = it->value; }
+        }
+        else if constexpr (std::is_same_v<StorageType, ChainHash<std::string, Polynom>>) {
+            auto it = variables.find(name);
+            if (it != variables.end()) { found = it->second; }
+        }
+        else if constexpr (std::is_base_of_v<BSTree<std::string, Polynom>, StorageType> ||
+            std::is_same_v<StorageType, BSTree<std::string, Polynom>>) {
+            auto* node = variables.find(name);
+            if (node) { found = node->value; }
+        }
+        else if constexpr (std::is_same_v<StorageType, OrderedTable<std::string, Polynom>> ||
+            std::is_same_v<StorageType, UnOrderedTable<std::string, Polynom>>) {
+            auto it = variables.find(name);
+            if (it != variables.end()) { found = it.value(); }   
+        }
+        else if constexpr (std::is_same_v<StorageType, std::map<std::string, Polynom>>) {
+            auto it = variables.find(name);
+            if (it != variables.end()) { found = it->second; }
+        }
+        else {
+            static_assert(!std::is_same_v<StorageType, StorageType>, "Unhandled StorageType in Translator::findVariable.");
+        }
+        return found;
+    }
+
+    std::vector<Polynom> collectVariables(const std::vector<std::string>& names, const char* caller) {
+        std::vector<Polynom> polynoms;
+        polynoms.reserve(names.size());
+        for (const std::string& name : names) {
+            std::optional<Polynom> value = findVariable(name);
+            if (!value.has_value()) {
+                throw std::invalid_argument(std::string("Translator::") + caller + ": undefined variable " + name);
+            }
+            polynoms.push_back(std::move(*value));
+        }
+        return polynoms;
+    }
+
 public:
     Translator() = default;
 
+    // Polynom allocations made by the last evaluated expression and how many of them reached the heap
+    const PolynomArena::Stats& lastLineStats() const {
+        return last_line_stats;
+    }
+
+    // Polynoms of the named variables as one system sharing their monoms (see polynom_system.h);
+    // throws std::invalid_argument for an undefined name
+    PolynomSystem makeSystem(const std::vector<std::string>& names) {
+        return PolynomSystem(collectVariables(names, "makeSystem"));
+    }
+
+    // Groebner basis of the ideal of the named variables (see polynom_groebner.h);
+    // throws std::invalid_argument for an undefined name
+    GroebnerBasis makeBasis(const std::vector<std::string>& names) {
+        return GroebnerBasis(collectVariables(names, "makeBasis"));
+    }
+
     void processInput(const std::string& input_str_orig) {
         std::string input_str = input_str_orig;        
 
@@ -140,31 +214,7 @@ public:
                 potential_var_name.erase(std::remove_if(potential_var_name.begin(), potential_var_name.end(), ::isspace), potential_var_name.end());
 
 
-                if constexpr (std::is_same_v<StorageType, AddressHashTable<std::string, Polynom>>) {
-                    auto it = variables.find(potential_var_name);
-                    if (it != variables.end()) { val_to_print_opt = it->value; }
-                }
-                else if constexpr (std::is_same_v<StorageType, ChainHash<std::string, Polynom>>) {
-                    auto it = variables.find(potential_var_name);
-                    if (it != variables.end()) { val_to_print_opt = it->second; }
-                }
-                else if constexpr (std::is_base_of_v<BSTree<std::string, Polynom>, StorageType> ||
-                    std::is_same_v<StorageType, BSTree<std::string, Polynom>>) {
-                    auto* node = variables.find(potential_var_name);
-                    if (node) { val_to_print_opt = node->value; }
-                }
-                else if constexpr (std::is_same_v<StorageType, OrderedTable<std::string, Polynom>> ||
-                    std::is_same_v<StorageType, UnOrderedTable<std::string, Polynom>>) {
-                    auto it = variables.find(potential_var_name);
-                    if (it != variables.end()) { val_to_print_opt = it.value(); }   
-                }
-                else if constexpr (std::is_same_v<StorageType, std::map<std::string, Polynom>>) {
-                    auto it = variables.find(potential_var_name);
-                    if (it != variables.end()) { val_to_print_opt = it->second; }
-                }
-                else {
-                    static_assert(!std::is_same_v<StorageType, StorageType>, "Unhandled StorageType in Translator::processInput for variable lookup.");
-                }
+                val_to_print_opt = findVariable(potential_var_name);
 
                 if (val_to_print_opt.has_value()) {
                     std::cout << val_to_print_opt.value() << std::endl;
@@ -169,8 +169,8 @@ private:
 
     bool check_red_children_property_recursive(Node* node) const {
         if (!node) return true;
-        if (get_node_color(node) == Color::RED) {
-            if (get_node_color(node->left) == Color::RED || get_node_color(node->right) == Color::RED) {
+        if (get_node_color_rb(node) == Color::RED) {
+            if (get_node_color_rb(node->left) == Color::RED || get_node_color_rb(node->right) == Color::RED) {
                 return false;
             }
         }
@@ -192,7 +192,7 @@ private:
         if (left_bh != right_bh) {
             return -1;
         }
-        return left_bh + (get_node_color(node) == Color::BLACK ? 1 : 0);
+        return left_bh + (get_node_color_rb(node) == Color::BLACK ? 1 : 0);
     }
 
 public:
@@ -266,7 +266,7 @@ public:
 
     bool check_all_rb_properties() const {
         if (root_node == nullptr) return true;
-        if (get_node_color(root_node) != Color::BLACK) {
+        if (get_node_color_rb(root_node) != Color::BLACK) {
             return false;
         }
         if (!check_bst_property_recursive(root_node, nullptr, nullptr)) {
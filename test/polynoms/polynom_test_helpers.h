@@ -0,0 +1,23 @@
+#pragma once
+
+#include "polynoms.h"
+
+#include <cstddef>
+#include <random>
+#include <string>
+
+// Polynom has no operator==: tests compare canonical text (defined in test_polymons.cpp)
+std::string polynomToString(const Polynom& p);
+
+// terms random terms with integer ratios in [-max_ratio, max_ratio] and powers in [0, max_power]
+inline Polynom randomPolynom(std::mt19937& rng, size_t terms, int max_power, int max_ratio) {
+    Polynom p;
+    for (size_t i = 0; i < terms; ++i) {
+        const float ratio = static_cast<float>(static_cast<int>(rng() % (2 * max_ratio + 1)) - max_ratio);
+        const int x = static_cast<int>(rng() % (max_power + 1));
+        const int y = static_cast<int>(rng() % (max_power + 1));
+        const int z = static_cast<int>(rng() % (max_power + 1));
+        p.addMonom(Monom(ratio, { x, y, z }));
+    }
+    return p;
+}
@@ -0,0 +1,101 @@
+#include "number_parser.h"
+
+#include "gtest.h"
+
+#include <charconv>
+#include <cstring>
+#include <random>
+#include <string>
+
+static NumberResult parseDecimal(const std::string& s, float& value) {
+    return NumberParser::parse_decimal(s.data(), s.data() + s.size(), value);
+}
+
+static NumberResult parseInteger(const std::string& s, int& value) {
+    return NumberParser::parse_integer(s.data(), s.data() + s.size(), value);
+}
+
+TEST(NumberParserTest, DecimalSimpleValues) {
+    float v = -1.0f;
+    ASSERT_EQ(NumberStatus::OK, parseDecimal("0", v).status);
+    ASSERT_FLOAT_EQ(0.0f, v);
+    ASSERT_EQ(NumberStatus::OK, parseDecimal("3.5", v).status);
+    ASSERT_FLOAT_EQ(3.5f, v);
+    ASSERT_EQ(NumberStatus::OK, parseDecimal(".25", v).status);
+    ASSERT_FLOAT_EQ(0.25f, v);
+    ASSERT_EQ(NumberStatus::OK, parseDecimal("7.", v).status);
+    ASSERT_FLOAT_EQ(7.0f, v);
+    ASSERT_EQ(NumberStatus::OK, parseDecimal("123456789012", v).status);
+    ASSERT_FLOAT_EQ(123456789012.0f, v);
+}
+
+TEST(NumberParserTest, DecimalStopsAtFirstForeignChar) {
+    std::string s = "12.5x^2";
+    float v = 0.0f;
+    NumberResult r = parseDecimal(s, v);
+    ASSERT_EQ(NumberStatus::OK, r.status);
+    ASSERT_EQ(s.data() + 4, r.ptr);
+
+    s = "1.2.3";
+    r = parseDecimal(s, v);
+    ASSERT_EQ(s.data() + 3, r.ptr);
+}
+
+TEST(NumberParserTest, DecimalErrors) {
+    float v = 0.0f;
+    std::string s = ".";
+    NumberResult r = parseDecimal(s, v);
+    ASSERT_EQ(NumberStatus::INVALID, r.status);
+    ASSERT_EQ(s.data(), r.ptr);
+    ASSERT_EQ(NumberStatus::INVALID, parseDecimal("x", v).status);
+    ASSERT_EQ(NumberStatus::INVALID, parseDecimal("", v).status);
+    ASSERT_EQ(NumberStatus::OUT_OF_RANGE, parseDecimal(std::string(40, '9'), v).status);
+    ASSERT_EQ(NumberStatus::OK, parseDecimal("0." + std::string(60, '0') + "1", v).status);
+    ASSERT_FLOAT_EQ(0.0f, v);
+}
+
+TEST(NumberParserTest, DecimalMatchesFromChars) {
+    std::mt19937 rng(12345);
+    for (int it = 0; it < 20000; ++it) {
+        std::string s;
+        int int_len = rng() % 22;
+        int frac_len = rng() % 22;
+        for (int i = 0; i < int_len; ++i) s += static_cast<char>('0' + rng() % 10);
+        s += '.';
+        for (int i = 0; i < frac_len; ++i) s += static_cast<char>('0' + rng() % 10);
+        if (s == ".") continue;
+
+        float expected = 0.0f;
+        float actual = 0.0f;
+        std::from_chars(s.data(), s.data() + s.size(), expected, std::chars_format::fixed);
+        ASSERT_EQ(NumberStatus::OK, parseDecimal(s, actual).status) << s;
+        ASSERT_EQ(0, std::memcmp(&expected, &actual, sizeof(float))) << s;
+    }
+}
+
+TEST(NumberParserTest, IntegerValues) {
+    int v = -1;
+    ASSERT_EQ(NumberStatus::OK, parseInteger("0", v).status);
+    ASSERT_EQ(0, v);
+    ASSERT_EQ(NumberStatus::OK, parseInteger("42", v).status);
+    ASSERT_EQ(42, v);
+    ASSERT_EQ(NumberStatus::OK, parseInteger("12345678", v).status);
+    ASSERT_EQ(12345678, v);
+    ASSERT_EQ(NumberStatus::OK, parseInteger("000000000000123", v).status);
+    ASSERT_EQ(123, v);
+    ASSERT_EQ(NumberStatus::OK, parseInteger("2147483647", v).status);
+    ASSERT_EQ(2147483647, v);
+
+    std::string s = "17y";
+    NumberResult r = parseInteger(s, v);
+    ASSERT_EQ(17, v);
+    ASSERT_EQ(s.data() + 2, r.ptr);
+}
+
+TEST(NumberParserTest, IntegerErrors) {
+    int v = 0;
+    ASSERT_EQ(NumberStatus::INVALID, parseInteger("", v).status);
+    ASSERT_EQ(NumberStatus::INVALID, parseInteger("-1", v).status);
+    ASSERT_EQ(NumberStatus::OUT_OF_RANGE, parseInteger("2147483648", v).status);
+    ASSERT_EQ(NumberStatus::OUT_OF_RANGE, parseInteger("99999999999999999999999", v).status);
+}
@@ -4,6 +4,10 @@
 #include "gtest.h" 
 
 #include <sstream>    //   operator<<
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <cstdlib>
 
 //        ,
 //   Polynom   operator==
@@ -439,4 +443,413 @@ TEST(PolynomTest, ComplexScenarioSimplification) {
 
     p.addMonom(Monom(-5.0f, { 2,0,0 })); // -5x^2
     ASSERT_EQ("0", polynomToString(p)); // Should be completely zero
-}
\ No newline at end of file
+}
+TEST(PolynomTest, FormatToAppendsToBuffer) {
+    Polynom p;
+    p.addMonom(Monom(2.5f, { 1,0,0 }));
+    p.addMonom(Monom(-1.0f, { 0,2,0 }));
+    p.addMonom(Monom(7.0f));
+
+    std::string buffer = "p = ";
+    p.format_to(buffer);
+    ASSERT_EQ("p = -y^2+2.5x+7", buffer);
+
+    buffer.clear();
+    Polynom().format_to(buffer);
+    ASSERT_EQ("0", buffer);
+}
+
+TEST(PolynomTest, PrintReusesBuffer) {
+    Polynom p;
+    p.addMonom(Monom(3.0f, { 1,1,1 }));
+    std::ostringstream oss;
+    std::string buffer = "stale";
+    p.print(oss, buffer);
+    p.print(oss, buffer);
+    ASSERT_EQ("3xyz3xyz", oss.str());
+    ASSERT_EQ("3xyz", buffer);
+}
+
+TEST(MonomTest, FormatToMatchesStreamFormatting) {
+    const float ratios[] = { 0.1f, 1.5e-5f, 123456.7f, 1234567.9f, -3.14159265f, 2.5e5f, 12345678.0f };
+    for (float r : ratios) {
+        Monom m(r, { 0,1,0 });
+        std::ostringstream expected;
+        if (r == static_cast<long long>(r)) expected << static_cast<long long>(r);
+        else expected << r;
+        expected << "y";
+
+        std::string buffer;
+        m.format_to(buffer);
+        ASSERT_EQ(expected.str(), buffer);
+    }
+}
+
+TEST(PolynomTest, SerializeRoundTripIsExact) {
+    Polynom p;
+    p.addMonom(Monom(0.1f, { 3,0,0 }));
+    p.addMonom(Monom(-1.0f / 3.0f, { 1,2,-4 }));
+    p.addMonom(Monom(123456.789f, { 0,0,0 }));
+    p.addMonom(Monom(7.0f, { -100000,70000,2 }));
+
+    std::vector<unsigned char> bytes = p.serialize();
+    ASSERT_EQ(p.serialized_size(), bytes.size());
+
+    Polynom q = Polynom::deserialize(bytes.data(), bytes.size());
+    ASSERT_EQ(polynomToString(p), polynomToString(q));
+    ASSERT_EQ(bytes, q.serialize());
+}
+
+TEST(PolynomTest, SerializeEmptyAndIntoBuffer) {
+    Polynom empty;
+    std::vector<unsigned char> bytes = empty.serialize();
+    ASSERT_EQ(5u, bytes.size());
+    ASSERT_EQ("0", polynomToString(Polynom::deserialize(bytes.data(), bytes.size())));
+
+    Polynom p;
+    p.addMonom(Monom(2.0f, { 1,0,0 }));
+    unsigned char small[4];
+    ASSERT_THROW(p.serialize(small, sizeof(small)), std::out_of_range);
+
+    unsigned char stream[64];
+    size_t first = p.serialize(stream, sizeof(stream));
+    size_t second = empty.serialize(stream + first, sizeof(stream) - first);
+    size_t consumed = 0;
+    Polynom a = Polynom::deserialize(stream, first + second, consumed);
+    ASSERT_EQ(first, consumed);
+    ASSERT_EQ("2x", polynomToString(a));
+    ASSERT_THROW(Polynom::deserialize(stream, first + second), std::invalid_argument);
+}
+
+TEST(PolynomTest, DeserializeRejectsMalformedInput) {
+    Polynom p;
+    p.addMonom(Monom(2.0f, { 1,0,0 }));
+    p.addMonom(Monom(3.0f, { 0,1,0 }));
+    std::vector<unsigned char> bytes = p.serialize();
+
+    std::vector<unsigned char> bad_magic = bytes;
+    bad_magic[0] = 'X';
+    ASSERT_THROW(Polynom::deserialize(bad_magic.data(), bad_magic.size()), std::invalid_argument);
+
+    std::vector<unsigned char> bad_version = bytes;
+    bad_version[3] = 99;
+    ASSERT_THROW(Polynom::deserialize(bad_version.data(), bad_version.size()), std::invalid_argument);
+
+    ASSERT_THROW(Polynom::deserialize(bytes.data(), bytes.size() - 1), std::invalid_argument);
+
+    // Terms of p written out of order: 3y, then 2x
+    const unsigned char out_of_order[] = { 'P', 'L', 'Y', Polynom::SERIAL_VERSION, 2,
+        0, 2, 0, 0, 0, 0x40, 0x40,
+        2, 1, 0, 0, 0, 0, 0x40 };
+    ASSERT_THROW(Polynom::deserialize(out_of_order, sizeof(out_of_order)), std::invalid_argument);
+}
+
+
+// --- Dense representation ---
+
+typedef std::map<std::vector<int>, float> TermMap;
+
+static std::string termMapToString(const TermMap& terms) {
+    std::vector<Monom> sorted;
+    for (const auto& kv : terms) {
+        if (std::abs(kv.second) > 1e-6f) sorted.push_back(Monom(kv.second, kv.first));
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const Monom& a, const Monom& b) {
+        return compare_powers(a.powers.data(), b.powers.data()) > 0;
+    });
+    if (sorted.empty()) return "0";
+    std::ostringstream oss;
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        if (i != 0 && sorted[i].ratio > 0) oss << "+";
+        oss << sorted[i];
+    }
+    return oss.str();
+}
+
+static Polynom polynomFromTermMap(const TermMap& terms) {
+    Polynom p;
+    for (const auto& kv : terms) p.addMonom(Monom(kv.second, kv.first));
+    return p;
+}
+
+static TermMap cubeTerms(int n, int offset) {
+    TermMap terms;
+    for (int x = 0; x < n; ++x)
+        for (int y = 0; y < n; ++y)
+            for (int z = 0; z < n; ++z)
+                terms[{ x + offset, y, z }] = static_cast<float>((x * 7 + y * 3 + z) % 5 + 1);
+    return terms;
+}
+
+TEST(PolynomDenseTest, SwitchesToDenseWhenFilled) {
+    Polynom sparse;
+    sparse.addMonom(Monom(1.0f, { 10,0,0 }));
+    sparse.addMonom(Monom(1.0f, { 0,0,0 }));
+    ASSERT_FALSE(sparse.is_dense());
+
+    TermMap terms = cubeTerms(4, 0);
+    Polynom p = polynomFromTermMap(terms);
+    ASSERT_TRUE(p.is_dense());
+    ASSERT_EQ(64u, p.size());
+    ASSERT_EQ(termMapToString(terms), polynomToString(p));
+}
+
+TEST(PolynomDenseTest, DenseMultiplicationMatchesReference) {
+    TermMap a = cubeTerms(4, 0);
+    TermMap b = cubeTerms(3, 2);
+    TermMap expected;
+    for (const auto& ta : a)
+        for (const auto& tb : b)
+            expected[{ ta.first[0] + tb.first[0], ta.first[1] + tb.first[1], ta.first[2] + tb.first[2] }] += ta.second * tb.second;
+
+    Polynom pa = polynomFromTermMap(a);
+    Polynom pb = polynomFromTermMap(b);
+    Polynom prod = pa * pb;
+    ASSERT_TRUE(prod.is_dense());
+    ASSERT_EQ(termMapToString(expected), polynomToString(prod));
+
+    Polynom s;
+    s.addMonom(Monom(2.0f, { 0,0,1 }));
+    s.addMonom(Monom(-1.0f, { 1,0,0 }));
+    TermMap expected_mixed;
+    for (const auto& ta : a) {
+        expected_mixed[{ ta.first[0], ta.first[1], ta.first[2] + 1 }] += 2.0f * ta.second;
+        expected_mixed[{ ta.first[0] + 1, ta.first[1], ta.first[2] }] -= ta.second;
+    }
+    ASSERT_EQ(termMapToString(expected_mixed), polynomToString(pa * s));
+    ASSERT_EQ(termMapToString(expected_mixed), polynomToString(s * pa));
+}
+
+TEST(PolynomDenseTest, MixedAdditionAndSubtraction) {
+    TermMap a = cubeTerms(4, 0);
+    Polynom pa = polynomFromTermMap(a);
+
+    Polynom s;
+    s.addMonom(Monom(5.0f, { 1,1,1 }));
+    s.addMonom(Monom(3.0f, { 50,0,0 }));
+    TermMap expected = a;
+    expected[{ 1, 1, 1 }] += 5.0f;
+    expected[{ 50, 0, 0 }] += 3.0f;
+    ASSERT_EQ(termMapToString(expected), polynomToString(pa + s));
+    ASSERT_EQ(termMapToString(expected), polynomToString(s + pa));
+
+    Polynom diff = pa - pa;
+    ASSERT_EQ("0", polynomToString(diff));
+    ASSERT_FALSE(diff.is_dense());
+    ASSERT_EQ(0u, diff.size());
+
+    TermMap doubled = a;
+    for (auto& kv : doubled) kv.second *= 2.0f;
+    Polynom sum = pa + pa;
+    ASSERT_TRUE(sum.is_dense());
+    ASSERT_EQ(termMapToString(doubled), polynomToString(sum));
+}
+
+TEST(PolynomDenseTest, AddAndDeleteMonomOnDense) {
+    TermMap a = cubeTerms(4, 0);
+    Polynom p = polynomFromTermMap(a);
+
+    p.addMonom(Monom(-a[{ 3, 3, 3 }], { 3,3,3 }));
+    a.erase({ 3, 3, 3 });
+    ASSERT_TRUE(p.is_dense());
+    ASSERT_EQ(63u, p.size());
+    ASSERT_EQ(termMapToString(a), polynomToString(p));
+
+    p.addMonom(Monom(1.0f, { 0,0,9 }));
+    a[{ 0, 0, 9 }] = 1.0f;
+    ASSERT_EQ(termMapToString(a), polynomToString(p));
+
+    Polynom q = polynomFromTermMap(cubeTerms(4, 0));
+    q.deleteMonom(0);
+    ASSERT_FALSE(q.is_dense());
+    ASSERT_EQ(63u, q.size());
+}
+
+TEST(PolynomDenseTest, SerializationIsRepresentationIndependent) {
+    Polynom p = polynomFromTermMap(cubeTerms(4, 0));
+    ASSERT_TRUE(p.is_dense());
+    std::vector<unsigned char> bytes = p.serialize();
+    Polynom q = Polynom::deserialize(bytes.data(), bytes.size());
+    ASSERT_TRUE(q.is_dense());
+    ASSERT_EQ(polynomToString(p), polynomToString(q));
+}
+
+
+TEST(PolynomDenseTest, BulkNormalizeMatchesReference) {
+    std::srand(3);
+    for (int large_power = 0; large_power < 2; ++large_power) {
+        CyclicList<Monom> raw;
+        TermMap expected;
+        for (int i = 0; i < 5000; ++i) {
+            std::vector<int> powers = { std::rand() % 40 - 5, std::rand() % 40, std::rand() % 200 };
+            if (large_power && i == 2500) powers[0] = 40000;
+            float ratio = static_cast<float>(std::rand() % 9 - 4) / 2.0f;
+            if (ratio == 0.0f) continue;
+            raw.push_back(Monom(ratio, powers));
+            expected[powers] += ratio;
+        }
+        Polynom p(std::move(raw));
+        ASSERT_EQ(termMapToString(expected), polynomToString(p));
+    }
+}
+
+TEST(PolynomDenseTest, ParallelNormalizeMatchesSerial) {
+    std::srand(5);
+    const size_t count = Polynom::PARALLEL_NORMALIZE_MIN_TERMS + 1000;
+    CyclicList<Monom> raw;
+    for (size_t i = 0; i < count; ++i) {
+        std::vector<int> powers = { std::rand() % 300 - 20, std::rand() % 300, std::rand() % 300 };
+        raw.push_back(Monom(static_cast<float>(std::rand() % 9 + 1) / 4.0f, powers));
+    }
+    CyclicList<Monom> raw_copy = raw;
+
+    Polynom::set_parallel_threads(1);
+    Polynom serial(std::move(raw));
+    Polynom::set_parallel_threads(4);
+    Polynom parallel(std::move(raw_copy));
+    Polynom::set_parallel_threads(0);
+
+    ASSERT_EQ(serial.size(), parallel.size());
+    ASSERT_EQ(serial.hash(), parallel.hash());
+    ASSERT_EQ(serial.serialize(), parallel.serialize());
+}
+
+TEST(PolynomDenseTest, FmaMatchesMultiplyThenAdd) {
+    Polynom cube = polynomFromTermMap(cubeTerms(4, 0));
+    Polynom small;
+    small.addMonom(Monom(2.0f, { 0,0,1 }));
+    small.addMonom(Monom(-1.0f, { 1,0,0 }));
+    Polynom far;
+    far.addMonom(Monom(3.0f, { 500,0,0 }));
+    far.addMonom(Monom(1.0f, { 0,0,0 }));
+
+    const Polynom* operands[] = { &cube, &small, &far };
+    for (const Polynom* a : operands)
+        for (const Polynom* b : operands)
+            for (const Polynom* c : operands)
+                ASSERT_EQ(polynomToString(*a * *b + *c), polynomToString(Polynom::fma(*a, *b, *c)));
+
+    Polynom zero;
+    ASSERT_EQ(polynomToString(far), polynomToString(Polynom::fma(zero, cube, far)));
+    ASSERT_EQ(polynomToString(small * far), polynomToString(Polynom::fma(small, far, zero)));
+    ASSERT_EQ("0", polynomToString(Polynom::fma(small, far, zero - small * far)));
+}
+
+TEST(PolynomDenseTest, ProductTreeMatchesSequentialProduct) {
+    std::vector<Polynom> factors;
+    for (int k = 0; k < 4; ++k) {
+        Polynom grid;
+        for (int i = 0; i < 16; ++i)
+            for (int j = 0; j < 16; ++j)
+                grid.addMonom(Monom((i + j) % 2 ? -1.0f : 1.0f, { i, j, k }));
+        factors.push_back(grid);
+    }
+    factors.push_back(Polynom(std::string_view("x-y")));
+    factors.push_back(Polynom(std::string_view("2z+1")));
+    factors.push_back(Polynom(std::string_view("3")));
+
+    Polynom expected = factors[0];
+    for (size_t i = 1; i < factors.size(); ++i) {
+        expected = expected * factors[i];
+    }
+    Polynom addend(std::string_view("x^40-5"));
+
+    for (size_t threads : { 1, 4 }) {
+        Polynom::set_parallel_threads(threads);
+        ASSERT_EQ(polynomToString(expected), polynomToString(Polynom::product(factors)));
+        ASSERT_EQ(polynomToString(expected + addend), polynomToString(Polynom::fma(factors, addend)));
+    }
+    Polynom::set_parallel_threads(0);
+
+    ASSERT_EQ(polynomToString(factors[4]), polynomToString(Polynom::product({ factors[4] })));
+    ASSERT_EQ(polynomToString(factors[4] + addend), polynomToString(Polynom::fma({ factors[4] }, addend)));
+    ASSERT_EQ("0", polynomToString(Polynom::product({ factors[0], Polynom(), factors[1] })));
+    ASSERT_EQ(polynomToString(addend), polynomToString(Polynom::fma({ factors[0], Polynom() }, addend)));
+    ASSERT_THROW(Polynom::product({}), std::invalid_argument);
+}
+
+// --- Cached metadata ---
+
+static void expectMetadataMatchesRebuilt(const Polynom& p) {
+    std::vector<unsigned char> bytes = p.serialize();
+    Polynom fresh = Polynom::deserialize(bytes.data(), bytes.size());
+    ASSERT_EQ(fresh.degree(), p.degree());
+    for (size_t var = 0; var < 3; ++var) {
+        ASSERT_EQ(fresh.degree(var), p.degree(var));
+    }
+    ASSERT_EQ(fresh.leading_term(), p.leading_term());
+    ASSERT_EQ(fresh.hash(), p.hash());
+}
+
+TEST(PolynomMetadataTest, DegreesAndLeadingTerm) {
+    Polynom p;
+    ASSERT_EQ(Polynom::ZERO_DEGREE, p.degree());
+    ASSERT_EQ(Polynom::ZERO_DEGREE, p.degree(0));
+    ASSERT_EQ(Monom(), p.leading_term());
+    ASSERT_EQ(0u, p.hash());
+
+    p.addMonom(Monom(3.0f, { 2,1,0 }));
+    p.addMonom(Monom(-4.0f, { 0,0,3 }));
+    p.addMonom(Monom(7.0f, { 0,0,0 }));
+    p.addMonom(Monom(1.0f, { -1,0,0 }));
+    ASSERT_EQ(3, p.degree());
+    ASSERT_EQ(2, p.degree(0));
+    ASSERT_EQ(1, p.degree(1));
+    ASSERT_EQ(3, p.degree(2));
+    ASSERT_EQ(Monom(-4.0f, { 0,0,3 }), p.leading_term());
+    ASSERT_THROW(p.degree(3), std::out_of_range);
+
+    p.addMonom(Monom(4.0f, { 0,0,3 }));
+    ASSERT_EQ(3, p.degree());
+    ASSERT_EQ(0, p.degree(2));
+    ASSERT_EQ(Monom(3.0f, { 2,1,0 }), p.leading_term());
+}
+
+TEST(PolynomMetadataTest, HashIgnoresConstructionOrderAndRepresentation) {
+    TermMap terms = cubeTerms(4, 0);
+    Polynom forward = polynomFromTermMap(terms);
+    Polynom backward;
+    for (auto it = terms.rbegin(); it != terms.rend(); ++it) {
+        backward.addMonom(Monom(it->second, it->first));
+    }
+    ASSERT_TRUE(forward.is_dense());
+    ASSERT_EQ(forward.hash(), backward.hash());
+
+    Polynom sparse_copy = forward;
+    sparse_copy.deleteMonom(0);
+    ASSERT_FALSE(sparse_copy.is_dense());
+    ASSERT_NE(forward.hash(), sparse_copy.hash());
+    sparse_copy.addMonom(forward.leading_term());
+    ASSERT_EQ(forward.hash(), sparse_copy.hash());
+    ASSERT_EQ(forward.leading_term(), sparse_copy.leading_term());
+}
+
+TEST(PolynomMetadataTest, ArithmeticResultsCarryMetadata) {
+    TermMap a = cubeTerms(4, 0);
+    Polynom pa = polynomFromTermMap(a);
+    Polynom s;
+    s.addMonom(Monom(2.0f, { 0,0,5 }));
+    s.addMonom(Monom(-1.0f, { 1,0,0 }));
+
+    Polynom prod = pa * s;
+    ASSERT_EQ(pa.degree() + s.degree(), prod.degree());
+    expectMetadataMatchesRebuilt(prod);
+    expectMetadataMatchesRebuilt(pa + s);
+    expectMetadataMatchesRebuilt(s - pa);
+    expectMetadataMatchesRebuilt(pa - pa);
+}
+
+TEST(PolynomMetadataTest, IncrementalUpdatesMatchRebuild) {
+    std::srand(7);
+    Polynom p;
+    for (int step = 0; step < 2000; ++step) {
+        if (p.size() != 0 && std::rand() % 4 == 0) {
+            p.deleteMonom(static_cast<size_t>(std::rand()) % p.size());
+        }
+        else {
+            float ratio = static_cast<float>(std::rand() % 7 - 3);
+            p.addMonom(Monom(ratio, { std::rand() % 5, std::rand() % 5, std::rand() % 5 - 1 }));
+        }
+        expectMetadataMatchesRebuilt(p);
+    }
+}
@@ -0,0 +1,119 @@
+#include "polynoms.h"
+#include "calculation.h"
+#include "polynom_jacobian.h"
+#include "polynom_test_helpers.h"
+
+#include "gtest.h"
+
+#include <cstdlib>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+
+// Counts every global allocation so the tests below can check which paths stay off the heap
+static size_t allocation_count = 0;
+
+void* operator new(size_t size) {
+    allocation_count++;
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    allocation_count++;
+    size_t align = static_cast<size_t>(alignment);
+    if (void* ptr = std::aligned_alloc(align, (size + align - 1) / align * align)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+TEST(PolynomAllocTest, SmallLiteralsStayInline) {
+    size_t before = allocation_count;
+    Polynom p(std::string_view("3x^2y-4z^3+7+x"));
+    Polynom q = p;
+    Polynom sum = p + q;
+    Polynom product = Polynom(std::string_view("x-1")) * Polynom(std::string_view("x+1"));
+    size_t after = allocation_count;
+
+    ASSERT_EQ(before, after);
+    ASSERT_EQ("-4z^3+3x^2y+x+7", polynomToString(p));
+    ASSERT_EQ("-8z^3+6x^2y+2x+14", polynomToString(sum));
+    ASSERT_EQ("x^2-1", polynomToString(product));
+}
+
+TEST(PolynomAllocTest, LargePolynomSpillsToHeap) {
+    Polynom p;
+    for (int i = 0; i < static_cast<int>(Polynom::INLINE_TERMS) + 1; ++i) {
+        p.addMonom(Monom(1.0f, { i, 0, 0 }));
+    }
+    Polynom copy = p;
+    ASSERT_EQ(Polynom::INLINE_TERMS + 1, copy.size());
+    ASSERT_EQ("x^4+x^3+x^2+x+1", polynomToString(copy));
+}
+
+TEST(PolynomAllocTest, EvaluateLiteralLineAllocatesOnlyOperandStack) {
+    // (3x^2y + 2z) * (x - 1) - -(2z * x)
+    std::vector<Token> rpn = {
+        { TokenType::POLYNOM_LITERAL, "3x^2y" }, { TokenType::POLYNOM_LITERAL, "2z" }, { TokenType::PLUS, "+" },
+        { TokenType::POLYNOM_LITERAL, "x" }, { TokenType::POLYNOM_LITERAL, "1" }, { TokenType::MINUS, "-" },
+        { TokenType::MULTIPLY, "*" },
+        { TokenType::POLYNOM_LITERAL, "2z" }, { TokenType::POLYNOM_LITERAL, "x" }, { TokenType::MULTIPLY, "*" },
+        { TokenType::UNARY_MINUS, "-" }, { TokenType::MINUS, "-" }
+    };
+    std::map<std::string, Polynom> storage;
+    Сalculation calc;
+
+    size_t before = allocation_count;
+    Polynom result = calc.evaluate(rpn, storage);
+    size_t after = allocation_count;
+
+    ASSERT_EQ(1, static_cast<int>(after - before));
+    ASSERT_EQ("3x^3y-3x^2y+4xz-2z", polynomToString(result));
+}
+
+TEST(PolynomAllocTest, JacobianEvaluationAllocatesNothing) {
+    std::vector<Polynom> polynoms = { Polynom(std::string_view("3x^2y-4z^3+7+x")), Polynom(std::string_view("x^9y^2z-2xyz")) };
+    JacobianEvaluator evaluator(polynoms);
+    double xs[10], ys[10], zs[10];
+    for (int i = 0; i < 10; ++i) {
+        xs[i] = 0.1 * i;
+        ys[i] = 1.0 - 0.2 * i;
+        zs[i] = 0.5;
+    }
+    double values[2 * 10], jacobian[2 * 3 * 10];
+
+    size_t before = allocation_count;
+    for (int repeat = 0; repeat < 100; ++repeat) {
+        evaluator.evaluate(xs, ys, zs, 10, values, jacobian);
+        evaluator.evaluate(xs[3], ys[3], zs[3], values, jacobian);
+    }
+    size_t after = allocation_count;
+
+    ASSERT_EQ(before, after);
+    ASSERT_DOUBLE_EQ(6.0 * 0.3 * 0.4 + 1.0, jacobian[0]);
+}
+
+TEST(PolynomAllocTest, StringViewConstructorRejectsMalformedInput) {
+    ASSERT_THROW(Polynom(std::string_view("3x^")), std::invalid_argument);
+    ASSERT_THROW(Polynom(std::string_view("3x+")), std::invalid_argument);
+}
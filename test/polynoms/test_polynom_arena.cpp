@@ -0,0 +1,83 @@
+#include "polynoms.h"
+#include "polynom_arena.h"
+#include "translator.h"
+#include "polynom_test_helpers.h"
+
+#include "gtest.h"
+
+#include <map>
+#include <memory_resource>
+#include <string>
+
+static Polynom powerSum(int count) {
+    Polynom p;
+    for (int i = 0; i < count; ++i) {
+        p.addMonom(Monom(1.0f, { i, 0, 0 }));
+    }
+    return p;
+}
+
+TEST(PolynomArenaTest, ScopeRoutesPolynomStorage) {
+    ASSERT_EQ(std::pmr::new_delete_resource(), polynom_resource());
+    PolynomArena arena;
+    {
+        PolynomArena::Scope scope(arena);
+        ASSERT_EQ(arena.resource(), polynom_resource());
+        Polynom p = powerSum(10);
+        ASSERT_EQ(10u, p.size());
+    }
+    ASSERT_EQ(std::pmr::new_delete_resource(), polynom_resource());
+    PolynomArena::Stats stats = arena.stats();
+    ASSERT_GT(stats.requests, 0u);
+    ASSERT_GT(stats.bytes, 0u);
+    ASSERT_EQ(0u, stats.upstream_allocations);
+}
+
+TEST(PolynomArenaTest, ScopesNest) {
+    PolynomArena outer;
+    PolynomArena inner;
+    PolynomArena::Scope outer_scope(outer);
+    {
+        PolynomArena::Scope inner_scope(inner);
+        ASSERT_EQ(inner.resource(), polynom_resource());
+    }
+    ASSERT_EQ(outer.resource(), polynom_resource());
+}
+
+TEST(PolynomArenaTest, ResultCopiedOutSurvivesArena) {
+    Polynom kept;
+    {
+        PolynomArena arena;
+        Polynom scratch;
+        {
+            PolynomArena::Scope scope(arena);
+            Polynom a = powerSum(6);
+            Polynom b = powerSum(3);
+            scratch = a * b + a;
+        }
+        kept = scratch;
+        Polynom copy(scratch);
+        ASSERT_EQ(polynomToString(kept), polynomToString(copy));
+    }
+    ASSERT_EQ("x^7+2x^6+4x^5+4x^4+4x^3+4x^2+3x+2", polynomToString(kept));
+}
+
+TEST(PolynomArenaTest, LargeExpressionsFallBackToUpstream) {
+    PolynomArena arena;
+    {
+        PolynomArena::Scope scope(arena);
+        Polynom p = powerSum(200);
+        Polynom q = p * p;
+        ASSERT_EQ(399u, q.size());
+    }
+    ASSERT_GT(arena.stats().upstream_allocations, 0u);
+}
+
+TEST(PolynomArenaTest, TranslatorReportsLineAllocations) {
+    Translator<std::map<std::string, Polynom>> translator;
+    translator.processInput("p = x+y+z+1");
+    translator.processInput("q = p*p - p");
+    PolynomArena::Stats stats = translator.lastLineStats();
+    ASSERT_GT(stats.requests, 0u);
+    ASSERT_EQ(0u, stats.upstream_allocations);
+}
@@ -0,0 +1,51 @@
+#include "polynoms.h"
+#include "polynom_test_helpers.h"
+
+#include <gtest.h>
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+TEST(PolynomComposeTest, SubstitutesPolynoms) {
+    Polynom x(std::string_view("x"));
+    Polynom y(std::string_view("y"));
+    Polynom z(std::string_view("z"));
+    Polynom p(std::string_view("x^2+y"));
+    ASSERT_EQ(polynomToString(Polynom(std::string_view("x^2+2x+1+y"))), polynomToString(p.compose(Polynom(std::string_view("x+1")), y, z)));
+    ASSERT_EQ(polynomToString(p), polynomToString(p.compose(x, y, z)));
+
+    // swapping variables
+    Polynom q(std::string_view("3x^2y-4z^3+7+x"));
+    ASSERT_EQ(polynomToString(Polynom(std::string_view("3y^2z-4x^3+7+y"))), polynomToString(q.compose(y, z, x)));
+
+    // constants and the zero polynom
+    ASSERT_EQ("5", polynomToString(Polynom(std::string_view("5")).compose(x, y, z)));
+    ASSERT_EQ("0", polynomToString(Polynom().compose(x, y, z)));
+    ASSERT_EQ("7", polynomToString(q.compose(Polynom(), Polynom(), Polynom())));
+}
+
+TEST(PolynomComposeTest, MatchesPointValues) {
+    Polynom p(std::string_view("2x^5y^2-3x^3z+xy^4z^2-7y^3+x-2"));
+    Polynom qx(std::string_view("x+y-1"));
+    Polynom qy(std::string_view("2xz-y^2"));
+    Polynom qz(std::string_view("z^3+x"));
+    Polynom composed = p.compose(qx, qy, qz);
+    const double points[][3] = { { 0.5, -0.25, 0.75 }, { -0.5, 0.3, 0.2 }, { 0.1, 0.9, -0.6 } };
+    for (const auto& point : points) {
+        double x = qx.evaluate(point[0], point[1], point[2]);
+        double y = qy.evaluate(point[0], point[1], point[2]);
+        double z = qz.evaluate(point[0], point[1], point[2]);
+        double expected = p.evaluate(x, y, z);
+        ASSERT_NEAR(expected, composed.evaluate(point[0], point[1], point[2]), 1e-4 * (1.0 + std::abs(expected)));
+    }
+    // xy^4z^2 becomes degree 1 + 2 * 4 + 3 * 2
+    ASSERT_EQ(15, composed.degree());
+}
+
+TEST(PolynomComposeTest, RejectsNegativePowers) {
+    Polynom p;
+    p.addMonom(Monom(1.0f, { -1, 0, 0 }));
+    Polynom x(std::string_view("x+1"));
+    ASSERT_THROW(p.compose(x, x, x), std::invalid_argument);
+}
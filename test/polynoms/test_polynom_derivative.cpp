@@ -0,0 +1,135 @@
+#include "polynom_jacobian.h"
+#include "polynom_parser.h"
+#include "polynom_view.h"
+#include "polynoms.h"
+#include "polynom_test_helpers.h"
+
+#include <gtest.h>
+
+#include <array>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static Polynom densePolynom(int lo) {
+    Polynom p;
+    for (int x = lo; x < lo + 5; ++x)
+        for (int y = 0; y < 4; ++y)
+            for (int z = 0; z < 4; ++z)
+                p.addMonom(Monom(static_cast<float>((x + 2 * y + z) % 5) - 2.0f, { x, y, z }));
+    return p;
+}
+
+TEST(PolynomDerivativeTest, PartialDerivatives) {
+    Polynom p(std::string_view("3x^2y-4z^3+7+x"));
+    ASSERT_EQ("6xy+1", polynomToString(p.derivative(0)));
+    ASSERT_EQ("3x^2", polynomToString(p.derivative(1)));
+    ASSERT_EQ("-12z^2", polynomToString(p.derivative(2)));
+    ASSERT_EQ("0", polynomToString(Polynom(std::string_view("5")).derivative(0)));
+    ASSERT_EQ("0", polynomToString(Polynom().derivative(2)));
+    ASSERT_THROW(p.derivative(3), std::out_of_range);
+
+    Polynom inverse;
+    inverse.addMonom(Monom(2.0f, { -2, 1, 0 }));
+    ASSERT_EQ(polynomToString(Polynom(std::string_view("2x^-2"))), polynomToString(inverse.derivative(1)));
+    Polynom expected;
+    expected.addMonom(Monom(-4.0f, { -3, 1, 0 }));
+    ASSERT_EQ(polynomToString(expected), polynomToString(inverse.derivative(0)));
+}
+
+TEST(PolynomDerivativeTest, ReordersWhenMaxPowerChanges) {
+    // x^3 goes before x^2y^3, but 3x^2 goes after 2xy^3
+    Polynom p(std::string_view("x^3+x^2y^3"));
+    Polynom derived = p.derivative(0);
+    ASSERT_EQ("2xy^3+3x^2", polynomToString(derived));
+    ASSERT_EQ(polynomToString(derived), polynomToString(Polynom(std::string_view("3x^2+2xy^3"))));
+    ASSERT_EQ(3, derived.degree(1));
+
+    // terms whose max power drops interleave with the rest anywhere
+    std::mt19937 rng(42);
+    for (int round = 0; round < 50; ++round) {
+        Polynom q;
+        for (int i = 0; i < 40; ++i) {
+            q.addMonom(Monom(static_cast<float>(rng() % 7) + 1.0f,
+                { static_cast<int>(rng() % 10) - 3, static_cast<int>(rng() % 10) - 3, static_cast<int>(rng() % 10) - 3 }));
+        }
+        DegreeIndex index(q);
+        for (size_t var = 0; var < 3; ++var) {
+            PolynomBuilder expected;
+            for (const PolyTerm& term : index.all()) {
+                int powers[3] = { term.powers[0], term.powers[1], term.powers[2] };
+                powers[var] -= 1;
+                if (term.powers[var] != 0) {
+                    expected.add(term.ratio * static_cast<float>(term.powers[var]), powers[0], powers[1], powers[2]);
+                }
+            }
+            ASSERT_EQ(polynomToString(expected.build()), polynomToString(q.derivative(var)));
+        }
+    }
+}
+
+TEST(PolynomDerivativeTest, DenseMatchesSparse) {
+    for (int lo : { 0, 2, -2 }) {
+        Polynom p = densePolynom(lo);
+        ASSERT_TRUE(p.is_dense());
+        for (size_t var = 0; var < 3; ++var) {
+            Polynom sparse;
+            for (int x = lo; x < lo + 5; ++x)
+                for (int y = 0; y < 4; ++y)
+                    for (int z = 0; z < 4; ++z) {
+                        int powers[3] = { x, y, z };
+                        float ratio = static_cast<float>((x + 2 * y + z) % 5) - 2.0f;
+                        if (ratio != 0.0f && powers[var] != 0) {
+                            float derived = ratio * static_cast<float>(powers[var]);
+                            powers[var] -= 1;
+                            sparse += Monom(derived, { powers[0], powers[1], powers[2] });
+                        }
+                    }
+            ASSERT_EQ(polynomToString(sparse), polynomToString(p.derivative(var))) << "lo " << lo << " var " << var;
+            ASSERT_EQ(sparse.hash(), p.derivative(var).hash());
+        }
+    }
+}
+
+TEST(PolynomDerivativeTest, GradientAndJacobianMatchDerivatives) {
+    std::vector<Polynom> polynoms = {
+        Polynom(std::string_view("3x^2y-4z^3+7+x")),
+        Polynom(std::string_view("x^5y^2z-2xyz+y")),
+        Polynom(),
+        densePolynom(-1),
+    };
+    polynoms[1].addMonom(Monom(0.5f, { -2, 1, -1 }));
+    JacobianEvaluator evaluator(polynoms);
+    ASSERT_EQ(polynoms.size(), evaluator.size());
+
+    const size_t count = 11;
+    std::vector<double> xs(count), ys(count), zs(count);
+    for (size_t i = 0; i < count; ++i) {
+        xs[i] = 0.3 * static_cast<double>(i) - 1.45;
+        ys[i] = std::cos(static_cast<double>(i)) + 0.1;
+        zs[i] = std::sin(static_cast<double>(i)) + 1.2;
+    }
+    std::vector<double> values(polynoms.size() * count), jacobian(polynoms.size() * 3 * count);
+    evaluator.evaluate(xs.data(), ys.data(), zs.data(), count, values.data(), jacobian.data());
+    for (size_t p = 0; p < polynoms.size(); ++p) {
+        std::array<Polynom, 3> gradient = polynoms[p].gradient();
+        for (size_t i = 0; i < count; ++i) {
+            double expected = polynoms[p].evaluate(xs[i], ys[i], zs[i]);
+            ASSERT_NEAR(expected, values[p * count + i], 1e-9 * (1.0 + std::abs(expected)));
+            for (size_t var = 0; var < 3; ++var) {
+                expected = gradient[var].evaluate(xs[i], ys[i], zs[i]);
+                ASSERT_NEAR(expected, jacobian[(p * 3 + var) * count + i], 1e-9 * (1.0 + std::abs(expected)))
+                    << "polynom " << p << " var " << var << " point " << i;
+            }
+        }
+    }
+
+    double value[4], gradient[12];
+    evaluator.evaluate(0.0, 2.0, -1.0, value, gradient);
+    ASSERT_DOUBLE_EQ(polynoms[0].evaluate(0.0, 2.0, -1.0), value[0]);
+    ASSERT_DOUBLE_EQ(1.0, gradient[0]);
+    ASSERT_DOUBLE_EQ(0.0, gradient[1]);
+    ASSERT_DOUBLE_EQ(-12.0, gradient[2]);
+}
@@ -0,0 +1,110 @@
+#include "polynoms.h"
+#include "polynom_test_helpers.h"
+
+#include <gtest.h>
+
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static Polynom univariate(int degree, int seed) {
+    Polynom p;
+    for (int i = 0; i <= degree; ++i) {
+        p.addMonom(Monom(static_cast<float>((i * 7 + seed) % 9) - 4.0f, { i, 0, 0 }));
+    }
+    p.addMonom(Monom(1.0f, { degree + 1, 0, 0 }));
+    return p;
+}
+
+TEST(PolynomDivideTest, UnivariateWithRemainder) {
+    Polynom::Division division = Polynom(std::string_view("x^3-1")).divide(Polynom(std::string_view("x-1")));
+    ASSERT_EQ("x^2+x+1", polynomToString(division.quotient));
+    ASSERT_EQ("0", polynomToString(division.remainder));
+
+    Polynom a(std::string_view("x^3+2x+5"));
+    Polynom b(std::string_view("x^2+1"));
+    ASSERT_EQ("x", polynomToString(a / b));
+    ASSERT_EQ("x+5", polynomToString(a % b));
+    ASSERT_EQ("0", polynomToString(b / a));
+    ASSERT_EQ(polynomToString(b), polynomToString(b % a));
+    ASSERT_EQ("0.5x^3+x+2.5", polynomToString(a / Polynom(std::string_view("2"))));
+    ASSERT_EQ("0", polynomToString(Polynom() / b));
+}
+
+TEST(PolynomDivideTest, LongDivisionRecoversQuotient) {
+    // quotient and divisor both long enough for the Newton path; coefficients growing toward the
+    // leading one keep the roots of the divisor in the unit disk, so the division is well conditioned
+    Polynom b;
+    for (int i = 0; i < 100; ++i) {
+        b.addMonom(Monom(static_cast<float>(i + 1), { i, 0, 0 }));
+    }
+    Polynom q = univariate(199, 2);
+    Polynom r = univariate(80, 3);
+    Polynom a = q * b + r;
+    Polynom::Division division = a.divide(b);
+    ASSERT_EQ(polynomToString(q), polynomToString(division.quotient));
+    ASSERT_EQ(polynomToString(r), polynomToString(division.remainder));
+
+    // short divisor: schoolbook
+    Polynom small(std::string_view("2x^2+x+1"));
+    Polynom::Division short_division = a.divide(small);
+    ASSERT_EQ(polynomToString(a), polynomToString(short_division.quotient * small + short_division.remainder));
+    ASSERT_LT(short_division.remainder.degree(), small.degree());
+}
+
+TEST(PolynomDivideTest, LongDivisionIsExactOnIllConditionedDivisors) {
+    // small integer coefficients keep a = q * b + r exact in floats; most such divisors have roots
+    // outside the unit disk, where the Newton reciprocal blows up and schoolbook must take over
+    std::mt19937 rng(44);
+    auto random = [&rng](int degree, bool monic) {
+        Polynom p;
+        for (int i = 0; i < degree; ++i) {
+            p.addMonom(Monom(static_cast<float>(static_cast<int>(rng() % 5) - 2), { i, 0, 0 }));
+        }
+        p.addMonom(Monom(monic ? 1.0f : static_cast<float>(rng() % 2 + 1), { degree, 0, 0 }));
+        return p;
+    };
+    for (int round = 0; round < 24; ++round) {
+        int divisor_degree = 60 + static_cast<int>(rng() % 20);
+        Polynom b = random(divisor_degree, true);
+        Polynom q = random(60 + static_cast<int>(rng() % 40), false);
+        Polynom r = random(divisor_degree - 1, false);
+        Polynom a = q * b + r;
+        Polynom::Division division = a.divide(b);
+        ASSERT_EQ(polynomToString(q), polynomToString(division.quotient));
+        ASSERT_EQ(polynomToString(r), polynomToString(division.remainder));
+    }
+}
+
+TEST(PolynomDivideTest, MultivariateDivisorSet) {
+    Polynom f(std::string_view("x^2y+xy^2+y^2"));
+    std::vector<Polynom> divisors = { Polynom(std::string_view("xy-1")), Polynom(std::string_view("y^2-1")) };
+    Polynom remainder;
+    std::vector<Polynom> quotients = f.divide(divisors, remainder);
+    ASSERT_EQ(2u, quotients.size());
+    ASSERT_EQ(polynomToString(Polynom(std::string_view("x+y"))), polynomToString(quotients[0]));
+    ASSERT_EQ("1", polynomToString(quotients[1]));
+    ASSERT_EQ(polynomToString(Polynom(std::string_view("x+y+1"))), polynomToString(remainder));
+
+    Polynom a(std::string_view("x^2-y^2"));
+    Polynom b(std::string_view("x-y"));
+    ASSERT_EQ(polynomToString(Polynom(std::string_view("x+y"))), polynomToString(a / b));
+    ASSERT_EQ("0", polynomToString(a % b));
+
+    Polynom c(std::string_view("x^2z+3yz-z+2"));
+    Polynom d(std::string_view("xz+y"));
+    Polynom::Division division = c.divide(d);
+    ASSERT_EQ(polynomToString(c), polynomToString(division.quotient * d + division.remainder));
+}
+
+TEST(PolynomDivideTest, RejectsZeroDivisorAndNegativePowers) {
+    Polynom a(std::string_view("x^2+1"));
+    ASSERT_THROW(a / Polynom(), std::invalid_argument);
+    Polynom remainder;
+    ASSERT_THROW(a.divide({ Polynom(std::string_view("x")), Polynom() }, remainder), std::invalid_argument);
+    Polynom inverse;
+    inverse.addMonom(Monom(1.0f, { -1, 0, 0 }));
+    ASSERT_THROW(inverse / a, std::invalid_argument);
+    ASSERT_THROW(a % inverse, std::invalid_argument);
+}
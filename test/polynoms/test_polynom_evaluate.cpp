@@ -0,0 +1,148 @@
+#include "polynoms.h"
+#include "polynom_test_helpers.h"
+
+#include <gtest.h>
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST(PolynomEvaluateTest, PointValue) {
+    Polynom p(std::string_view("3x^2y-4z^3+7+x"));
+    ASSERT_DOUBLE_EQ(3.0 * 4.0 * -1.0 - 4.0 * 0.125 + 7.0 + 2.0, p.evaluate(2.0, -1.0, 0.5));
+    ASSERT_DOUBLE_EQ(0.0, Polynom().evaluate(1.0, 2.0, 3.0));
+
+    Polynom inverse;
+    inverse.addMonom(Monom(2.0f, { -2, 0, 1 }));
+    ASSERT_DOUBLE_EQ(2.0 / 16.0 * 3.0, inverse.evaluate(4.0, 5.0, 3.0));
+}
+
+TEST(PolynomEvaluateTest, MultipointMatchesPointValues) {
+    Polynom dense;
+    for (int i = 0; i <= 60; ++i) {
+        dense.addMonom(Monom(static_cast<float>(i % 7) - 3.0f, { i, 0, 0 }));
+    }
+    Polynom sparse(std::string_view("x^200-3x^57+2x^3"));
+    Polynom shifted;
+    shifted.addMonom(Monom(1.5f, { -3, 0, 0 }));
+    shifted.addMonom(Monom(-2.0f, { 4, 0, 0 }));
+
+    std::vector<double> xs;
+    for (int i = 0; i < 101; ++i) {
+        xs.push_back(-1.0 + 0.02 * i + 0.001);
+    }
+    for (const Polynom* p : { &dense, &sparse, &shifted }) {
+        ASSERT_TRUE(p->is_univariate());
+        std::vector<double> values = p->evaluate(xs);
+        ASSERT_EQ(xs.size(), values.size());
+        for (size_t i = 0; i < xs.size(); ++i) {
+            double expected = p->evaluate(xs[i], 0.0, 0.0);
+            ASSERT_NEAR(expected, values[i], 1e-9 * (1.0 + std::abs(expected))) << polynomToString(*p) << " at " << xs[i];
+        }
+    }
+    ASSERT_EQ(std::vector<double>(3, 0.0), Polynom().evaluate(std::vector<double>{ 1.0, 2.0, 3.0 }));
+}
+
+TEST(PolynomEvaluateTest, MultipointSplitsAcrossThreads) {
+    Polynom p;
+    for (int i = 0; i < 300; ++i) {
+        p.addMonom(Monom(static_cast<float>(i % 5) - 2.0f, { i, 0, 0 }));
+    }
+    std::vector<double> xs(20000);
+    for (size_t i = 0; i < xs.size(); ++i) {
+        xs[i] = std::sin(static_cast<double>(i));
+    }
+    Polynom::set_parallel_threads(1);
+    std::vector<double> serial = p.evaluate(xs);
+    Polynom::set_parallel_threads(4);
+    std::vector<double> parallel = p.evaluate(xs);
+    Polynom::set_parallel_threads(0);
+    ASSERT_EQ(serial, parallel);
+}
+
+TEST(PolynomEvaluateTest, MultipointRejectsOtherVariables) {
+    Polynom p(std::string_view("x^2+y"));
+    ASSERT_FALSE(p.is_univariate());
+    ASSERT_THROW(p.evaluate(std::vector<double>{ 1.0 }), std::invalid_argument);
+    ASSERT_TRUE(Polynom(std::string_view("5")).is_univariate());
+}
+
+TEST(PolynomEvaluateTest, InterpolateRecoversPolynom) {
+    Polynom p(std::string_view("2x^5-3x^2+x-7"));
+    std::vector<double> xs = { -2.0, -1.0, -0.5, 0.0, 0.5, 1.0, 2.0, 3.0 };
+    std::vector<double> values = p.evaluate(xs);
+    ASSERT_EQ(polynomToString(p), polynomToString(Polynom::interpolate(xs, values)));
+
+    xs.resize(6);
+    values.resize(6);
+    ASSERT_EQ(polynomToString(p), polynomToString(Polynom::interpolate(xs, values)));
+
+    Polynom line = Polynom::interpolate({ 1.0, 3.0 }, { 2.0, 8.0 });
+    ASSERT_EQ("3x-1", polynomToString(line));
+    ASSERT_EQ("0", polynomToString(Polynom::interpolate({}, {})));
+}
+
+TEST(PolynomEvaluateTest, InterpolateThroughManyPoints) {
+    std::vector<double> xs;
+    std::vector<double> values;
+    for (int i = 0; i < 24; ++i) {
+        double x = std::cos(3.14159265358979 * (i + 0.5) / 24);
+        xs.push_back(x);
+        values.push_back(std::exp(x));
+    }
+    // coefficients 1/k! fall below EPSILON after k = 10 and are dropped
+    Polynom p = Polynom::interpolate(xs, values);
+    ASSERT_LE(p.degree(), 10);
+    for (double x = -1.0; x <= 1.0; x += 0.125) {
+        ASSERT_NEAR(std::exp(x), p.evaluate(x, 0.0, 0.0), 1e-6);
+    }
+}
+
+TEST(PolynomEvaluateTest, InterpolateRejectsBadSamples) {
+    ASSERT_THROW(Polynom::interpolate({ 1.0, 2.0 }, { 1.0 }), std::invalid_argument);
+    ASSERT_THROW(Polynom::interpolate({ 1.0, 2.0, 1.0 }, { 1.0, 2.0, 3.0 }), std::invalid_argument);
+}
+
+TEST(PolynomEvaluateTest, GridMatchesPointValues) {
+    Polynom p(std::string_view("3x^2y-4z^3+7+x-2x^3y^2z+5y^4"));
+    p.addMonom(Monom(0.5f, { -1, 2, 0 }));
+    std::vector<double> xs = { -1.5, 0.25, 1.0, 2.0 };
+    std::vector<double> ys = { -2.0, 0.5, 3.0 };
+    std::vector<double> zs = { -1.0, 0.0, 0.75, 1.25, 2.0 };
+    std::vector<double> out;
+    p.evaluate_grid(xs, ys, zs, out);
+    ASSERT_EQ(xs.size() * ys.size() * zs.size(), out.size());
+    for (size_t i = 0; i < xs.size(); ++i)
+        for (size_t j = 0; j < ys.size(); ++j)
+            for (size_t k = 0; k < zs.size(); ++k) {
+                double expected = p.evaluate(xs[i], ys[j], zs[k]);
+                ASSERT_NEAR(expected, out[(i * ys.size() + j) * zs.size() + k], 1e-9 * (1.0 + std::abs(expected)));
+            }
+
+    Polynom().evaluate_grid(xs, ys, zs, out);
+    ASSERT_EQ(std::vector<double>(xs.size() * ys.size() * zs.size(), 0.0), out);
+    p.evaluate_grid(xs, {}, zs, out);
+    ASSERT_TRUE(out.empty());
+}
+
+TEST(PolynomEvaluateTest, GridOfDensePolynomSplitsAcrossThreads) {
+    Polynom p;
+    for (int x = 0; x < 6; ++x)
+        for (int y = 0; y < 6; ++y)
+            for (int z = 0; z < 6; ++z)
+                p.addMonom(Monom(static_cast<float>((x + y * z) % 5) - 2.0f, { x, y, z }));
+    ASSERT_TRUE(p.is_dense());
+    std::vector<double> axis(64);
+    for (size_t i = 0; i < axis.size(); ++i) {
+        axis[i] = -1.0 + 2.0 * static_cast<double>(i) / static_cast<double>(axis.size() - 1);
+    }
+    std::vector<double> serial, parallel;
+    Polynom::set_parallel_threads(1);
+    p.evaluate_grid(axis, axis, axis, serial);
+    Polynom::set_parallel_threads(4);
+    p.evaluate_grid(axis, axis, axis, parallel);
+    Polynom::set_parallel_threads(0);
+    ASSERT_EQ(serial, parallel);
+    ASSERT_NEAR(p.evaluate(axis[3], axis[17], axis[29]), serial[(3 * 64 + 17) * 64 + 29], 1e-9);
+}
@@ -0,0 +1,128 @@
+#include "polynom_parser.h"
+#include "polynom_test_helpers.h"
+
+#include <gtest.h>
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+static Polynom parsed(const char* text) {
+    return Polynom(std::string_view(text));
+}
+
+TEST(PolynomExpressionTest, OperatorsBuildExpressions) {
+    Polynom a = parsed("x+1");
+    Polynom b = parsed("y");
+    static_assert(!std::is_same<decltype(a + b * a - b), Polynom>::value, "evaluated on assignment");
+    static_assert(std::is_convertible<decltype(a + b * a - b), Polynom>::value, "");
+
+    Polynom result = a + b * a - b;
+    ASSERT_EQ("xy+x+1", polynomToString(result));
+    ASSERT_EQ("x^2+2x+1", polynomToString((a + b - b) * a));
+    ASSERT_EQ("0", polynomToString(a - a));
+    ASSERT_EQ("-y", polynomToString(Polynom() - b));
+    ASSERT_EQ("-x+y-1", polynomToString(b - a));
+    ASSERT_EQ("x^2y+xy", polynomToString(a * b * parsed("x")));
+    ASSERT_EQ("x+1", polynomToString((a * b + a) / (b + parsed("1"))));
+}
+
+TEST(PolynomExpressionTest, MatchesStepByStepEvaluation) {
+    std::mt19937 rng(49);
+    for (int round = 0; round < 20; ++round) {
+        const int max_power = round % 2 ? 3 : 39;
+        Polynom a = randomPolynom(rng, 12, max_power, 4);
+        Polynom b = randomPolynom(rng, 12, max_power, 4);
+        Polynom c = randomPolynom(rng, 12, max_power, 4);
+        Polynom d = randomPolynom(rng, 12, max_power, 4);
+
+        Polynom bc = b * c;
+        Polynom expected = a + bc;
+        expected = expected - d;
+        ASSERT_EQ(polynomToString(expected), polynomToString(a + b * c - d));
+
+        expected = a - b;
+        expected = expected - c;
+        expected = expected + d;
+        ASSERT_EQ(polynomToString(expected), polynomToString(a - b - c + d));
+
+        Polynom sum = a + b;
+        Polynom difference = c - d;
+        ASSERT_EQ(polynomToString(sum * difference), polynomToString((a + b) * (c - d)));
+
+        Polynom ab = a * b;
+        Polynom abc = ab * c;
+        expected = d - abc;
+        ASSERT_EQ(polynomToString(expected), polynomToString(d - a * b * c));
+        expected = abc + d;
+        ASSERT_EQ(polynomToString(expected), polynomToString(a * b * c + d));
+
+        Polynom cd = c * d;
+        expected = ab - cd;
+        expected = expected + a;
+        ASSERT_EQ(polynomToString(expected), polynomToString(a * b - c * d + a));
+    }
+}
+
+TEST(PolynomExpressionTest, CompoundAssignment) {
+    Polynom p = parsed("x^2");
+    const Polynom q = parsed("x-1");
+    p += q * q;
+    ASSERT_EQ("2x^2-2x+1", polynomToString(p));
+    p -= q * q + q;
+    ASSERT_EQ("x^2-x+1", polynomToString(p));
+    // The expression refers to p itself: it is evaluated before p changes
+    p = p * p - p;
+    ASSERT_EQ("x^4-2x^3+2x^2-x", polynomToString(p));
+    p += p * q;
+    ASSERT_EQ("x^5-2x^4+2x^3-x^2", polynomToString(p));
+}
+
+TEST(PolynomExpressionTest, TemporariesLiveInTheExpression) {
+    Polynom a = parsed("x+1");
+    auto expression = a * parsed("x-1") + parsed("2");
+    a = parsed("y");
+    // a is read on evaluation, the temporaries were moved into the expression
+    ASSERT_EQ("xy-y+2", polynomToString(expression));
+}
+
+TEST(PolynomExpressionTest, DenseOperands) {
+    std::mt19937 rng(7);
+    Polynom dense;
+    for (int i = 0; i < 8; ++i) {
+        for (int j = 0; j < 8; ++j) {
+            dense.addMonom(Monom(static_cast<float>(rng() % 5 + 1), { i, j, 0 }));
+        }
+    }
+    ASSERT_TRUE(dense.is_dense());
+    Polynom sparse = randomPolynom(rng, 10, 29, 4);
+
+    Polynom expected = dense + sparse;
+    expected = expected - dense;
+    expected = expected + sparse;
+    ASSERT_EQ(polynomToString(expected), polynomToString(dense + sparse - dense + sparse));
+    Polynom product = dense * sparse;
+    expected = product + dense;
+    ASSERT_EQ(polynomToString(expected), polynomToString(dense * sparse + dense));
+}
+
+TEST(PolynomExpressionTest, UsedLikeAPolynom) {
+    Polynom a = parsed("x-1");
+    Polynom b = parsed("x+2");
+    std::ostringstream os;
+    os << a * b << ' ' << a + b - parsed("1");
+    ASSERT_EQ("x^2+x-2 2x", os.str());
+
+    ASSERT_EQ(3u, (a * b).size());
+    ASSERT_EQ(2, (a * b).degree());
+    ASSERT_EQ(-2.0, (a * b).evaluate(0.0, 0.0, 0.0));
+    std::vector<double> roots = (a * b).real_roots();
+    ASSERT_EQ(2u, roots.size());
+    ASSERT_DOUBLE_EQ(-2.0, roots[0]);
+    ASSERT_DOUBLE_EQ(1.0, roots[1]);
+    ASSERT_EQ("2x+1", polynomToString((a * b).derivative(0)));
+    ASSERT_EQ(polynomToString(a), polynomToString((a * b).divide(b).quotient));
+    ASSERT_EQ((a * b).evaluate().hash(), (a * b).hash());
+}
@@ -0,0 +1,53 @@
+#include "polynoms.h"
+#include "polynom_test_helpers.h"
+
+#include <gtest.h>
+
+#include <random>
+#include <stdexcept>
+#include <string>
+
+TEST(PolynomGcdTest, Univariate) {
+    Polynom a(std::string_view("x^2-1"));
+    Polynom b(std::string_view("x^2+2x+1"));
+    ASSERT_EQ("x+1", polynomToString(a.gcd(b)));
+    ASSERT_EQ("x+1", polynomToString(b.gcd(a)));
+    ASSERT_EQ("1", polynomToString(a.gcd(Polynom(std::string_view("x^2+1")))));
+    ASSERT_EQ("x-1", polynomToString(Polynom(std::string_view("0.5x-0.5")).gcd(a)));
+    ASSERT_EQ("x+2", polynomToString(Polynom(std::string_view("-2x-4")).gcd(Polynom())));
+    ASSERT_EQ("0", polynomToString(Polynom().gcd(Polynom())));
+    ASSERT_EQ("1", polynomToString(a.gcd(Polynom(std::string_view("6")))));
+}
+
+TEST(PolynomGcdTest, Multivariate) {
+    Polynom g(std::string_view("xy+z^2-3"));
+    Polynom a = g * Polynom(std::string_view("x+y^2+1"));
+    Polynom b = g * Polynom(std::string_view("xz-2y+5"));
+    ASSERT_EQ(polynomToString(g), polynomToString(a.gcd(b)));
+
+    // a common factor in z alone sits in the content of both polynoms
+    Polynom h(std::string_view("2z+1"));
+    Polynom c = h * g * Polynom(std::string_view("x-y"));
+    Polynom d = h * Polynom(std::string_view("x+y")) * Polynom(std::string_view("y-z"));
+    ASSERT_EQ(polynomToString(h), polynomToString(c.gcd(d)));
+    ASSERT_EQ("1", polynomToString(Polynom(std::string_view("x+y")).gcd(Polynom(std::string_view("x-y")))));
+}
+
+TEST(PolynomGcdTest, RandomCommonFactors) {
+    std::mt19937 rng(45);
+    for (int round = 0; round < 10; ++round) {
+        Polynom g = randomPolynom(rng, 4, 2, 3);
+        Polynom a = g * randomPolynom(rng, 4, 2, 3);
+        Polynom b = g * randomPolynom(rng, 4, 2, 3);
+        Polynom result = a.gcd(b);
+        ASSERT_EQ("0", polynomToString(result % g)) << polynomToString(g);
+        ASSERT_EQ("0", polynomToString(a % result)) << polynomToString(result);
+        ASSERT_EQ("0", polynomToString(b % result)) << polynomToString(result);
+    }
+}
+
+TEST(PolynomGcdTest, RejectsNegativePowers) {
+    Polynom inverse;
+    inverse.addMonom(Monom(1.0f, { 0, -1, 0 }));
+    ASSERT_THROW(inverse.gcd(Polynom(std::string_view("x"))), std::invalid_argument);
+}
@@ -0,0 +1,85 @@
+#include "polynom_groebner.h"
+#include "polynom_test_helpers.h"
+
+#include <gtest.h>
+
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static std::vector<std::string> toStrings(const std::vector<Polynom>& polynoms) {
+    std::vector<std::string> result;
+    for (const Polynom& p : polynoms) {
+        result.push_back(polynomToString(p));
+    }
+    return result;
+}
+
+static std::vector<std::string> toStrings(const std::vector<std::string>& texts) {
+    std::vector<Polynom> polynoms;
+    for (const std::string& text : texts) {
+        polynoms.emplace_back(std::string_view(text));
+    }
+    return toStrings(polynoms);
+}
+
+TEST(GroebnerBasisTest, LinearSystem) {
+    GroebnerBasis basis({ Polynom(std::string_view("x+y+z-6")), Polynom(std::string_view("x-y+2z-5")),
+        Polynom(std::string_view("2x+y-z-1")) });
+    ASSERT_EQ(toStrings({ "z-3", "y-2", "x-1" }), toStrings(basis.polynoms()));
+}
+
+TEST(GroebnerBasisTest, ReducedBasisWithFractions) {
+    // Cox, Little, O'Shea: x^3 - 2xy, x^2y - 2y^2 + x
+    GroebnerBasis basis({ Polynom(std::string_view("x^3-2xy")), Polynom(std::string_view("x^2y-2y^2+x")) });
+    ASSERT_EQ(toStrings({ "y^2-0.5x", "xy", "x^2" }), toStrings(basis.polynoms()));
+    ASSERT_EQ("0", polynomToString(basis.reduce(Polynom(std::string_view("x^3y+y^3")))));
+    ASSERT_EQ(polynomToString(Polynom(std::string_view("0.5x+1"))), polynomToString(basis.reduce(Polynom(std::string_view("y^2+1")))));
+    ASSERT_TRUE(basis.contains(Polynom(std::string_view("x^3-2xy"))));
+    ASSERT_FALSE(basis.contains(Polynom(std::string_view("x"))));
+}
+
+TEST(GroebnerBasisTest, Cyclic3) {
+    GroebnerBasis basis({ Polynom(std::string_view("x+y+z")), Polynom(std::string_view("xy+yz+zx")),
+        Polynom(std::string_view("xyz-1")) });
+    ASSERT_EQ(toStrings({ "x+y+z", "y^2+yz+z^2", "z^3-1" }), toStrings(basis.polynoms()));
+}
+
+TEST(GroebnerBasisTest, InconsistentAndEmpty) {
+    GroebnerBasis unit({ Polynom(std::string_view("xy-1")), Polynom(std::string_view("y")) });
+    ASSERT_EQ(toStrings({ "1" }), toStrings(unit.polynoms()));
+    ASSERT_TRUE(unit.contains(Polynom(std::string_view("x^5+3z"))));
+
+    GroebnerBasis empty({ Polynom() });
+    ASSERT_EQ(0u, empty.size());
+    ASSERT_EQ("x+1", polynomToString(empty.reduce(Polynom(std::string_view("x+1")))));
+    ASSERT_FALSE(empty.contains(Polynom(std::string_view("1"))));
+    ASSERT_TRUE(empty.contains(Polynom()));
+}
+
+TEST(GroebnerBasisTest, RandomIdealMembership) {
+    std::mt19937 rng(46);
+    for (int round = 0; round < 3; ++round) {
+        std::vector<Polynom> generators = { randomPolynom(rng, 5, 2, 3), randomPolynom(rng, 5, 2, 3),
+            randomPolynom(rng, 5, 2, 3) };
+        GroebnerBasis basis(generators);
+        for (const Polynom& g : generators) {
+            ASSERT_TRUE(basis.contains(g));
+        }
+        Polynom member = generators[0] * randomPolynom(rng, 4, 2, 3) + generators[1] * randomPolynom(rng, 4, 2, 3) +
+            generators[2] * randomPolynom(rng, 4, 2, 3);
+        ASSERT_TRUE(basis.contains(member));
+        ASSERT_FALSE(basis.contains(member + Polynom(std::string_view("x"))));
+
+        // the reduced basis is unique: generator order and redundant members do not change it
+        GroebnerBasis other({ generators[2], member, generators[1], generators[0] });
+        ASSERT_EQ(toStrings(basis.polynoms()), toStrings(other.polynoms()));
+    }
+}
+
+TEST(GroebnerBasisTest, RejectsNegativePowers) {
+    Polynom inverse;
+    inverse.addMonom(Monom(1.0f, { -1, 0, 0 }));
+    ASSERT_THROW(GroebnerBasis({ inverse }), std::invalid_argument);
+}
@@ -0,0 +1,89 @@
+#include "polynom_literal.h"
+
+#include <gtest.h>
+
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace polynom_literals;
+
+static std::string print(const Polynom& p) {
+    std::ostringstream oss;
+    oss << p;
+    return oss.str();
+}
+
+static void expect_same(const PolynomLiteral& literal, const std::string& text) {
+    const Polynom expected{ std::string_view(text) };
+    const Polynom actual = literal;
+    EXPECT_EQ(expected.size(), actual.size()) << text;
+    EXPECT_EQ(expected.hash(), actual.hash()) << text;
+    EXPECT_EQ(print(expected), print(actual)) << text;
+}
+
+TEST(PolynomLiteralTest, BuiltAtCompileTime) {
+    constexpr PolynomLiteral p = "x + 3x^2y - 2 + x"_poly;
+    static_assert(p.size() == 3, "equal powers are merged");
+    static_assert(p[0].ratio == 3.0f && p[0].powers[0] == 2 && p[0].powers[1] == 1 && p[0].degree == 3, "");
+    static_assert(p[1].ratio == 2.0f && p[1].powers[0] == 1, "");
+    static_assert(p[2].ratio == -2.0f && p[2].degree == 0, "");
+
+    constexpr PolynomLiteral zero = "x - x + 0.0000001y"_poly;
+    static_assert(zero.size() == 0, "cancelled and tiny terms are dropped");
+    static_assert("0.1"_poly[0].ratio == 0.1f, "rounded to nearest float");
+    static_assert("x^-2 y ^ +3"_poly[0].powers[0] == -2, "");
+
+    const Polynom q = p;
+    EXPECT_EQ("3x^2y+2x-2", print(q));
+    EXPECT_EQ(0u, Polynom("x-x"_poly).size());
+}
+
+TEST(PolynomLiteralTest, MatchesRuntimeParser) {
+    expect_same(""_poly, "");
+    expect_same("  7 "_poly, "  7 ");
+    expect_same("3.5x^2y-4z^3+7"_poly, "3.5x^2y-4z^3+7");
+    expect_same("-3y^-1 + .5x + x x"_poly, "-3y^-1 + .5x + x x");
+    expect_same("z + y + x + xyz + x^3 + y^3z - z^3 + 1"_poly, "z + y + x + xyz + x^3 + y^3z - z^3 + 1");
+    expect_same("0.1x + 0.2x + 0.3x - 0.6x"_poly, "0.1x + 0.2x + 0.3x - 0.6x");
+    expect_same("123456789.123456789 - 16777217x"_poly, "123456789.123456789 - 16777217x");
+    expect_same("0.000001000000000000000000000000000000000000000000000000000001x"_poly,
+        "0.000001000000000000000000000000000000000000000000000000000001x");
+    expect_same("340282346638528859811704183484516925440"_poly, "340282346638528859811704183484516925440");
+    expect_same("x^0000000000002 - 0000.25"_poly, "x^0000000000002 - 0000.25");
+}
+
+TEST(PolynomLiteralTest, RoundsLikeRuntimeParser) {
+    std::mt19937 gen(17);
+    std::uniform_int_distribution<int> digit(0, 9);
+    std::uniform_int_distribution<int> length(1, 30);
+    for (int i = 0; i < 2000; ++i) {
+        std::string text;
+        const int before = length(gen) % 12;
+        const int after = length(gen);
+        for (int j = 0; j < before; ++j) {
+            text += static_cast<char>('0' + digit(gen));
+        }
+        text += '.';
+        for (int j = 0; j < after; ++j) {
+            text += static_cast<char>('0' + digit(gen));
+        }
+        text += "x";
+        expect_same(PolynomLiteral(text.data(), text.size()), text);
+    }
+}
+
+TEST(PolynomLiteralTest, MalformedLiteralThrows) {
+    EXPECT_THROW("3x +"_poly, std::invalid_argument);
+    EXPECT_THROW("x^"_poly, std::invalid_argument);
+    EXPECT_THROW("3 * x"_poly, std::invalid_argument);
+    EXPECT_THROW("x y 2"_poly, std::invalid_argument);
+    EXPECT_THROW("x^2147483648"_poly, std::invalid_argument);
+    EXPECT_THROW("340282366920938463463374607431768211456"_poly, std::invalid_argument);
+    std::string many;
+    for (size_t i = 0; i <= PolynomLiteral::MAX_TERMS; ++i) {
+        many += "+x^" + std::to_string(i);
+    }
+    EXPECT_THROW(PolynomLiteral(many.data(), many.size()), std::invalid_argument);
+}
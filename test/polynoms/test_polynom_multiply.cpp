@@ -0,0 +1,154 @@
+#include "polynom_multiply.h"
+#include "polynoms.h"
+#include "polynom_test_helpers.h"
+
+#include <gtest.h>
+
+#include <climits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Small integer coefficients keep every kernel exact, so results can be compared as text
+static Polynom gridPolynom(int extent_x, int extent_y, int extent_z, int step, int offset) {
+    Polynom p;
+    for (int x = 0; x < extent_x; ++x)
+        for (int y = 0; y < extent_y; ++y)
+            for (int z = 0; z < extent_z; ++z)
+                p.addMonom(Monom(static_cast<float>(((x + y + z) % 2 ? -1 : 1) * ((x + 2 * y + 3 * z) % 3 + 1)),
+                    { x * step + offset, y * step, z * step }));
+    return p;
+}
+
+class MultiplyPlannerTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        MultiplyPlanner::set_override(MultiplyKernel::AUTO);
+        MultiplyPlanner::set_costs(MultiplyCosts());
+        MultiplyPlanner::set_log({});
+    }
+};
+
+TEST_F(MultiplyPlannerTest, EveryKernelMatchesNaive) {
+    Polynom cube = gridPolynom(6, 6, 6, 1, 0);
+    Polynom line = gridPolynom(40, 1, 1, 1, 3);
+    Polynom spread = gridPolynom(5, 5, 2, 3, 0);
+    Polynom wide = gridPolynom(5, 5, 2, 1000, 0);
+    Polynom negative = gridPolynom(4, 3, 2, 1, -5);
+    Polynom binomial(std::string_view("x-y"));
+    const Polynom* operands[] = { &cube, &line, &spread, &wide, &negative, &binomial };
+    const MultiplyKernel kernels[] = { MultiplyKernel::HEAP, MultiplyKernel::HASH, MultiplyKernel::DENSE,
+        MultiplyKernel::KARATSUBA, MultiplyKernel::FFT, MultiplyKernel::AUTO };
+
+    for (const Polynom* a : operands) {
+        for (const Polynom* b : operands) {
+            std::string expected = polynomToString(MultiplyPlanner::multiply(*a, *b, MultiplyKernel::NAIVE));
+            for (MultiplyKernel kernel : kernels) {
+                ASSERT_EQ(expected, polynomToString(MultiplyPlanner::multiply(*a, *b, kernel))) << kernel_name(kernel);
+            }
+        }
+    }
+}
+
+TEST_F(MultiplyPlannerTest, KernelsDropCancelledTerms) {
+    Polynom a(std::string_view("x-y"));
+    Polynom b(std::string_view("x+y"));
+    const MultiplyKernel kernels[] = { MultiplyKernel::NAIVE, MultiplyKernel::HEAP, MultiplyKernel::HASH,
+        MultiplyKernel::DENSE, MultiplyKernel::KARATSUBA, MultiplyKernel::FFT };
+    for (MultiplyKernel kernel : kernels) {
+        Polynom product = MultiplyPlanner::multiply(a, b, kernel);
+        ASSERT_EQ("x^2-y^2", polynomToString(product)) << kernel_name(kernel);
+        ASSERT_EQ(2u, product.size());
+        ASSERT_EQ("0", polynomToString(MultiplyPlanner::multiply(a, Polynom(), kernel)));
+    }
+}
+
+TEST_F(MultiplyPlannerTest, PlanEstimatesFromMetadata) {
+    Polynom cube = gridPolynom(10, 10, 10, 1, 0);
+    MultiplyPlan plan = MultiplyPlanner::plan(cube, cube);
+    ASSERT_EQ(1000000u, plan.pairs);
+    ASSERT_EQ(19u * 19u * 19u, plan.volume);
+    ASSERT_EQ(plan.volume, plan.estimated_terms);
+    ASSERT_DOUBLE_EQ(1.0, plan.estimated_density);
+    ASSERT_FALSE(plan.forced);
+
+    // total degree bounds the product of two linear forms better than its box
+    Polynom linear(std::string_view("x+y+z+1"));
+    plan = MultiplyPlanner::plan(linear, linear);
+    ASSERT_EQ(27u, plan.volume);
+    ASSERT_EQ(10u, plan.estimated_terms);
+    Polynom quadric = linear * linear;
+    plan = MultiplyPlanner::plan(quadric, quadric);
+    ASSERT_EQ(35u, plan.estimated_terms);
+    ASSERT_EQ(125u, plan.volume);
+}
+
+TEST_F(MultiplyPlannerTest, PlannerPicksKernelByShape) {
+    Polynom small(std::string_view("3x^2y-4z^3+7+x"));
+    ASSERT_EQ(MultiplyKernel::NAIVE, MultiplyPlanner::plan(small, small).kernel);
+
+    Polynom cube = gridPolynom(12, 12, 12, 1, 0);
+    MultiplyKernel dense_choice = MultiplyPlanner::plan(cube, cube).kernel;
+    ASSERT_TRUE(dense_choice == MultiplyKernel::DENSE || dense_choice == MultiplyKernel::KARATSUBA ||
+        dense_choice == MultiplyKernel::FFT) << kernel_name(dense_choice);
+
+    // exponents spread over a box far beyond DENSE_MAX_VOLUME
+    Polynom wide = gridPolynom(10, 10, 1, 100000, 0);
+    MultiplyKernel sparse_choice = MultiplyPlanner::plan(wide, wide).kernel;
+    ASSERT_TRUE(sparse_choice == MultiplyKernel::NAIVE || sparse_choice == MultiplyKernel::HEAP ||
+        sparse_choice == MultiplyKernel::HASH) << kernel_name(sparse_choice);
+
+    MultiplyCosts costs;
+    costs.hash_pair = 0.001;
+    costs.output_term = 0.001;
+    MultiplyPlanner::set_costs(costs);
+    ASSERT_EQ(MultiplyKernel::HASH, MultiplyPlanner::plan(wide, wide).kernel);
+}
+
+TEST_F(MultiplyPlannerTest, OverrideFallsBackWhenKernelDoesNotApply) {
+    Polynom wide = gridPolynom(10, 10, 1, 100000, 0);
+    Polynom expected = MultiplyPlanner::multiply(wide, wide, MultiplyKernel::NAIVE);
+
+    MultiplyPlanner::set_override(MultiplyKernel::FFT);
+    ASSERT_EQ(MultiplyKernel::FFT, MultiplyPlanner::override_kernel());
+    MultiplyPlan plan = MultiplyPlanner::plan(wide, wide);
+    ASSERT_TRUE(plan.forced);
+    ASSERT_EQ(MultiplyKernel::NAIVE, plan.kernel);
+    ASSERT_EQ(polynomToString(expected), polynomToString(wide * wide));
+
+    Polynom huge;
+    huge.addMonom(Monom(1.0f, { INT_MAX / 2 + 1, 0, 0 }));
+    huge.addMonom(Monom(1.0f, { 0, 0, 0 }));
+    MultiplyPlanner::set_override(MultiplyKernel::HASH);
+    plan = MultiplyPlanner::plan(huge, huge);
+    ASSERT_EQ(0u, plan.volume);
+    ASSERT_EQ(MultiplyKernel::NAIVE, plan.kernel);
+
+    MultiplyPlanner::set_override(MultiplyKernel::HEAP);
+    Polynom cube = gridPolynom(5, 5, 5, 1, 0);
+    ASSERT_EQ(MultiplyKernel::HEAP, MultiplyPlanner::plan(cube, cube).kernel);
+    ASSERT_EQ(polynomToString(MultiplyPlanner::multiply(cube, cube, MultiplyKernel::NAIVE)), polynomToString(cube * cube));
+}
+
+TEST_F(MultiplyPlannerTest, LogReceivesEveryDecision) {
+    std::vector<MultiplyPlan> plans;
+    MultiplyPlanner::set_log([&plans](const MultiplyPlan& plan) { plans.push_back(plan); });
+
+    Polynom a(std::string_view("x+1"));
+    Polynom b(std::string_view("y-2"));
+    Polynom cube = gridPolynom(8, 8, 8, 1, 0);
+    Polynom small_product = a * b;
+    Polynom large_product = cube * cube;
+    ASSERT_EQ(2u, plans.size());
+    ASSERT_EQ(4u, plans[0].pairs);
+    ASSERT_EQ(MultiplyKernel::NAIVE, plans[0].kernel);
+    ASSERT_EQ(512u * 512u, plans[1].pairs);
+
+    std::ostringstream os;
+    os << plans[1];
+    ASSERT_NE(std::string::npos, os.str().find(kernel_name(plans[1].kernel)));
+
+    MultiplyPlanner::set_log({});
+    Polynom unlogged = cube * a;
+    ASSERT_EQ(2u, plans.size());
+}
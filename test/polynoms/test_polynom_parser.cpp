@@ -0,0 +1,111 @@
+#include "polynom_parser.h"
+
+#include "gtest.h"
+
+#include <sstream>
+#include <string>
+
+static std::string parsedToString(const std::string& input) {
+    Polynom p;
+    ParseResult status = PolynomParser::parse(input, p);
+    EXPECT_TRUE(status.ok()) << status.message() << " at " << status.offset;
+    std::ostringstream oss;
+    oss << p;
+    return oss.str();
+}
+
+TEST(PolynomParserTest, EmptyInputIsZero) {
+    ASSERT_EQ("0", parsedToString(""));
+    ASSERT_EQ("0", parsedToString("   "));
+}
+
+TEST(PolynomParserTest, SingleTerms) {
+    ASSERT_EQ("5", parsedToString("5"));
+    ASSERT_EQ("-2.5", parsedToString("-2.5"));
+    ASSERT_EQ("x", parsedToString("x"));
+    ASSERT_EQ("-3y^-1", parsedToString("-3y^-1"));
+    ASSERT_EQ("xyz", parsedToString("x^1y^1z^1"));
+    ASSERT_EQ("x^2", parsedToString("xx"));
+    ASSERT_EQ("0.5x", parsedToString(".5x"));
+}
+
+TEST(PolynomParserTest, MultiTermLiteral) {
+    ASSERT_EQ("-4z^3+3.5x^2y+7", parsedToString("3.5x^2y-4z^3+7"));
+    ASSERT_EQ("-4z^3+3.5x^2y+7", parsedToString("7 - 4 z ^ 3 + 3.5 x ^ 2 y"));
+}
+
+TEST(PolynomParserTest, CombinesLikeTerms) {
+    ASSERT_EQ("3x+3y", parsedToString("2x+3y+x"));
+    ASSERT_EQ("0", parsedToString("x-x"));
+    ASSERT_EQ("y", parsedToString("x^2+y-x^2"));
+}
+
+TEST(PolynomParserTest, ReportsErrorOffsets) {
+    Polynom p;
+    ParseResult status = PolynomParser::parse("3x+", p);
+    ASSERT_EQ(ParseStatus::DANGLING_SIGN, status.status);
+    ASSERT_EQ(2u, status.offset);
+
+    status = PolynomParser::parse("3x+2w", p);
+    ASSERT_EQ(ParseStatus::UNEXPECTED_CHAR, status.status);
+    ASSERT_EQ(4u, status.offset);
+
+    status = PolynomParser::parse("x^+y", p);
+    ASSERT_EQ(ParseStatus::MISSING_EXPONENT, status.status);
+    ASSERT_EQ(1u, status.offset);
+
+    status = PolynomParser::parse("2+*y", p);
+    ASSERT_EQ(ParseStatus::EXPECTED_TERM, status.status);
+    ASSERT_EQ(2u, status.offset);
+
+    status = PolynomParser::parse("x^99999999999", p);
+    ASSERT_EQ(ParseStatus::NUMBER_OUT_OF_RANGE, status.status);
+    ASSERT_EQ(2u, status.offset);
+
+    status = PolynomParser::parse("x^2147483647x", p);
+    ASSERT_EQ(ParseStatus::NUMBER_OUT_OF_RANGE, status.status);
+    ASSERT_EQ(12u, status.offset);
+
+    status = PolynomParser::parse("y^-2147483647 y^-2", p);
+    ASSERT_EQ(ParseStatus::NUMBER_OUT_OF_RANGE, status.status);
+    ASSERT_EQ(14u, status.offset);
+
+    status = PolynomParser::parse("1.2.3x", p);
+    ASSERT_EQ(ParseStatus::UNEXPECTED_CHAR, status.status);
+    ASSERT_EQ(3u, status.offset);
+}
+
+TEST(PolynomParserTest, LeavesResultUntouchedOnError) {
+    Polynom p;
+    ASSERT_TRUE(PolynomParser::parse("x+y", p).ok());
+    ASSERT_FALSE(PolynomParser::parse("x+", p).ok());
+    std::ostringstream oss;
+    oss << p;
+    ASSERT_EQ("x+y", oss.str());
+}
+
+TEST(PolynomParserTest, AssignmentFromStringThrowsOnError) {
+    Polynom p;
+    std::string s = "2x^";
+    ASSERT_THROW(p = s, std::invalid_argument);
+    s = "-";
+    ASSERT_THROW(p = s, std::invalid_argument);
+    s = "x^2-3y+1";
+    ASSERT_NO_THROW(p = s);
+}
+
+TEST(PolynomParserTest, BuilderHandlesLargeUnsortedInput) {
+    std::string literal;
+    for (int i = 0; i < 2000; ++i) {
+        literal += "+x^" + std::to_string(i % 100);
+    }
+    PolynomBuilder builder;
+    ASSERT_TRUE(PolynomParser::parse(literal, builder).ok());
+    ASSERT_EQ(2000u, builder.size());
+    Polynom p = builder.build();
+    ASSERT_EQ(0u, builder.size());
+
+    std::ostringstream oss;
+    oss << p;
+    ASSERT_EQ(0u, oss.str().find("20x^99+20x^98"));
+}
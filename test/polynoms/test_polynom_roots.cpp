@@ -0,0 +1,92 @@
+#include "polynoms.h"
+
+#include <gtest.h>
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+static Polynom from_roots(const std::vector<int>& roots) {
+    Polynom p(std::string_view("1"));
+    for (int root : roots) {
+        Polynom factor;
+        factor.addMonom(Monom(1.0f, { 1, 0, 0 }));
+        if (root != 0) {
+            factor.addMonom(Monom(static_cast<float>(-root), { 0, 0, 0 }));
+        }
+        p = p * factor;
+    }
+    return p;
+}
+
+static void expect_roots(const std::vector<double>& expected, const std::vector<double>& actual, double tolerance) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_NEAR(expected[i], actual[i], tolerance) << "root " << i;
+    }
+}
+
+TEST(PolynomRootsTest, SimpleAndMissingRoots) {
+    expect_roots({ -3.0, 1.0, 2.0 }, from_roots({ 1, 2, -3 }).real_roots(), 1e-12);
+    expect_roots({}, Polynom(std::string_view("x^2+1")).real_roots(), 0.0);
+    expect_roots({}, Polynom(std::string_view("5")).real_roots(), 0.0);
+    expect_roots({ -std::sqrt(2.0), std::sqrt(2.0) }, Polynom(std::string_view("x^2-2")).real_roots(), 1e-14);
+    // (x - 1)(x - 1 - 2^-10): close roots
+    expect_roots({ 1.0, 1.0 + 1.0 / 1024.0 }, Polynom(std::string_view("x^2-2.0009765625x+1.0009765625")).real_roots(), 1e-12);
+}
+
+TEST(PolynomRootsTest, MultipleZeroAndPoleRoots) {
+    expect_roots({ 0.0 }, Polynom(std::string_view("x^3")).real_roots(), 0.0);
+    expect_roots({ -0.5, 1.0 }, (from_roots({ 1, 1, 1 }) * Polynom(std::string_view("x^2+x+0.25"))).real_roots(), 1e-12);
+    expect_roots({ -2.0, 0.0, 3.0 }, from_roots({ 0, 0, -2, 3, 3 }).real_roots(), 1e-12);
+    Polynom pole;
+    pole.addMonom(Monom(1.0f, { 1, 0, 0 }));
+    pole.addMonom(Monom(-4.0f, { -1, 0, 0 }));
+    expect_roots({ -2.0, 2.0 }, pole.real_roots(), 1e-14);
+}
+
+TEST(PolynomRootsTest, Wilkinson) {
+    std::vector<int> roots = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    expect_roots({ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 }, from_roots(roots).real_roots(), 1e-9);
+}
+
+TEST(PolynomRootsTest, CoefficientsOfVeryDifferentSize) {
+    // the small root makes x^29 (x - 3000) cancel against 1; counted in doubles it was lost
+    expect_roots({ 0.758757601802168, 3000.0 }, Polynom(std::string_view("x^30-3000x^29+1")).real_roots(), 1e-12);
+    expect_roots({ 0.814415570543648, 3000.0 }, Polynom(std::string_view("x^40-3000x^39+1")).real_roots(), 1e-12);
+}
+
+TEST(PolynomRootsTest, BatchMatchesSingle) {
+    std::mt19937 rng(47);
+    std::vector<Polynom> polynoms;
+    for (int i = 0; i < 100; ++i) {
+        std::vector<int> roots;
+        for (int k = 0; k < 1 + i % 6; ++k) {
+            roots.push_back(static_cast<int>(rng() % 21) - 10);
+        }
+        polynoms.push_back(from_roots(roots) + Polynom(std::string_view(i % 3 ? "0" : "0.5")));
+    }
+    std::vector<std::vector<double>> batch = Polynom::real_roots(polynoms);
+    ASSERT_EQ(polynoms.size(), batch.size());
+    for (size_t i = 0; i < polynoms.size(); ++i) {
+        ASSERT_EQ(polynoms[i].real_roots(), batch[i]);
+        for (double root : batch[i]) {
+            ASSERT_NEAR(0.0, polynoms[i].evaluate(root, 0.0, 0.0), 1e-6 * (1.0 + std::pow(std::abs(root), polynoms[i].degree())));
+        }
+    }
+}
+
+TEST(PolynomRootsTest, RejectsZeroAndMultivariate) {
+    ASSERT_THROW(Polynom().real_roots(), std::invalid_argument);
+    ASSERT_THROW(Polynom(std::string_view("x+y")).real_roots(), std::invalid_argument);
+}
+
+TEST(PolynomRootsTest, BatchRethrowsFromWorkers) {
+    std::vector<Polynom> polynoms(100, from_roots({ 1, 2 }));
+    polynoms[97] = Polynom(std::string_view("x+y"));
+    Polynom::set_parallel_threads(4);
+    EXPECT_THROW(Polynom::real_roots(polynoms), std::invalid_argument);
+    Polynom::set_parallel_threads(1);
+    EXPECT_THROW(Polynom::real_roots(polynoms), std::invalid_argument);
+    Polynom::set_parallel_threads(0);
+}
@@ -0,0 +1,105 @@
+#include "polynom_system.h"
+#include "polynoms.h"
+
+#include <gtest.h>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+static std::vector<Polynom> samplePolynoms() {
+    std::vector<Polynom> polynoms;
+    polynoms.emplace_back(std::string_view("3x^2y-4z^3+7+x"));
+    polynoms.emplace_back(std::string_view("x^2y+x^2y^2z-2"));
+    polynoms.emplace_back(std::string_view("5"));
+    polynoms.emplace_back();
+    Polynom inverse(std::string_view("y^3"));
+    inverse.addMonom(Monom(2.0f, { -2, 0, 1 }));
+    inverse.addMonom(Monom(-0.5f, { 1, -1, -3 }));
+    polynoms.push_back(inverse);
+    Polynom dense;
+    for (int x = 0; x < 4; ++x)
+        for (int y = 0; y < 4; ++y)
+            for (int z = 0; z < 4; ++z)
+                dense.addMonom(Monom(static_cast<float>((x + y * z) % 5) - 2.0f, { x, y, z }));
+    polynoms.push_back(dense);
+    return polynoms;
+}
+
+TEST(PolynomSystemTest, MatchesPolynomEvaluate) {
+    std::vector<Polynom> polynoms = samplePolynoms();
+    PolynomSystem system(polynoms);
+    ASSERT_EQ(polynoms.size(), system.size());
+    const double points[][3] = { { 2.0, -1.0, 0.5 }, { -1.5, 0.25, 3.0 }, { 0.75, 2.0, -1.25 } };
+    for (const auto& point : points) {
+        std::vector<double> values = system.evaluate(point[0], point[1], point[2]);
+        ASSERT_EQ(polynoms.size(), values.size());
+        for (size_t p = 0; p < polynoms.size(); ++p) {
+            double expected = polynoms[p].evaluate(point[0], point[1], point[2]);
+            ASSERT_NEAR(expected, values[p], 1e-9 * (1.0 + std::abs(expected))) << "polynom " << p;
+        }
+    }
+    ASSERT_EQ(0u, PolynomSystem().size());
+    ASSERT_EQ(1u, PolynomSystem().monom_count());
+}
+
+TEST(PolynomSystemTest, SharesMonomsAcrossPolynoms) {
+    std::vector<Polynom> polynoms = {
+        Polynom(std::string_view("x^2+xy")),
+        Polynom(std::string_view("2x^2-xy+1")),
+        Polynom(std::string_view("x^2y")),
+    };
+    // 1, x, x^2, xy, x^2y: no helper monoms and every monom once
+    ASSERT_EQ(5u, PolynomSystem(polynoms).monom_count());
+
+    // z^3 needs the helpers z and z^2
+    ASSERT_EQ(4u, PolynomSystem({ Polynom(std::string_view("z^3")) }).monom_count());
+}
+
+TEST(PolynomSystemTest, BatchMatchesPointValues) {
+    std::vector<Polynom> polynoms = samplePolynoms();
+    PolynomSystem system(polynoms);
+    const size_t count = 21;
+    std::vector<double> xs(count), ys(count), zs(count);
+    for (size_t i = 0; i < count; ++i) {
+        xs[i] = std::sin(static_cast<double>(i)) + 1.5;
+        ys[i] = std::cos(static_cast<double>(i)) - 1.5;
+        zs[i] = 0.1 * static_cast<double>(i) + 0.05;
+    }
+    std::vector<double> out(polynoms.size() * count);
+    system.evaluate_batch(xs.data(), ys.data(), zs.data(), count, out.data());
+    for (size_t p = 0; p < polynoms.size(); ++p) {
+        for (size_t i = 0; i < count; ++i) {
+            double expected = polynoms[p].evaluate(xs[i], ys[i], zs[i]);
+            ASSERT_NEAR(expected, out[p * count + i], 1e-9 * (1.0 + std::abs(expected))) << "polynom " << p << " point " << i;
+        }
+    }
+    system.evaluate_batch(xs.data(), ys.data(), zs.data(), 0, out.data());
+}
+
+TEST(PolynomSystemTest, BatchSplitsAcrossThreads) {
+    std::vector<Polynom> polynoms;
+    for (int i = 0; i < 20; ++i) {
+        Polynom p;
+        for (int k = 0; k < 30; ++k) {
+            p.addMonom(Monom(static_cast<float>((i + k) % 7) - 3.0f, { k % 5, (k + i) % 4, (k * i) % 3 }));
+        }
+        polynoms.push_back(p);
+    }
+    PolynomSystem system(polynoms);
+    const size_t count = 4000;
+    std::vector<double> xs(count), ys(count), zs(count);
+    for (size_t i = 0; i < count; ++i) {
+        xs[i] = std::sin(static_cast<double>(i));
+        ys[i] = std::cos(static_cast<double>(i));
+        zs[i] = std::sin(0.5 * static_cast<double>(i));
+    }
+    std::vector<double> serial(polynoms.size() * count), parallel(polynoms.size() * count);
+    Polynom::set_parallel_threads(1);
+    system.evaluate_batch(xs.data(), ys.data(), zs.data(), count, serial.data());
+    Polynom::set_parallel_threads(4);
+    system.evaluate_batch(xs.data(), ys.data(), zs.data(), count, parallel.data());
+    Polynom::set_parallel_threads(0);
+    ASSERT_EQ(serial, parallel);
+    ASSERT_NEAR(polynoms[7].evaluate(xs[123], ys[123], zs[123]), serial[7 * count + 123], 1e-9);
+}
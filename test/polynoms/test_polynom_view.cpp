@@ -0,0 +1,87 @@
+#include "polynom_parser.h"
+#include "polynom_view.h"
+#include "polynom_test_helpers.h"
+
+#include <gtest.h>
+
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST(PolynomViewTest, DegreeSlices) {
+    const Polynom p(std::string_view("x^3 + 2x^2y - z^3 + xy + 4y^2 - 5z + 7"));
+    DegreeIndex index(p);
+    ASSERT_EQ(7u, index.size());
+    ASSERT_EQ((std::vector<int>{ 0, 1, 2, 3 }), index.degrees());
+    ASSERT_EQ("x^3-z^3+2x^2y", polynomToString(index.degree(3).to_polynom()));
+    ASSERT_EQ("4y^2+xy", polynomToString(index.degree(2).to_polynom()));
+    ASSERT_EQ("7", polynomToString(index.degree(0).to_polynom()));
+    ASSERT_TRUE(index.degree(4).empty());
+    ASSERT_TRUE(index.degree(-1).empty());
+    ASSERT_EQ(0u, index.degree(5).size());
+
+    // Views refer to the polynom's own storage
+    const PolyTerm& first = *index.degree(3).begin();
+    ASSERT_EQ(&first, &*index.all().begin());
+    ASSERT_EQ(3, first.degree);
+
+    // Degrees too far apart for counting
+    const Polynom wide(std::string_view("x^100000 - x^-100000 + y^100000z + 2"));
+    DegreeIndex wide_index(wide);
+    ASSERT_EQ((std::vector<int>{ -100000, 0, 100000, 100001 }), wide_index.degrees());
+    ASSERT_EQ("x^100000", polynomToString(wide_index.degree(100000).to_polynom()));
+    ASSERT_EQ("-x^-100000", polynomToString(wide_index.degree(-100000).to_polynom()));
+}
+
+TEST(PolynomViewTest, LeadingTermsAndVariableFilter) {
+    const Polynom p(std::string_view("x^3 + 2x^2y - z^3 + xy + 4y^2 - 5z + 7"));
+    DegreeIndex index(p);
+    ASSERT_EQ("x^3-z^3", polynomToString(index.leading(2).to_polynom()));
+    ASSERT_EQ(polynomToString(p), polynomToString(index.leading(100).to_polynom()));
+    ASSERT_EQ(0u, index.leading(0).size());
+
+    ASSERT_EQ("x^3+2x^2y+4y^2+xy+7", polynomToString(index.all().without(2).to_polynom()));
+    ASSERT_EQ(5u, index.all().without(2).size());
+    ASSERT_EQ("x^3+7", polynomToString(index.all().without(1).without(2).to_polynom()));
+    ASSERT_EQ("x^3+2x^2y", polynomToString(index.degree(3).without(2).to_polynom()));
+    ASSERT_EQ("-z^3", polynomToString(index.degree(3).without(0).to_polynom()));
+    ASSERT_TRUE(index.degree(2).without(1).empty());
+    ASSERT_THROW(index.all().without(3), std::out_of_range);
+
+    // An iterator does not depend on the view it came from
+    TermView::iterator it = index.degree(2).without(0).begin();
+    ASSERT_EQ(4.0f, it->ratio);
+}
+
+TEST(PolynomViewTest, SlicesPartitionThePolynom) {
+    std::mt19937 rng(50);
+    for (int round = 0; round < 10; ++round) {
+        const Polynom p = randomPolynom(rng, 300, round % 2 ? 5 : 59, 4);
+        DegreeIndex index(p);
+        ASSERT_EQ(p.is_dense(), round % 2 == 1);
+        ASSERT_EQ(p.size(), index.size());
+
+        Polynom sum;
+        size_t terms = 0;
+        for (int degree : index.degrees()) {
+            TermView slice = index.degree(degree);
+            for (const PolyTerm& term : slice) {
+                ASSERT_EQ(degree, term.degree);
+            }
+            terms += slice.size();
+            sum = sum + slice.to_polynom();
+        }
+        ASSERT_EQ(p.size(), terms);
+        ASSERT_EQ(p.hash(), sum.hash());
+
+        Polynom outside_z = index.all().without(2).to_polynom();
+        Polynom expected;
+        for (const PolyTerm& term : index.all()) {
+            if (term.powers[2] == 0) {
+                expected.addMonom(Monom(term.ratio, { term.powers[0], term.powers[1], 0 }));
+            }
+        }
+        ASSERT_EQ(polynomToString(expected), polynomToString(outside_z));
+    }
+}
@@ -0,0 +1,170 @@
+#include "small_vector.h"
+
+#include <gtest.h>
+
+#include <memory_resource>
+#include <stdexcept>
+#include <utility>
+
+
+TEST(SmallVector, StartsEmptyAndInline) {
+    SmallVector<int, 4> v;
+    ASSERT_TRUE(v.empty());
+    ASSERT_EQ(0u, v.size());
+    ASSERT_EQ(4u, v.capacity());
+    ASSERT_FALSE(v.is_heap_allocated());
+}
+
+TEST(SmallVector, StaysInlineUpToCapacity) {
+    SmallVector<int, 4> v;
+    for (int i = 0; i < 4; ++i) {
+        v.push_back(i);
+    }
+    ASSERT_FALSE(v.is_heap_allocated());
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_EQ(i, v[i]);
+    }
+}
+
+TEST(SmallVector, SpillsToHeapAndKeepsElements) {
+    SmallVector<int, 2> v;
+    for (int i = 0; i < 100; ++i) {
+        v.push_back(i * 3);
+    }
+    ASSERT_TRUE(v.is_heap_allocated());
+    ASSERT_EQ(100u, v.size());
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(i * 3, v[i]);
+    }
+    ASSERT_EQ(297, v.back());
+}
+
+TEST(SmallVector, PushBackOwnElementDuringGrowth) {
+    SmallVector<int, 2> v;
+    v.push_back(7);
+    v.push_back(8);
+    v.push_back(v[0]);
+    ASSERT_EQ(3u, v.size());
+    ASSERT_EQ(7, v[2]);
+}
+
+TEST(SmallVector, InsertAndErase) {
+    SmallVector<int, 3> v;
+    v.push_back(1);
+    v.push_back(3);
+    v.insert(1, 2);
+    v.insert(0, 0);
+    v.insert(4, 4);
+    ASSERT_EQ(5u, v.size());
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_EQ(i, v[i]);
+    }
+    v.erase(0);
+    v.erase(3);
+    ASSERT_EQ(3u, v.size());
+    ASSERT_EQ(1, v[0]);
+    ASSERT_EQ(3, v[2]);
+    ASSERT_THROW(v.insert(5, 0), std::out_of_range);
+    ASSERT_THROW(v.erase(3), std::out_of_range);
+}
+
+TEST(SmallVector, CopyIsIndependent) {
+    SmallVector<int, 2> inline_v;
+    inline_v.push_back(1);
+    SmallVector<int, 2> heap_v;
+    for (int i = 0; i < 10; ++i) heap_v.push_back(i);
+
+    SmallVector<int, 2> a(inline_v);
+    SmallVector<int, 2> b(heap_v);
+    a[0] = 42;
+    b[0] = 42;
+    ASSERT_EQ(1, inline_v[0]);
+    ASSERT_EQ(0, heap_v[0]);
+    ASSERT_FALSE(a.is_heap_allocated());
+    ASSERT_EQ(10u, b.size());
+
+    a = heap_v;
+    ASSERT_EQ(10u, a.size());
+    ASSERT_EQ(9, a[9]);
+}
+
+TEST(SmallVector, MoveTransfersStorage) {
+    SmallVector<int, 2> heap_v;
+    for (int i = 0; i < 10; ++i) heap_v.push_back(i);
+    const int* heap_data = heap_v.data();
+
+    SmallVector<int, 2> moved(std::move(heap_v));
+    ASSERT_EQ(heap_data, moved.data());
+    ASSERT_EQ(10u, moved.size());
+    ASSERT_TRUE(heap_v.empty());
+    ASSERT_FALSE(heap_v.is_heap_allocated());
+
+    SmallVector<int, 2> inline_v;
+    inline_v.push_back(5);
+    moved = std::move(inline_v);
+    ASSERT_EQ(1u, moved.size());
+    ASSERT_EQ(5, moved[0]);
+    ASSERT_FALSE(moved.is_heap_allocated());
+}
+
+TEST(SmallVector, ResizeClearAndReset) {
+    SmallVector<int, 2> v;
+    v.resize(5);
+    ASSERT_EQ(5u, v.size());
+    ASSERT_EQ(0, v[4]);
+    v.resize(1);
+    ASSERT_EQ(1u, v.size());
+    v.clear();
+    ASSERT_TRUE(v.empty());
+    ASSERT_TRUE(v.is_heap_allocated());
+    v.reset();
+    ASSERT_FALSE(v.is_heap_allocated());
+    ASSERT_THROW(v.pop_back(), std::out_of_range);
+    ASSERT_THROW(v.back(), std::out_of_range);
+}
+
+TEST(SmallVector, Swap) {
+    SmallVector<int, 2> a;
+    a.push_back(1);
+    SmallVector<int, 2> b;
+    for (int i = 0; i < 5; ++i) b.push_back(i);
+    a.swap(b);
+    ASSERT_EQ(5u, a.size());
+    ASSERT_EQ(1u, b.size());
+    ASSERT_EQ(1, b[0]);
+    ASSERT_EQ(4, a[4]);
+}
+
+TEST(SmallVector, AllocatesFromGivenResource) {
+    unsigned char buffer[1024];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+    SmallVector<int, 2> v(&arena);
+    for (int i = 0; i < 10; ++i) v.push_back(i);
+    ASSERT_TRUE(v.is_heap_allocated());
+    ASSERT_EQ(&arena, v.resource());
+    ASSERT_GE(reinterpret_cast<unsigned char*>(v.data()), buffer);
+    ASSERT_LT(reinterpret_cast<unsigned char*>(v.data()), buffer + sizeof(buffer));
+
+    SmallVector<int, 2> copy(v);
+    ASSERT_EQ(std::pmr::get_default_resource(), copy.resource());
+    ASSERT_EQ(9, copy[9]);
+}
+
+TEST(SmallVector, MoveAssignAcrossResourcesCopies) {
+    unsigned char buffer[1024];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+    SmallVector<int, 2> source(&arena);
+    for (int i = 0; i < 10; ++i) source.push_back(i);
+
+    SmallVector<int, 2> target;
+    target = std::move(source);
+    ASSERT_EQ(std::pmr::get_default_resource(), target.resource());
+    ASSERT_NE(source.data(), target.data());
+    ASSERT_EQ(10u, target.size());
+    ASSERT_EQ(9, target[9]);
+
+    SmallVector<int, 2> same(&arena);
+    const int* arena_data = source.data();
+    same = std::move(source);
+    ASSERT_EQ(arena_data, same.data());
+}
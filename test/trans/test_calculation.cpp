@@ -0,0 +1,110 @@
+#include "calculation.h"
+#include "lexical_analysis.h"
+#include "parser.h"
+#include "polynoms.h"
+#include "syntax_analysis.h"
+#include "../polynoms/polynom_test_helpers.h"
+
+#include <gtest.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+static Polynom evaluateLine(const std::string& line, std::map<std::string, Polynom>& storage) {
+    Lexical_analysis lex;
+    Parser parser;
+    Сalculation calc;
+    return calc.evaluate(parser.transform(lex.lexus(line)), storage);
+}
+
+class CalculationTest : public ::testing::Test {
+protected:
+    std::map<std::string, Polynom> storage;
+
+    void SetUp() override {
+        storage["p"] = Polynom(std::string_view("x^2+2xy-z+1"));
+        storage["q"] = Polynom(std::string_view("3x-y^2+4"));
+        storage["r"] = Polynom(std::string_view("x^3-7"));
+    }
+};
+
+TEST_F(CalculationTest, ProductFollowedByPlusIsFused) {
+    const Polynom& p = storage["p"];
+    const Polynom& q = storage["q"];
+    const Polynom& r = storage["r"];
+    ASSERT_EQ(polynomToString(p * q + r), polynomToString(evaluateLine("p*q + r", storage)));
+    ASSERT_EQ(polynomToString(r + p * q), polynomToString(evaluateLine("r + p*q", storage)));
+    ASSERT_EQ(polynomToString(p * q + r * p), polynomToString(evaluateLine("p*q + r*p", storage)));
+}
+
+TEST_F(CalculationTest, PendingProductIsMaterializedForOtherOperators) {
+    const Polynom& p = storage["p"];
+    const Polynom& q = storage["q"];
+    const Polynom& r = storage["r"];
+    ASSERT_EQ(polynomToString(p * q), polynomToString(evaluateLine("p*q", storage)));
+    ASSERT_EQ(polynomToString(p * q - r), polynomToString(evaluateLine("p*q - r", storage)));
+    ASSERT_EQ(polynomToString(p * q * r), polynomToString(evaluateLine("p*q*r", storage)));
+    ASSERT_EQ(polynomToString(Polynom() - p * q), polynomToString(evaluateLine("-(p*q)", storage)));
+    ASSERT_EQ(polynomToString((p * q + r) * p), polynomToString(evaluateLine("(p*q + r)*p", storage)));
+}
+
+TEST_F(CalculationTest, MultiplicationChainsUseProductTree) {
+    const Polynom& p = storage["p"];
+    const Polynom& q = storage["q"];
+    const Polynom& r = storage["r"];
+    ASSERT_EQ(polynomToString(p * q * r * p * q), polynomToString(evaluateLine("p*q*r*p*q", storage)));
+    ASSERT_EQ(polynomToString((p * q) * (r * p)), polynomToString(evaluateLine("(p*q)*(r*p)", storage)));
+    ASSERT_EQ(polynomToString(p * q * r + p), polynomToString(evaluateLine("p*q*r + p", storage)));
+    ASSERT_EQ(polynomToString(q + r * p * q), polynomToString(evaluateLine("q + r*p*q", storage)));
+    ASSERT_EQ(polynomToString(p * q * r - r), polynomToString(evaluateLine("p*q*r - r", storage)));
+    ASSERT_EQ("0", polynomToString(evaluateLine("p*q*0*r", storage)));
+}
+
+TEST_F(CalculationTest, LiteralsAndErrors) {
+    ASSERT_EQ("x^2-1", polynomToString(evaluateLine("(x+1)*(x-1)", storage)));
+    ASSERT_THROW(evaluateLine("p*undefined + q", storage), std::invalid_argument);
+}
+
+TEST_F(CalculationTest, SubstitutionComposesVariable) {
+    const Polynom& p = storage["p"];
+    const Polynom& q = storage["q"];
+    Polynom x(std::string_view("x"));
+    Polynom y(std::string_view("y"));
+    Polynom z(std::string_view("z"));
+    ASSERT_EQ(polynomToString(p.compose(Polynom(std::string_view("x+1")), y, z)), polynomToString(evaluateLine("p(x+1, y, z)", storage)));
+    ASSERT_EQ(polynomToString(p.compose(q, y * z, x) + q), polynomToString(evaluateLine("p (q, y*z, x) + q", storage)));
+    ASSERT_EQ(polynomToString(p.compose(q.compose(z, y, x), Polynom() - x, z)), polynomToString(evaluateLine("p(q(z, y, x), -x, z)", storage)));
+    ASSERT_THROW(evaluateLine("s(x, y, z)", storage), std::invalid_argument);
+}
+
+TEST_F(CalculationTest, SubstitutionSyntax) {
+    Lexical_analysis lex;
+    Syntax_analysis syn;
+    ASSERT_NO_THROW(syn.analyze(lex.lexus("p(x+1, y, z) * 2")));
+    ASSERT_NO_THROW(syn.analyze(lex.lexus("(p(x, -y, (z)))")));
+    ASSERT_THROW(syn.analyze(lex.lexus("p(x, y)")), std::invalid_argument);
+    ASSERT_THROW(syn.analyze(lex.lexus("p(x, y, z, x)")), std::invalid_argument);
+    ASSERT_THROW(syn.analyze(lex.lexus("p(x, , z)")), std::invalid_argument);
+    ASSERT_THROW(syn.analyze(lex.lexus("x, y")), std::invalid_argument);
+    ASSERT_THROW(syn.analyze(lex.lexus("(x, y, z)")), std::invalid_argument);
+    ASSERT_THROW(syn.analyze(lex.lexus("p((x, y, z))")), std::invalid_argument);
+}
+
+TEST_F(CalculationTest, DivisionAndRemainder) {
+    const Polynom& p = storage["p"];
+    const Polynom& q = storage["q"];
+    const Polynom& r = storage["r"];
+    ASSERT_EQ("x^2+x+1", polynomToString(evaluateLine("(x^3-1) / (x-1)", storage)));
+    ASSERT_EQ("x+5", polynomToString(evaluateLine("(x^3+2x+5) % (x^2+1)", storage)));
+    ASSERT_EQ(polynomToString(p * q / r), polynomToString(evaluateLine("p*q/r", storage)));
+    ASSERT_EQ(polynomToString(p + q % r * r), polynomToString(evaluateLine("p + q % r * r", storage)));
+    ASSERT_EQ(polynomToString(r / Polynom(std::string_view("x+1"))), polynomToString(evaluateLine("r/(x+1)", storage)));
+    ASSERT_THROW(evaluateLine("p / 0", storage), std::invalid_argument);
+
+    Lexical_analysis lex;
+    Syntax_analysis syn;
+    ASSERT_NO_THROW(syn.analyze(lex.lexus("p / -q % r")));
+    ASSERT_THROW(syn.analyze(lex.lexus("p /")), std::invalid_argument);
+    ASSERT_THROW(syn.analyze(lex.lexus("p % * q")), std::invalid_argument);
+}
@@ -0,0 +1,42 @@
+#include "translator.h"
+
+#include <gtest.h>
+
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST(TranslatorTest, MakeSystemFromVariables) {
+    Translator<std::map<std::string, Polynom>> translator;
+    translator.processInput("p = 3x^2y-4z^3+7");
+    translator.processInput("q = x^2y+z");
+    PolynomSystem system = translator.makeSystem({ "p", "q", "p" });
+    ASSERT_EQ(3u, system.size());
+    std::vector<double> values = system.evaluate(2.0, -1.0, 0.5);
+    ASSERT_DOUBLE_EQ(3.0 * 4.0 * -1.0 - 4.0 * 0.125 + 7.0, values[0]);
+    ASSERT_DOUBLE_EQ(-4.0 + 0.5, values[1]);
+    ASSERT_DOUBLE_EQ(values[0], values[2]);
+
+    ASSERT_THROW(translator.makeSystem({ "p", "r" }), std::invalid_argument);
+}
+
+TEST(TranslatorTest, AssignsSubstitution) {
+    Translator<std::map<std::string, Polynom>> translator;
+    translator.processInput("p = x^2+y");
+    translator.processInput("s = p(x+1, y, z)");
+    PolynomSystem system = translator.makeSystem({ "s" });
+    ASSERT_DOUBLE_EQ(3.0 * 3.0 + 5.0, system.evaluate(2.0, 5.0, 0.0)[0]);
+}
+
+TEST(TranslatorTest, MakeBasisFromVariables) {
+    Translator<std::map<std::string, Polynom>> translator;
+    translator.processInput("f = x+y+z-6");
+    translator.processInput("g = x-y+2z-5");
+    translator.processInput("h = 2x+y-z-1");
+    GroebnerBasis basis = translator.makeBasis({ "f", "g", "h" });
+    ASSERT_EQ(3u, basis.size());
+    ASSERT_TRUE(basis.contains(Polynom(std::string_view("xz-3"))));
+    ASSERT_FALSE(basis.contains(Polynom(std::string_view("xz-2"))));
+    ASSERT_THROW(translator.makeBasis({ "f", "q" }), std::invalid_argument);
+}